@@ -4,6 +4,9 @@
 #include <trap.h>
 #include <kmonitor.h>
 #include <kdebug.h>
+#include <bcache.h>
+#include <iosched.h>
+#include <kmalloc.h>
 
 /* *
  * Simple command-line kernel monitor useful for controlling the
@@ -21,6 +24,9 @@ static struct command commands[] = {
     {"help", "Display this list of commands.", mon_help},
     {"kerninfo", "Display information about the kernel.", mon_kerninfo},
     {"backtrace", "Print backtrace of stack frame.", mon_backtrace},
+    {"bcache", "Display block buffer cache statistics.", mon_bcache},
+    {"iosched", "Display I/O scheduler statistics of each IDE device.", mon_iosched},
+    {"kmem", "Display kernel heap usage by cache and by call site.", mon_kmem},
 };
 
 /* return if kernel is panic, in kern/debug/panic.c */
@@ -130,3 +136,33 @@ mon_backtrace(int argc, char **argv, struct trapframe *tf) {
     return 0;
 }
 
+/* *
+ * mon_bcache - call bcache_print_stat in kern/fs/bcache.c to print the
+ * hit, miss and writeback counts of the block buffer cache.
+ * */
+int
+mon_bcache(int argc, char **argv, struct trapframe *tf) {
+    bcache_print_stat();
+    return 0;
+}
+
+/* *
+ * mon_iosched - call iosched_print_stat in kern/driver/iosched.c to print
+ * the request, merge and dispatch counts and the queue depth of each disk.
+ * */
+int
+mon_iosched(int argc, char **argv, struct trapframe *tf) {
+    iosched_print_stat();
+    return 0;
+}
+
+/* *
+ * mon_kmem - call kmalloc_print_stat in kern/mm/kmalloc.c to print
+ * what the kernel heap holds, per slab cache and per call site.
+ * */
+int
+mon_kmem(int argc, char **argv, struct trapframe *tf) {
+    kmalloc_print_stat();
+    return 0;
+}
+
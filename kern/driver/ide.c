@@ -5,6 +5,12 @@
 #include <fs.h>
 #include <ide.h>
 #include <x86.h>
+#include <list.h>
+#include <wait.h>
+#include <sync.h>
+#include <proc.h>
+#include <sched.h>
+#include <iosched.h>
 #include <assert.h>
 
 #define ISA_DATA                0x00
@@ -42,7 +48,6 @@
 #define IO_CTRL1                0x374
 
 #define MAX_IDE                 4
-#define MAX_NSECS               128
 #define MAX_DISK_NSECS          0x10000000U
 #define VALID_IDE(ideno)        (((ideno) >= 0) && ((ideno) < MAX_IDE) && (ide_devices[ideno].valid))
 
@@ -64,6 +69,20 @@ static struct ide_device {
     unsigned char model[41];    // Model in String
 } ide_devices[MAX_IDE];
 
+/* *
+ * per-channel request queue, the two drives on a channel share one task file.
+ * Requests live on the stack of the submitting processes, which sleep until
+ * the IRQ handler has moved their last sector; the io scheduler decides the
+ * order in which queued requests are served.
+ * */
+static struct ide_queue {
+    struct io_queue ioq;        // pending requests
+    struct io_request *active;  // request being served by the channel
+    wait_queue_t wait_queue;    // submitters waiting for their request
+} ide_queues[2];
+
+#define IDE_QUEUE(ideno)        (&ide_queues[(ideno) >> 1])
+
 static int
 ide_wait_ready(unsigned short iobase, bool check_error) {
     int r;
@@ -136,6 +155,14 @@ ide_init(void) {
         cprintf("ide %d: %10u(sectors), '%s'.\n", ideno, ide_devices[ideno].size, ide_devices[ideno].model);
     }
 
+    int i;
+    iosched_init();
+    for (i = 0; i < 2; i ++) {
+        ioq_init(&(ide_queues[i].ioq));
+        ide_queues[i].active = NULL;
+        wait_queue_init(&(ide_queues[i].wait_queue));
+    }
+
     // enable ide interrupt
     pic_enable(IRQ_IDE1);
     pic_enable(IRQ_IDE2);
@@ -154,10 +181,9 @@ ide_device_size(unsigned short ideno) {
     return 0;
 }
 
-int
-ide_read_secs(unsigned short ideno, uint32_t secno, void *dst, size_t nsecs) {
-    assert(nsecs <= MAX_NSECS && VALID_IDE(ideno));
-    assert(secno < MAX_DISK_NSECS && secno + nsecs <= MAX_DISK_NSECS);
+/* ide_command - load the task file of @ideno and issue @cmd, the device raises an IRQ per sector */
+static void
+ide_command(unsigned short ideno, uint32_t secno, size_t nsecs, unsigned char cmd) {
     unsigned short iobase = IO_BASE(ideno), ioctrl = IO_CTRL(ideno);
 
     ide_wait_ready(iobase, 0);
@@ -169,46 +195,177 @@ ide_read_secs(unsigned short ideno, uint32_t secno, void *dst, size_t nsecs) {
     outb(iobase + ISA_CYL_LO, (secno >> 8) & 0xFF);
     outb(iobase + ISA_CYL_HI, (secno >> 16) & 0xFF);
     outb(iobase + ISA_SDH, 0xE0 | ((ideno & 1) << 4) | ((secno >> 24) & 0xF));
-    outb(iobase + ISA_COMMAND, IDE_CMD_READ);
+    outb(iobase + ISA_COMMAND, cmd);
+}
+
+/* ide_pio_secs - polled transfer, used before the first process can sleep */
+static int
+ide_pio_secs(unsigned short ideno, uint32_t secno, void *buf, size_t nsecs, bool write) {
+    unsigned short iobase = IO_BASE(ideno);
+    ide_command(ideno, secno, nsecs, write ? IDE_CMD_WRITE : IDE_CMD_READ);
 
     int ret = 0;
-    for (; nsecs > 0; nsecs --, dst += SECTSIZE) {
+    for (; nsecs > 0; nsecs --, buf += SECTSIZE) {
         if ((ret = ide_wait_ready(iobase, 1)) != 0) {
             goto out;
         }
-        insl(iobase, dst, SECTSIZE / sizeof(uint32_t));
+        if (write) {
+            outsl(iobase, buf, SECTSIZE / sizeof(uint32_t));
+        }
+        else {
+            insl(iobase, buf, SECTSIZE / sizeof(uint32_t));
+        }
     }
 
 out:
     return ret;
 }
 
-int
-ide_write_secs(unsigned short ideno, uint32_t secno, const void *src, size_t nsecs) {
-    assert(nsecs <= MAX_NSECS && VALID_IDE(ideno));
-    assert(secno < MAX_DISK_NSECS && secno + nsecs <= MAX_DISK_NSECS);
-    unsigned short iobase = IO_BASE(ideno), ioctrl = IO_CTRL(ideno);
+/* ide_end_request - complete the active request of @q and wake its submitters */
+static void
+ide_end_request(struct ide_queue *q, int ret) {
+    ioreq_complete(q->active, ret);
+    q->active = NULL;
+    wakeup_queue(&(q->wait_queue), WT_IDE, 1);
+}
 
-    ide_wait_ready(iobase, 0);
+/* *
+ * ide_start_request - if the channel is idle, issue the request picked by the
+ * io scheduler. A write has to feed its first sector before the device
+ * interrupts. Called with interrupts disabled.
+ * */
+static void
+ide_start_request(struct ide_queue *q) {
+    struct io_request *rq;
+    while (q->active == NULL && (rq = ioq_dispatch(&(q->ioq))) != NULL) {
+        q->active = rq;
+        ide_command(rq->ideno, rq->rq_secno, rq->rq_nsecs, rq->write ? IDE_CMD_WRITE : IDE_CMD_READ);
+        if (rq->write) {
+            unsigned short iobase = IO_BASE(rq->ideno);
+            if (ide_wait_ready(iobase, 1) != 0) {
+                ide_end_request(q, -1);
+                continue;
+            }
+            outsl(iobase, ioreq_sector(rq), SECTSIZE / sizeof(uint32_t));
+        }
+    }
+}
 
-    // generate interrupt
-    outb(ioctrl + ISA_CTRL, 0);
-    outb(iobase + ISA_SECCNT, nsecs);
-    outb(iobase + ISA_SECTOR, secno & 0xFF);
-    outb(iobase + ISA_CYL_LO, (secno >> 8) & 0xFF);
-    outb(iobase + ISA_CYL_HI, (secno >> 16) & 0xFF);
-    outb(iobase + ISA_SDH, 0xE0 | ((ideno & 1) << 4) | ((secno >> 24) & 0xF));
-    outb(iobase + ISA_COMMAND, IDE_CMD_WRITE);
+/* *
+ * ide_intr - IRQ_IDE1/IRQ_IDE2 handler for channel @chan. Reading the status
+ * register acknowledges the interrupt; then one sector of the active request
+ * is moved, and when it is complete the next request is started.
+ * */
+void
+ide_intr(int chan) {
+    struct ide_queue *q = &ide_queues[chan];
+    unsigned short iobase = channels[chan].base;
+    int status = inb(iobase + ISA_STATUS);
+
+    struct io_request *rq;
+    if ((rq = q->active) == NULL) {
+        /* polled transfer or spurious interrupt */
+        return;
+    }
+    if ((status & (IDE_DF | IDE_ERR)) != 0) {
+        ide_end_request(q, -1);
+    }
+    else if (!rq->write) {
+        insl(iobase, ioreq_sector(rq), SECTSIZE / sizeof(uint32_t));
+        if (ioreq_advance(rq)) {
+            ide_end_request(q, 0);
+        }
+    }
+    else {
+        if (ioreq_advance(rq)) {
+            ide_end_request(q, 0);
+        }
+        else {
+            outsl(iobase, ioreq_sector(rq), SECTSIZE / sizeof(uint32_t));
+        }
+    }
+    ide_start_request(q);
+}
 
+/* *
+ * ide_rw_vecs - queue a request on the channel of @ideno and sleep until the
+ * IRQ handler completes it. The request moves the @nbuf buffers of @bufsecs
+ * sectors each from/to the sectors following @secno: the buffers are queued
+ * one after the other, so they are merged into the segments of one command.
+ * The idle process (kern_init) cannot sleep, so it falls back to polling.
+ * The buffers must be kernel addresses, the IRQ handler may run under the
+ * page table of another process.
+ * */
+static int
+ide_rw_vecs(unsigned short ideno, uint32_t secno, void *bufs[], size_t nbuf, size_t bufsecs, bool write) {
+    size_t i, nsecs = nbuf * bufsecs;
+    assert(nbuf <= MAX_NVECS && nsecs <= MAX_NSECS && VALID_IDE(ideno));
+    assert(secno < MAX_DISK_NSECS && secno + nsecs <= MAX_DISK_NSECS);
+    if (nsecs == 0) {
+        return 0;
+    }
     int ret = 0;
-    for (; nsecs > 0; nsecs --, src += SECTSIZE) {
-        if ((ret = ide_wait_ready(iobase, 1)) != 0) {
-            goto out;
+    if (current == NULL || current == idleproc) {
+        assert(IDE_QUEUE(ideno)->active == NULL);
+        for (i = 0; i < nbuf && ret == 0; i ++) {
+            ret = ide_pio_secs(ideno, secno + i * bufsecs, bufs[i], bufsecs, write);
         }
-        outsl(iobase, src, SECTSIZE / sizeof(uint32_t));
+        return ret;
     }
 
-out:
+    struct ide_queue *q = IDE_QUEUE(ideno);
+    struct io_request rqs[MAX_NVECS];
+    wait_t __wait, *wait = &__wait;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        for (i = 0; i < nbuf; i ++) {
+            struct io_request *rq = rqs + i;
+            rq->ideno = ideno, rq->secno = secno + i * bufsecs, rq->nsecs = bufsecs;
+            rq->buf = bufs[i], rq->write = write;
+            ioq_add(&(q->ioq), rq, MAX_NSECS);
+        }
+        ide_start_request(q);
+        for (i = 0; i < nbuf; i ++) {
+            while (!rqs[i].finished) {
+                wait_current_set(&(q->wait_queue), wait, WT_IDE);
+                local_intr_restore(intr_flag);
+
+                schedule();
+
+                local_intr_save(intr_flag);
+                wait_current_del(&(q->wait_queue), wait);
+            }
+            if (ret == 0) {
+                ret = rqs[i].ret;
+            }
+        }
+    }
+    local_intr_restore(intr_flag);
     return ret;
 }
 
+static inline int
+ide_rw_secs(unsigned short ideno, uint32_t secno, void *buf, size_t nsecs, bool write) {
+    return ide_rw_vecs(ideno, secno, &buf, 1, nsecs, write);
+}
+
+int
+ide_read_secs(unsigned short ideno, uint32_t secno, void *dst, size_t nsecs) {
+    return ide_rw_secs(ideno, secno, dst, nsecs, 0);
+}
+
+int
+ide_write_secs(unsigned short ideno, uint32_t secno, const void *src, size_t nsecs) {
+    return ide_rw_secs(ideno, secno, (void *)src, nsecs, 1);
+}
+
+int
+ide_read_vecs(unsigned short ideno, uint32_t secno, void *dsts[], size_t nbuf, size_t bufsecs) {
+    return ide_rw_vecs(ideno, secno, dsts, nbuf, bufsecs, 0);
+}
+
+int
+ide_write_vecs(unsigned short ideno, uint32_t secno, void *srcs[], size_t nbuf, size_t bufsecs) {
+    return ide_rw_vecs(ideno, secno, srcs, nbuf, bufsecs, 1);
+}
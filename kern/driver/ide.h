@@ -3,12 +3,19 @@
 
 #include <defs.h>
 
+#define MAX_NSECS               128     /* max # of sectors moved by one command */
+#define MAX_NVECS               16      /* max # of buffers of one ide_read_vecs/ide_write_vecs */
+
 void ide_init(void);
 bool ide_device_valid(unsigned short ideno);
 size_t ide_device_size(unsigned short ideno);
 
 int ide_read_secs(unsigned short ideno, uint32_t secno, void *dst, size_t nsecs);
 int ide_write_secs(unsigned short ideno, uint32_t secno, const void *src, size_t nsecs);
+int ide_read_vecs(unsigned short ideno, uint32_t secno, void *dsts[], size_t nbuf, size_t bufsecs);
+int ide_write_vecs(unsigned short ideno, uint32_t secno, void *srcs[], size_t nbuf, size_t bufsecs);
+
+void ide_intr(int chan);
 
 #endif /* !__KERN_DRIVER_IDE_H__ */
 
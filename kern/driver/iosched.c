@@ -0,0 +1,165 @@
+#include <defs.h>
+#include <stdio.h>
+#include <string.h>
+#include <list.h>
+#include <sync.h>
+#include <fs.h>
+#include <iosched.h>
+#include <assert.h>
+
+static struct iosched_class *iosched_class = NULL;
+static struct iosched_stat iosched_stats[IOSCHED_MAX_DEV];
+
+/* *
+ * noop scheduler - requests are served in arrival order, only merging is done.
+ * */
+static void
+noop_add_request(struct io_queue *q, struct io_request *rq) {
+    list_add_before(&(q->rq_list), &(rq->queue_link));
+}
+
+static struct io_request *
+noop_pick_next(struct io_queue *q) {
+    list_entry_t *le = list_next(&(q->rq_list));
+    return (le != &(q->rq_list)) ? le2ioreq(le, queue_link) : NULL;
+}
+
+struct iosched_class noop_iosched_class = {
+    .name = "noop_iosched",
+    .add_request = noop_add_request,
+    .pick_next = noop_pick_next,
+};
+
+void
+iosched_init(void) {
+    iosched_class = &clook_iosched_class;
+    memset(iosched_stats, 0, sizeof(iosched_stats));
+    cprintf("iosched class: %s\n", iosched_class->name);
+}
+
+void
+ioq_init(struct io_queue *q) {
+    list_init(&(q->rq_list));
+    q->head_ideno = 0, q->head_secno = 0;
+}
+
+/* *
+ * ioq_try_merge - chain @rq onto a queued request of the same device and
+ * direction whose sector range it extends at either end, as long as the
+ * command stays within @max_nsecs sectors.
+ * */
+static bool
+ioq_try_merge(struct io_queue *q, struct io_request *rq, size_t max_nsecs) {
+    list_entry_t *le = &(q->rq_list);
+    while ((le = list_next(le)) != &(q->rq_list)) {
+        struct io_request *qrq = le2ioreq(le, queue_link);
+        if (qrq->ideno != rq->ideno || qrq->write != rq->write
+                || qrq->rq_nsecs + rq->nsecs > max_nsecs) {
+            continue;
+        }
+        if (qrq->rq_secno + qrq->rq_nsecs == rq->secno) {
+            list_add_before(&(qrq->seg_list), &(rq->seg_link));
+        }
+        else if (rq->secno + rq->nsecs == qrq->rq_secno) {
+            list_add_after(&(qrq->seg_list), &(rq->seg_link));
+            qrq->rq_secno = rq->secno;
+        }
+        else {
+            continue;
+        }
+        qrq->rq_nsecs += rq->nsecs;
+        return 1;
+    }
+    return 0;
+}
+
+/* *
+ * ioq_add - queue @rq on @q, merging it into a queued request if possible.
+ * Called with interrupts disabled.
+ * */
+void
+ioq_add(struct io_queue *q, struct io_request *rq, size_t max_nsecs) {
+    assert(rq->ideno < IOSCHED_MAX_DEV);
+    struct iosched_stat *stat = iosched_stats + rq->ideno;
+    rq->done = 0, rq->finished = 0, rq->ret = 0;
+    stat->requests ++;
+    if (++ stat->depth > stat->max_depth) {
+        stat->max_depth = stat->depth;
+    }
+    if (ioq_try_merge(q, rq, max_nsecs)) {
+        stat->merges ++;
+        return;
+    }
+    rq->rq_secno = rq->secno, rq->rq_nsecs = rq->nsecs;
+    list_init(&(rq->seg_list));
+    list_add(&(rq->seg_list), &(rq->seg_link));
+    iosched_class->add_request(q, rq);
+}
+
+/* *
+ * ioq_dispatch - take the request the scheduler picks off @q, and make it
+ * ready for transfer. Called with interrupts disabled.
+ * */
+struct io_request *
+ioq_dispatch(struct io_queue *q) {
+    struct io_request *rq;
+    if ((rq = iosched_class->pick_next(q)) != NULL) {
+        list_del(&(rq->queue_link));
+        rq->cur_seg = list_next(&(rq->seg_list));
+        q->head_ideno = rq->ideno;
+        q->head_secno = rq->rq_secno + rq->rq_nsecs;
+        iosched_stats[rq->ideno].dispatches ++;
+    }
+    return rq;
+}
+
+/* ioreq_sector - where the next sector of dispatched request @rq goes to/comes from */
+void *
+ioreq_sector(struct io_request *rq) {
+    struct io_request *seg = le2ioreq(rq->cur_seg, seg_link);
+    return seg->buf + seg->done * SECTSIZE;
+}
+
+/* ioreq_advance - account one transferred sector, return true when @rq is done */
+bool
+ioreq_advance(struct io_request *rq) {
+    struct io_request *seg = le2ioreq(rq->cur_seg, seg_link);
+    if (++ seg->done == seg->nsecs) {
+        rq->cur_seg = list_next(rq->cur_seg);
+    }
+    return rq->cur_seg == &(rq->seg_list);
+}
+
+/* ioreq_complete - finish every segment of @rq with @ret, the caller wakes the submitters */
+void
+ioreq_complete(struct io_request *rq, int ret) {
+    list_entry_t *le = &(rq->seg_list);
+    while ((le = list_next(le)) != &(rq->seg_list)) {
+        struct io_request *seg = le2ioreq(le, seg_link);
+        seg->ret = ret, seg->finished = 1;
+        iosched_stats[seg->ideno].depth --;
+    }
+}
+
+void
+iosched_get_stat(unsigned short ideno, struct iosched_stat *stat) {
+    assert(ideno < IOSCHED_MAX_DEV);
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    *stat = iosched_stats[ideno];
+    local_intr_restore(intr_flag);
+}
+
+void
+iosched_print_stat(void) {
+    unsigned short ideno;
+    for (ideno = 0; ideno < IOSCHED_MAX_DEV; ideno ++) {
+        struct iosched_stat stat;
+        iosched_get_stat(ideno, &stat);
+        if (stat.requests != 0) {
+            cprintf("iosched: ide %d: requests %d, merges %d, dispatches %d, depth %d (max %d).\n",
+                    ideno, stat.requests, stat.merges, stat.dispatches, stat.depth, stat.max_depth);
+        }
+    }
+}
+
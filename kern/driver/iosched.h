@@ -0,0 +1,82 @@
+#ifndef __KERN_DRIVER_IOSCHED_H__
+#define __KERN_DRIVER_IOSCHED_H__
+
+#include <defs.h>
+#include <list.h>
+
+/* *
+ * Block I/O scheduler. Disk requests (from dev_disk0 and swapfs through
+ * ide_read_secs/ide_write_secs) are queued per IDE channel; the scheduler
+ * merges a new request with a queued one on an adjacent sector range, and
+ * decides which queued request the channel serves next.
+ * */
+
+#define IOSCHED_MAX_DEV         4       /* # of ide devices, ideno < IOSCHED_MAX_DEV */
+
+/* *
+ * io_request - one read/write of @nsecs sectors at @secno into/from @buf.
+ * A request that gets merged is chained on seg_list of the queued request it
+ * joined (in sector order), the queued one is then issued as one command of
+ * rq_nsecs sectors starting at rq_secno and fills/drains each segment in turn.
+ * */
+struct io_request {
+    unsigned short ideno;
+    uint32_t secno;             // first sector of this segment
+    size_t nsecs;               // # of sectors of this segment
+    void *buf;
+    bool write;
+    size_t done;                // # of sectors of this segment transferred
+    bool finished;
+    int ret;
+    list_entry_t seg_link;      // entry in seg_list of the queued request
+    /* valid for the queued request only */
+    uint32_t rq_secno;          // first sector of the whole command
+    size_t rq_nsecs;            // # of sectors of the whole command
+    list_entry_t seg_list;      // segments, including this request itself
+    list_entry_t *cur_seg;      // segment being transferred
+    list_entry_t queue_link;    // entry in io_queue.rq_list
+};
+
+#define le2ioreq(le, member)    \
+    to_struct((le), struct io_request, member)
+
+/* io_queue - pending requests of one channel, @head is where the last dispatch ended */
+struct io_queue {
+    list_entry_t rq_list;
+    unsigned short head_ideno;
+    uint32_t head_secno;
+};
+
+struct iosched_class {
+    const char *name;
+    /* insert a request that could not be merged into @q */
+    void (*add_request)(struct io_queue *q, struct io_request *rq);
+    /* pick the request to serve next, NULL if @q is empty; the caller unlinks it */
+    struct io_request *(*pick_next)(struct io_queue *q);
+};
+
+/* per-device statistics */
+struct iosched_stat {
+    size_t requests;            // requests submitted
+    size_t merges;              // requests merged into a queued one
+    size_t dispatches;          // commands issued
+    size_t depth;               // requests queued now (merged ones included)
+    size_t max_depth;           // highest depth seen
+};
+
+extern struct iosched_class noop_iosched_class;
+extern struct iosched_class clook_iosched_class;
+
+void iosched_init(void);
+void ioq_init(struct io_queue *q);
+void ioq_add(struct io_queue *q, struct io_request *rq, size_t max_nsecs);
+struct io_request *ioq_dispatch(struct io_queue *q);
+void *ioreq_sector(struct io_request *rq);
+bool ioreq_advance(struct io_request *rq);
+void ioreq_complete(struct io_request *rq, int ret);
+
+void iosched_get_stat(unsigned short ideno, struct iosched_stat *stat);
+void iosched_print_stat(void);
+
+#endif /* !__KERN_DRIVER_IOSCHED_H__ */
+
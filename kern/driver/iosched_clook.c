@@ -0,0 +1,49 @@
+#include <defs.h>
+#include <list.h>
+#include <iosched.h>
+
+/* *
+ * C-LOOK elevator: the queue is kept sorted by (device, sector), the disk head
+ * sweeps upward serving the first request at or beyond where the previous one
+ * ended, and jumps back to the lowest request once nothing is left ahead.
+ * */
+
+#define clook_key(ideno, secno)         (((uint64_t)(ideno) << 32) | (secno))
+#define clook_rq_key(rq)                clook_key((rq)->ideno, (rq)->rq_secno)
+
+static void
+clook_add_request(struct io_queue *q, struct io_request *rq) {
+    list_entry_t *le = &(q->rq_list);
+    while ((le = list_next(le)) != &(q->rq_list)) {
+        if (clook_rq_key(le2ioreq(le, queue_link)) > clook_rq_key(rq)) {
+            break;
+        }
+    }
+    list_add_before(le, &(rq->queue_link));
+}
+
+/* a front merge may move a request slightly out of order, so look at every one */
+static struct io_request *
+clook_pick_next(struct io_queue *q) {
+    uint64_t head = clook_key(q->head_ideno, q->head_secno);
+    struct io_request *ahead = NULL, *lowest = NULL;
+    list_entry_t *le = &(q->rq_list);
+    while ((le = list_next(le)) != &(q->rq_list)) {
+        struct io_request *rq = le2ioreq(le, queue_link);
+        uint64_t key = clook_rq_key(rq);
+        if (key >= head && (ahead == NULL || key < clook_rq_key(ahead))) {
+            ahead = rq;
+        }
+        if (lowest == NULL || key < clook_rq_key(lowest)) {
+            lowest = rq;
+        }
+    }
+    return (ahead != NULL) ? ahead : lowest;
+}
+
+struct iosched_class clook_iosched_class = {
+    .name = "clook_iosched",
+    .add_request = clook_add_request,
+    .pick_next = clook_pick_next,
+};
+
@@ -0,0 +1,553 @@
+#include <defs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <list.h>
+#include <sem.h>
+#include <wait.h>
+#include <sync.h>
+#include <proc.h>
+#include <sched.h>
+#include <kmalloc.h>
+#include <dev.h>
+#include <iobuf.h>
+#include <bcache.h>
+#include <clock.h>
+#include <assert.h>
+
+static struct bcache_buf bcache_bufs[BCACHE_NBUF];
+static list_entry_t bcache_hash[BCACHE_HASH_SIZE];
+static list_entry_t bcache_lru;
+static struct bcache_stat bcache_stat;
+static size_t bcache_ndirty;            /* # of dirty buffers */
+static size_t bcache_nra;               /* # of buffers with readahead set */
+static semaphore_t bcache_sem;
+static wait_queue_t bcache_wait_queue;  /* waiting for a busy buffer */
+static void *bcache_rabuf;              /* staging area of bcache_prefetch */
+static semaphore_t bcache_ra_sem;
+
+#define bcache_hashfn(dev, blkno)                   \
+    (hash32((uint32_t)(dev) ^ (blkno), BCACHE_HASH_SHIFT))
+
+static void
+lock_bcache(void) {
+    down(&(bcache_sem));
+}
+
+static void
+unlock_bcache(void) {
+    up(&(bcache_sem));
+}
+
+/**
+ * 初始化缓存
+ * 被 fs_init 调用, 缓存块的内存一次性分配, 之后不再释放
+ **/
+void
+bcache_init(void) {
+    static_assert(BCACHE_BLKSIZE % PGSIZE == 0);
+    char *data;
+    if ((data = kmalloc(BCACHE_NBUF * BCACHE_BLKSIZE)) == NULL) {
+        panic("bcache: alloc buffer failed.\n");
+    }
+    if ((bcache_rabuf = kmalloc(BCACHE_RA_NBLKS * BCACHE_BLKSIZE)) == NULL) {
+        panic("bcache: alloc readahead buffer failed.\n");
+    }
+    int i;
+    for (i = 0; i < BCACHE_HASH_SIZE; i ++) {
+        list_init(bcache_hash + i);
+    }
+    list_init(&bcache_lru);
+    bcache_ndirty = bcache_nra = 0;
+    for (i = 0; i < BCACHE_NBUF; i ++) {
+        struct bcache_buf *bb = bcache_bufs + i;
+        bb->dev = NULL, bb->blkno = 0, bb->dirty = 0, bb->dirtied = 0, bb->readahead = 0, bb->busy = 0;
+        bb->data = data + i * BCACHE_BLKSIZE;
+        list_init(&(bb->hash_link));
+        list_add_before(&bcache_lru, &(bb->lru_link));
+    }
+    sem_init(&bcache_sem, 1);
+    wait_queue_init(&bcache_wait_queue);
+    sem_init(&bcache_ra_sem, 1);
+    memset(&bcache_stat, 0, sizeof(bcache_stat));
+    cprintf("bcache: %d buffers of %d bytes.\n", BCACHE_NBUF, BCACHE_BLKSIZE);
+}
+
+/* bcache_devio - move one block between @data and @dev */
+static int
+bcache_devio(struct device *dev, void *data, uint32_t blkno, bool write) {
+    struct iobuf __iob, *iob = iobuf_init(&__iob, data, BCACHE_BLKSIZE, blkno * BCACHE_BLKSIZE);
+    return dop_io(dev, iob, write);
+}
+
+/**
+ * 等待某个 busy 的缓存块完成读写, 等待期间释放 bcache_sem
+ * 返回后缓存可能已经变化, 调用者要重新查找
+ **/
+static void
+bcache_wait_nolock(void) {
+    bool intr_flag;
+    wait_t __wait, *wait = &__wait;
+    local_intr_save(intr_flag);
+    wait_current_set(&bcache_wait_queue, wait, WT_BCACHE);
+    local_intr_restore(intr_flag);
+
+    unlock_bcache();
+    schedule();
+
+    local_intr_save(intr_flag);
+    wait_current_del(&bcache_wait_queue, wait);
+    local_intr_restore(intr_flag);
+    lock_bcache();
+}
+
+/**
+ * 在 @bb 和设备之间传输它缓存的块, 传输期间 @bb 置为 busy 并释放 bcache_sem,
+ * 这样一次磁盘读写不会挡住其他块的查找; 前后都持有 bcache_sem
+ **/
+static int
+bcache_busy_io(struct bcache_buf *bb, bool write) {
+    assert(!bb->busy);
+    bb->busy = 1;
+    unlock_bcache();
+
+    int ret = bcache_devio(bb->dev, bb->data, bb->blkno, write);
+
+    lock_bcache();
+    bb->busy = 0;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        if (!wait_queue_empty(&bcache_wait_queue)) {
+            wakeup_queue(&bcache_wait_queue, WT_BCACHE, 1);
+        }
+    }
+    local_intr_restore(intr_flag);
+    return ret;
+}
+
+/* bcache_set_dirty_nolock - mark @bb dirty or clean, keeping the dirty count and age */
+static void
+bcache_set_dirty_nolock(struct bcache_buf *bb, bool dirty) {
+    if (!bb->dirty && dirty) {
+        bb->dirtied = ticks;
+        bcache_ndirty ++;
+    }
+    else if (bb->dirty && !dirty) {
+        bcache_ndirty --;
+    }
+    bb->dirty = dirty;
+}
+
+/* bcache_set_ra_nolock - mark @bb as holding a prefetched block not used yet, or not */
+static void
+bcache_set_ra_nolock(struct bcache_buf *bb, bool readahead) {
+    if (!bb->readahead && readahead) {
+        bcache_nra ++;
+    }
+    else if (bb->readahead && !readahead) {
+        bcache_nra --;
+    }
+    bb->readahead = readahead;
+}
+
+/* bcache_writeback_nolock - write a dirty buffer back to its device, bcache_sem is released meanwhile */
+static int
+bcache_writeback_nolock(struct bcache_buf *bb) {
+    int ret = 0;
+    if (bb->dirty) {
+        if ((ret = bcache_busy_io(bb, 1)) == 0) {
+            bcache_set_dirty_nolock(bb, 0);
+            bcache_stat.writebacks ++;
+        }
+    }
+    return ret;
+}
+
+/* bcache_lookup_nolock - find the buffer caching (@dev, @blkno), NULL if none */
+static struct bcache_buf *
+bcache_lookup_nolock(struct device *dev, uint32_t blkno) {
+    list_entry_t *list = bcache_hash + bcache_hashfn(dev, blkno), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct bcache_buf *bb = le2bbuf(le, hash_link);
+        if (bb->dev == dev && bb->blkno == blkno) {
+            return bb;
+        }
+    }
+    return NULL;
+}
+
+/* bcache_release_nolock - drop a (clean) buffer's identity and make it the next victim */
+static void
+bcache_release_nolock(struct bcache_buf *bb) {
+    assert(!bb->dirty && !bb->busy);
+    bcache_set_ra_nolock(bb, 0);
+    bb->dev = NULL, bb->blkno = 0;
+    list_del_init(&(bb->hash_link));
+    list_del(&(bb->lru_link));
+    list_add_before(&bcache_lru, &(bb->lru_link));
+}
+
+/**
+ * 选择被回收的缓存块: 最久未使用的不 busy 的块, 都 busy 时返回 NULL
+ * 预读时如果预读块已有 BCACHE_RA_MAX 个, 则回收最久未使用的预读块,
+ * 这样预读的文件数据不会把元数据块(inode、freemap、目录)挤出缓存
+ **/
+static struct bcache_buf *
+bcache_victim_nolock(bool readahead) {
+    bool ra_only = (readahead && bcache_nra >= BCACHE_RA_MAX);
+    list_entry_t *le = &bcache_lru;
+    while ((le = list_prev(le)) != &bcache_lru) {
+        struct bcache_buf *bb = le2bbuf(le, lru_link);
+        if (!bb->busy && (!ra_only || bb->readahead)) {
+            return bb;
+        }
+    }
+    return ra_only ? bcache_victim_nolock(0) : NULL;
+}
+
+/**
+ * 为 (@dev, @blkno) 取得一个不 busy 的缓存块, 并移到 LRU 表头
+ * 命中时 *@hit 置 1; 否则回收一个块(脏块先写回), 内容未定义
+ * @readahead 表示为预读取得, 未命中时新块标记为预读块
+ * 等待 busy 块或写回脏块时会释放 bcache_sem, 之后重新查找;
+ * 写回失败的块仍是脏块, 移到 LRU 表头, 下次回收时先选其他块
+ **/
+static int
+bcache_get_nolock(struct device *dev, uint32_t blkno, struct bcache_buf **bb_store, bool *hit, bool readahead) {
+    struct bcache_buf *bb;
+again:
+    if ((bb = bcache_lookup_nolock(dev, blkno)) != NULL) {
+        if (bb->busy) {
+            bcache_wait_nolock();
+            goto again;
+        }
+        *hit = 1;
+    }
+    else {
+        int ret;
+        if ((bb = bcache_victim_nolock(readahead)) == NULL) {
+            bcache_wait_nolock();
+            goto again;
+        }
+        if (bb->dirty) {
+            if ((ret = bcache_writeback_nolock(bb)) != 0) {
+                list_del(&(bb->lru_link));
+                list_add(&bcache_lru, &(bb->lru_link));
+                return ret;
+            }
+            goto again;
+        }
+        list_del_init(&(bb->hash_link));
+        bb->dev = dev, bb->blkno = blkno;
+        list_add(bcache_hash + bcache_hashfn(dev, blkno), &(bb->hash_link));
+        bcache_set_ra_nolock(bb, readahead);
+        *hit = 0;
+    }
+    list_del(&(bb->lru_link));
+    list_add(&bcache_lru, &(bb->lru_link));
+    *bb_store = bb;
+    return 0;
+}
+
+/**
+ * 读设备 @dev 的第 @blkno 块到 @buf
+ * 未命中时从设备读入缓存块, 读失败则释放该缓存块
+ * 预读块和 bcache_rwblocks 中一样, 复制一次后就释放
+ **/
+int
+bcache_read(struct device *dev, void *buf, uint32_t blkno) {
+    assert(dev->d_blocksize == BCACHE_BLKSIZE);
+    int ret;
+    bool hit;
+    struct bcache_buf *bb;
+    lock_bcache();
+    {
+        if ((ret = bcache_get_nolock(dev, blkno, &bb, &hit, 0)) != 0) {
+            goto out;
+        }
+        if (hit) {
+            bcache_stat.hits ++;
+        }
+        else {
+            bcache_stat.misses ++;
+            if ((ret = bcache_busy_io(bb, 0)) != 0) {
+                bcache_release_nolock(bb);
+                goto out;
+            }
+        }
+        memcpy(buf, bb->data, BCACHE_BLKSIZE);
+        if (bb->readahead && !bb->dirty) {
+            bcache_release_nolock(bb);
+        }
+    }
+out:
+    unlock_bcache();
+    return ret;
+}
+
+/**
+ * 将 @buf 写入设备 @dev 的第 @blkno 块
+ * 整块覆盖, 所以未命中也不需要先读设备; 只标记为脏, 由淘汰或 bcache_sync 写回
+ **/
+int
+bcache_write(struct device *dev, void *buf, uint32_t blkno) {
+    assert(dev->d_blocksize == BCACHE_BLKSIZE);
+    int ret;
+    bool hit;
+    struct bcache_buf *bb;
+    lock_bcache();
+    {
+        if ((ret = bcache_get_nolock(dev, blkno, &bb, &hit, 0)) == 0) {
+            if (hit) {
+                bcache_stat.hits ++;
+            }
+            else {
+                bcache_stat.misses ++;
+            }
+            memcpy(bb->data, buf, BCACHE_BLKSIZE);
+            bcache_set_dirty_nolock(bb, 1);
+            bcache_set_ra_nolock(bb, 0);
+        }
+    }
+    unlock_bcache();
+    return ret;
+}
+
+/**
+ * 在 @buf 和设备 @dev 之间直接传输从 @blkno 开始的连续 @nblks 块, 不经过缓存块中转
+ * 用于大块的文件数据读写, 这些块不会被放入缓存, 以免把元数据块挤出缓存
+ *
+ * 读: 已缓存的块(可能是脏块)从缓存复制, 其余每段连续未缓存的块只发一次 dop_io;
+ *     预读块复制一次后就释放, 不再占用缓存
+ * 写: 先用新数据覆盖已缓存的副本并置为干净, 再一次性写设备;
+ *     这样设备写的过程中缓存块被淘汰也不会把旧数据写回. 写失败时丢弃这些副本
+ *
+ * 调用者需保证期间没有其他人通过缓存读写这些块(sfs 中由 io 锁保证)
+ **/
+int
+bcache_rwblocks(struct device *dev, void *buf, uint32_t blkno, uint32_t nblks, bool write) {
+    assert(dev->d_blocksize == BCACHE_BLKSIZE);
+    struct iobuf __iob, *iob;
+    struct bcache_buf *bb;
+    uint32_t i, n;
+    int ret = 0;
+    if (write) {
+        lock_bcache();
+        for (i = 0; i < nblks; ) {
+            if ((bb = bcache_lookup_nolock(dev, blkno + i)) != NULL) {
+                // an older copy may be on its way to the device, let it land first
+                if (bb->busy) {
+                    bcache_wait_nolock();
+                    continue;
+                }
+                memcpy(bb->data, buf + i * BCACHE_BLKSIZE, BCACHE_BLKSIZE);
+                bcache_set_dirty_nolock(bb, 0);
+            }
+            i ++;
+        }
+        unlock_bcache();
+
+        iob = iobuf_init(&__iob, buf, nblks * BCACHE_BLKSIZE, blkno * BCACHE_BLKSIZE);
+        if ((ret = dop_io(dev, iob, 1)) != 0) {
+            lock_bcache();
+            for (i = 0; i < nblks; ) {
+                if ((bb = bcache_lookup_nolock(dev, blkno + i)) != NULL) {
+                    if (bb->busy) {
+                        bcache_wait_nolock();
+                        continue;
+                    }
+                    bcache_release_nolock(bb);
+                }
+                i ++;
+            }
+            unlock_bcache();
+        }
+        return ret;
+    }
+
+    while (nblks != 0) {
+        lock_bcache();
+        if ((bb = bcache_lookup_nolock(dev, blkno)) != NULL && bb->busy) {
+            bcache_wait_nolock();
+            unlock_bcache();
+            continue;
+        }
+        if (bb != NULL) {
+            memcpy(buf, bb->data, BCACHE_BLKSIZE);
+            bcache_stat.hits ++;
+            n = 1;
+            // a prefetched block is read once, sequentially, give its buffer back
+            if (bb->readahead && !bb->dirty) {
+                bcache_release_nolock(bb);
+            }
+        }
+        else {
+            for (n = 1; n < nblks && bcache_lookup_nolock(dev, blkno + n) == NULL; n ++)
+                /* nothing */;
+            bcache_stat.misses += n;
+        }
+        unlock_bcache();
+
+        if (bb == NULL) {
+            iob = iobuf_init(&__iob, buf, n * BCACHE_BLKSIZE, blkno * BCACHE_BLKSIZE);
+            if ((ret = dop_io(dev, iob, 0)) != 0) {
+                break;
+            }
+        }
+        buf += n * BCACHE_BLKSIZE, blkno += n, nblks -= n;
+    }
+    return ret;
+}
+
+/* bcache_cached - test if block @blkno of @dev is in the cache */
+bool
+bcache_cached(struct device *dev, uint32_t blkno) {
+    bool ret;
+    lock_bcache();
+    ret = (bcache_lookup_nolock(dev, blkno) != NULL);
+    unlock_bcache();
+    return ret;
+}
+
+/**
+ * 预读: 把设备 @dev 上从 @blkno 开始的连续 @nblks 块中还没有缓存的块读入缓存
+ * 第一个到最后一个未缓存块之间的范围用一次 dop_io 读入 @bcache_rabuf, 再复制到缓存块;
+ * 其间已经缓存的块(可能是脏块)保持不变. 读入的块标记为 readahead, 最多占用
+ * BCACHE_RA_MAX 个缓存块(见 bcache_victim_nolock), 不会挤掉元数据块
+ *
+ * 和 bcache_rwblocks 一样, 调用者需保证期间没有其他人直接写这些块
+ **/
+int
+bcache_prefetch(struct device *dev, uint32_t blkno, uint32_t nblks) {
+    assert(dev->d_blocksize == BCACHE_BLKSIZE);
+    if (nblks > BCACHE_RA_NBLKS) {
+        nblks = BCACHE_RA_NBLKS;
+    }
+    lock_bcache();
+    while (nblks != 0 && bcache_lookup_nolock(dev, blkno) != NULL) {
+        blkno ++, nblks --;
+    }
+    while (nblks != 0 && bcache_lookup_nolock(dev, blkno + nblks - 1) != NULL) {
+        nblks --;
+    }
+    unlock_bcache();
+    if (nblks == 0) {
+        return 0;
+    }
+
+    int ret;
+    down(&bcache_ra_sem);
+    struct iobuf __iob, *iob = iobuf_init(&__iob, bcache_rabuf, nblks * BCACHE_BLKSIZE, blkno * BCACHE_BLKSIZE);
+    if ((ret = dop_io(dev, iob, 0)) == 0) {
+        uint32_t i;
+        lock_bcache();
+        for (i = 0; i < nblks; i ++) {
+            bool hit;
+            struct bcache_buf *bb;
+            if ((ret = bcache_get_nolock(dev, blkno + i, &bb, &hit, 1)) != 0) {
+                break;
+            }
+            if (!hit) {
+                memcpy(bb->data, bcache_rabuf + i * BCACHE_BLKSIZE, BCACHE_BLKSIZE);
+                bcache_stat.readaheads ++;
+            }
+        }
+        unlock_bcache();
+    }
+    up(&bcache_ra_sem);
+    return ret;
+}
+
+/**
+ * 将设备 @dev 上已经脏了至少 @age 个 tick 的块写回, @dev 为 NULL 时写回所有设备
+ * 被写回线程调用; @age 为 0 时写回全部脏块
+ * 出错时继续写回其余块, 返回第一个错误
+ **/
+int
+bcache_writeback(struct device *dev, unsigned int age) {
+    int i, ret = 0;
+    lock_bcache();
+    size_t now = ticks;
+    for (i = 0; i < BCACHE_NBUF && bcache_ndirty != 0; i ++) {
+        struct bcache_buf *bb = bcache_bufs + i;
+        if (bb->busy && bb->dirty) {
+            // being written by someone else, see how that went
+            bcache_wait_nolock();
+            i --;
+            continue;
+        }
+        if (bb->dirty && (dev == NULL || bb->dev == dev) && now - bb->dirtied >= age) {
+            int err;
+            if ((err = bcache_writeback_nolock(bb)) != 0 && ret == 0) {
+                ret = err;
+            }
+        }
+    }
+    unlock_bcache();
+    return ret;
+}
+
+/* bcache_sync - write back all dirty blocks of @dev (of all devices if @dev is NULL) */
+int
+bcache_sync(struct device *dev) {
+    return bcache_writeback(dev, 0);
+}
+
+/* bcache_dirty_count - the # of dirty blocks of @dev, of all devices if @dev is NULL */
+size_t
+bcache_dirty_count(struct device *dev) {
+    int i;
+    size_t n = 0;
+    lock_bcache();
+    if (dev == NULL) {
+        n = bcache_ndirty;
+    }
+    else {
+        for (i = 0; i < BCACHE_NBUF; i ++) {
+            if (bcache_bufs[i].dirty && bcache_bufs[i].dev == dev) {
+                n ++;
+            }
+        }
+    }
+    unlock_bcache();
+    return n;
+}
+
+/**
+ * 丢弃设备 @dev 的所有缓存块, 卸载文件系统时调用
+ * 调用前必须已经 bcache_sync, 不允许丢弃脏块
+ **/
+void
+bcache_invalidate(struct device *dev) {
+    int i;
+    lock_bcache();
+    for (i = 0; i < BCACHE_NBUF; i ++) {
+        struct bcache_buf *bb = bcache_bufs + i;
+        if (bb->dev == dev) {
+            if (bb->busy) {
+                bcache_wait_nolock();
+                i --;
+                continue;
+            }
+            bcache_release_nolock(bb);
+        }
+    }
+    unlock_bcache();
+}
+
+void
+bcache_get_stat(struct bcache_stat *stat) {
+    lock_bcache();
+    *stat = bcache_stat;
+    unlock_bcache();
+}
+
+void
+bcache_print_stat(void) {
+    struct bcache_stat stat;
+    bcache_get_stat(&stat);
+    cprintf("bcache: hits %d, misses %d, writebacks %d, readaheads %d.\n",
+            stat.hits, stat.misses, stat.writebacks, stat.readaheads);
+}
+
@@ -0,0 +1,78 @@
+#ifndef __KERN_FS_BCACHE_H__
+#define __KERN_FS_BCACHE_H__
+
+#include <defs.h>
+#include <mmu.h>
+#include <list.h>
+
+/*
+ * Block buffer cache shared by all block devices (disk0 today, usable by any
+ * fs built on struct device, e.g. sfs or mfs). Buffers are indexed by
+ * (device, blkno) in a hash table, recycled in LRU order, and written back
+ * lazily: a write only marks the buffer dirty, the data reaches the device
+ * when the buffer is evicted, when the writeback thread finds it old enough
+ * (bcache_writeback) or when bcache_sync is called. The cache lock is not
+ * held across device I/O: the buffer is marked busy instead, and whoever
+ * needs it meanwhile sleeps until the I/O is done.
+ */
+
+#define BCACHE_BLKSIZE                  PGSIZE          /* size of a cached block */
+#define BCACHE_NBUF                     64              /* # of buffers in the cache */
+#define BCACHE_RA_NBLKS                 16              /* max # of blocks prefetched at once */
+#define BCACHE_RA_MAX                   (BCACHE_NBUF / 4) /* max # of buffers holding prefetched blocks */
+#define BCACHE_HASH_SHIFT               6
+#define BCACHE_HASH_SIZE                (1 << BCACHE_HASH_SHIFT)
+
+struct device;
+
+/**
+ * dev       缓存块所属的设备, NULL 表示空闲
+ * blkno     设备上的块号
+ * dirty     内容被修改过, 尚未写回设备
+ * dirtied   由干净变脏时的 ticks, 用于按脏的时长写回
+ * readahead 由预读填入且还没有被读过, 这样的块最多 BCACHE_RA_MAX 个
+ * busy      正在读写设备(不持有缓存锁), 其他人要等它完成才能使用或回收
+ * data      缓存的块数据(BCACHE_BLKSIZE 字节)
+ * hash_link 哈希链表项, 以 (dev, blkno) 为键
+ * lru_link  LRU 链表项, 表头一侧为最近使用
+ */
+struct bcache_buf {
+    struct device *dev;                             /* device the block belongs to */
+    uint32_t blkno;                                 /* block number on the device */
+    bool dirty;                                     /* true if data is newer than disk */
+    size_t dirtied;                                 /* ticks when it became dirty */
+    bool readahead;                                 /* prefetched and not used yet */
+    bool busy;                                      /* device I/O in progress */
+    void *data;                                     /* block content */
+    list_entry_t hash_link;                         /* entry in the hash bucket */
+    list_entry_t lru_link;                          /* entry in the lru list */
+};
+
+#define le2bbuf(le, member)                         \
+    to_struct((le), struct bcache_buf, member)
+
+/* statistics of the buffer cache */
+struct bcache_stat {
+    size_t hits;                                    /* lookups served from memory */
+    size_t misses;                                  /* lookups that went to the device */
+    size_t writebacks;                              /* dirty blocks written to the device */
+    size_t readaheads;                              /* blocks loaded by bcache_prefetch */
+};
+
+void bcache_init(void);
+
+int bcache_read(struct device *dev, void *buf, uint32_t blkno);
+int bcache_write(struct device *dev, void *buf, uint32_t blkno);
+int bcache_rwblocks(struct device *dev, void *buf, uint32_t blkno, uint32_t nblks, bool write);
+bool bcache_cached(struct device *dev, uint32_t blkno);
+int bcache_prefetch(struct device *dev, uint32_t blkno, uint32_t nblks);
+int bcache_writeback(struct device *dev, unsigned int age);
+int bcache_sync(struct device *dev);
+size_t bcache_dirty_count(struct device *dev);
+void bcache_invalidate(struct device *dev);
+
+void bcache_get_stat(struct bcache_stat *stat);
+void bcache_print_stat(void);
+
+#endif /* !__KERN_FS_BCACHE_H__ */
+
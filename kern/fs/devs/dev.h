@@ -10,6 +10,7 @@ struct iobuf;
 /**
  * d_blocks 设备占用的数据块个数
  * d_blocksize 数据块的大小
+ * d_maxblks 一次 d_io 请求最多传输的块数(块设备), 字符设备为0
  * d_open 打开设备的函数指针
  * d_close 关闭设备的函数指针
  * d_io 读写设备的函数指针
@@ -18,6 +19,7 @@ struct iobuf;
 struct device {
     size_t d_blocks;
     size_t d_blocksize;
+    size_t d_maxblks;
     int (*d_open)(struct device *dev, uint32_t open_flags);
     int (*d_close)(struct device *dev);
     int (*d_io)(struct device *dev, struct iobuf *iob, bool write);
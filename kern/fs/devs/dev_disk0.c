@@ -14,6 +14,9 @@
 #define DISK0_BUFSIZE                   (4 * DISK0_BLKSIZE)
 #define DISK0_BLK_NSECT                 (DISK0_BLKSIZE / SECTSIZE)
 
+/* iobufs that can bypass disk0_buffer */
+#define DISK0_IO_DIRECT(iob)            (((uintptr_t)(iob)->io_base % sizeof(uint32_t)) == 0)
+
 static char *disk0_buffer;
 static semaphore_t disk0_sem;
 
@@ -49,17 +52,17 @@ disk0_close(struct device *dev) {
  * 从磁盘扇区按块读取到内存, 无锁
  * 在 disk0_io 函数中被调用
  * 
- * 读取从 @blkno 开始的 @nblks 个块到 @disk0_buffer
+ * 读取从 @blkno 开始的 @nblks 个块到 @dst (@disk0_buffer 或调用者的缓冲区)
  * 
  * 块大小为 DISK0_BLKSIZE = PGSIZE = 4096
  * 扇区大小为 SECTSIZE = 512
  * disk0_buffer大小为 DISK0_BUFSIZE = 4 * DISK0_BLKSIZE
  **/
 static void
-disk0_read_blks_nolock(uint32_t blkno, uint32_t nblks) {
+disk0_read_blks_nolock(void *dst, uint32_t blkno, uint32_t nblks) {
     int ret;
     uint32_t sectno = blkno * DISK0_BLK_NSECT, nsecs = nblks * DISK0_BLK_NSECT;
-    if ((ret = ide_read_secs(DISK0_DEV_NO, sectno, disk0_buffer, nsecs)) != 0) {
+    if ((ret = ide_read_secs(DISK0_DEV_NO, sectno, dst, nsecs)) != 0) {
         panic("disk0: read blkno = %d (sectno = %d), nblks = %d (nsecs = %d): 0x%08x.\n",
                 blkno, sectno, nblks, nsecs, ret);
     }
@@ -69,25 +72,47 @@ disk0_read_blks_nolock(uint32_t blkno, uint32_t nblks) {
  * 从内存按块写入到磁盘扇区, 无锁
  * 在 disk0_io 函数中被调用
  * 
- * 从 @disk_buffer 写入到磁盘从 @blkno 开始的 @nblks 个块
+ * 从 @src 写入到磁盘从 @blkno 开始的 @nblks 个块
  * 写入失败会给出panic, 但没有返回值
  **/
 static void
-disk0_write_blks_nolock(uint32_t blkno, uint32_t nblks) {
+disk0_write_blks_nolock(const void *src, uint32_t blkno, uint32_t nblks) {
     int ret;
     uint32_t sectno = blkno * DISK0_BLK_NSECT, nsecs = nblks * DISK0_BLK_NSECT;
-    if ((ret = ide_write_secs(DISK0_DEV_NO, sectno, disk0_buffer, nsecs)) != 0) {
+    if ((ret = ide_write_secs(DISK0_DEV_NO, sectno, src, nsecs)) != 0) {
         panic("disk0: write blkno = %d (sectno = %d), nblks = %d (nsecs = %d): 0x%08x.\n",
                 blkno, sectno, nblks, nsecs, ret);
     }
 }
 
+/**
+ * 直接在 @iob 的缓冲区和磁盘之间传输, 不经过 @disk0_buffer, 也不加锁
+ * 每条 IDE 命令最多传输 d_maxblks 个块
+ * 
+ * 不同进程的请求由 IDE 通道的请求队列排队, 所以这里不需要 disk0 的锁
+ **/
+static void
+disk0_io_direct(struct device *dev, struct iobuf *iob, uint32_t blkno, uint32_t nblks, bool write) {
+    while (nblks != 0) {
+        uint32_t n = (nblks < dev->d_maxblks) ? nblks : dev->d_maxblks;
+        if (write) {
+            disk0_write_blks_nolock(iob->io_base, blkno, n);
+        }
+        else {
+            disk0_read_blks_nolock(iob->io_base, blkno, n);
+        }
+        iobuf_skip(iob, n * DISK0_BLKSIZE);
+        blkno += n, nblks -= n;
+    }
+}
+
 /**
  * disk0的io操作接口实现
  * 对应 struct device 中的 d_io 函数
  * 
  * 根据 @write 的值确定方向, 完成 @iob 和 @disk_buffer 的数据交换
  * 然后，调用磁盘块读写函数将数据持久化到磁盘中
+ * @iob 的缓冲区按 4 字节对齐时(IDE 以 32 位为单位读写数据端口)走 disk0_io_direct, 没有中间拷贝
  * 
  * 要求iobuf的偏移量和剩余长度必须是整数个块
  **/
@@ -113,6 +138,11 @@ disk0_io(struct device *dev, struct iobuf *iob, bool write) {
         return 0;
     }
 
+    if (DISK0_IO_DIRECT(iob)) {
+        disk0_io_direct(dev, iob, blkno, nblks, write);
+        return 0;
+    }
+
     lock_disk0();
     while (resid != 0) {
         size_t copied, alen = DISK0_BUFSIZE;
@@ -120,14 +150,14 @@ disk0_io(struct device *dev, struct iobuf *iob, bool write) {
             iobuf_move(iob, disk0_buffer, alen, 0, &copied);
             assert(copied != 0 && copied <= resid && copied % DISK0_BLKSIZE == 0);
             nblks = copied / DISK0_BLKSIZE;
-            disk0_write_blks_nolock(blkno, nblks);
+            disk0_write_blks_nolock(disk0_buffer, blkno, nblks);
         }
         else {
             if (alen > resid) {
                 alen = resid;
             }
             nblks = alen / DISK0_BLKSIZE;
-            disk0_read_blks_nolock(blkno, nblks);
+            disk0_read_blks_nolock(disk0_buffer, blkno, nblks);
             iobuf_move(iob, disk0_buffer, alen, 1, &copied);
             assert(copied == alen && copied % DISK0_BLKSIZE == 0);
         }
@@ -163,6 +193,7 @@ disk0_device_init(struct device *dev) {
     }
     dev->d_blocks = ide_device_size(DISK0_DEV_NO) / DISK0_BLK_NSECT;
     dev->d_blocksize = DISK0_BLKSIZE;
+    dev->d_maxblks = MAX_NSECS / DISK0_BLK_NSECT;
     dev->d_open = disk0_open;
     dev->d_close = disk0_close;
     dev->d_io = disk0_io;
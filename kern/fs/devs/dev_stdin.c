@@ -146,6 +146,7 @@ static void
 stdin_device_init(struct device *dev) {
     dev->d_blocks = 0;
     dev->d_blocksize = 1;
+    dev->d_maxblks = 0;
     dev->d_open = stdin_open;
     dev->d_close = stdin_close;
     dev->d_io = stdin_io;
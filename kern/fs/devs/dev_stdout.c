@@ -66,6 +66,7 @@ static void
 stdout_device_init(struct device *dev) {
     dev->d_blocks = 0;
     dev->d_blocksize = 1;
+    dev->d_maxblks = 0;
     dev->d_open = stdout_open;
     dev->d_close = stdout_close;
     dev->d_io = stdout_io;
@@ -10,6 +10,8 @@
 #include <dirent.h>
 #include <error.h>
 #include <assert.h>
+#include <filemap.h>
+#include <pipe.h>
 
 /* fd条件范围判断 */
 #define testfd(fd)                          ((fd) >= 0 && (fd) < FILES_STRUCT_NENTRY)
@@ -133,6 +135,7 @@ void
 fd_array_open(struct file *file) {
     assert(file->status == FD_INIT && file->node != NULL);
     file->status = FD_OPENED;
+    file->ra_window = 0, file->ra_next = file->pos;
     fopen_count_inc(file);
 }
 
@@ -217,6 +220,18 @@ file_testfd(int fd, bool readable, bool writable) {
     return 1;
 }
 
+// file_node - the inode of an opened file, the caller takes a reference to keep it
+int
+file_node(int fd, struct inode **node_store) {
+    int ret;
+    struct file *file;
+    if ((ret = fd2file(fd, &file)) != 0) {
+        return ret;
+    }
+    *node_store = file->node;
+    return 0;
+}
+
 
 // open file
 /**
@@ -294,8 +309,8 @@ file_close(int fd) {
  * @brief 通用文件接口读文件
  * 
  * @param fd 
- * @param base 
- * @param len 数据长度最大IOBUF_SIZE
+ * @param base 内核地址, 见sysfile_rw
+ * @param len 数据长度
  * @param copied_store 长度的地址
  * @return int 
  */
@@ -312,12 +327,25 @@ file_read(int fd, void *base, size_t len, size_t *copied_store) {
     }
     fd_array_acquire(file); 
 
+    /* 从上次读结束的位置继续读即为顺序读, 预读窗口从 FILE_RA_MIN_PAGES 开始每次翻倍; 否则关闭预读 */
+    if (file->pos != file->ra_next) {
+        file->ra_window = 0;
+    }
+    else if (file->ra_window == 0) {
+        file->ra_window = FILE_RA_MIN_PAGES;
+    }
+    else if (file->ra_window < FILE_RA_MAX_PAGES) {
+        file->ra_window *= 2;
+    }
+
     struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, file->pos); /* 初始化iob */
+    iob->io_readahead = file->ra_window * PGSIZE;
     ret = vop_read(file->node, iob);
 
     size_t copied = iobuf_used(iob);
     if (file->status == FD_OPENED) {
         file->pos += copied;
+        file->ra_next = file->pos;
     }
     *copied_store = copied;
     fd_array_release(file);
@@ -352,6 +380,10 @@ file_write(int fd, void *base, size_t len, size_t *copied_store) {
     ret = vop_write(file->node, iob);
 
     size_t copied = iobuf_used(iob);
+    if (copied != 0) {
+        // the mappings of the file see the write
+        filemap_update(file->node, file->pos, base, copied);
+    }
     if (file->status == FD_OPENED) {
         file->pos += copied;
     }
@@ -360,6 +392,58 @@ file_write(int fd, void *base, size_t len, size_t *copied_store) {
     return ret;
 }
 
+// file_pread - read at offset, the file position stays where it is; only for seekable files
+int
+file_pread(int fd, void *base, size_t len, off_t offset, size_t *copied_store) {
+    int ret;
+    struct file *file;
+    *copied_store = 0;
+    if ((ret = fd2file(fd, &file)) != 0) {
+        return ret;
+    }
+    if (!file->readable) {
+        return -E_INVAL;
+    }
+    fd_array_acquire(file);
+
+    // probe at 0, which never grows a file as a seek past its end does
+    if ((ret = vop_tryseek(file->node, 0)) == 0) {
+        struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, offset);
+        ret = vop_read(file->node, iob);
+        *copied_store = iobuf_used(iob);
+    }
+    fd_array_release(file);
+    return ret;
+}
+
+// file_pwrite - write at offset, the file position stays where it is; only for seekable files
+int
+file_pwrite(int fd, void *base, size_t len, off_t offset, size_t *copied_store) {
+    int ret;
+    struct file *file;
+    *copied_store = 0;
+    if ((ret = fd2file(fd, &file)) != 0) {
+        return ret;
+    }
+    if (!file->writable) {
+        return -E_INVAL;
+    }
+    fd_array_acquire(file);
+
+    if ((ret = vop_tryseek(file->node, 0)) == 0) {
+        struct iobuf __iob, *iob = iobuf_init(&__iob, base, len, offset);
+        ret = vop_write(file->node, iob);
+
+        size_t copied = iobuf_used(iob);
+        if (copied != 0) {
+            filemap_update(file->node, offset, base, copied);
+        }
+        *copied_store = copied;
+    }
+    fd_array_release(file);
+    return ret;
+}
+
 // seek file
 int
 file_seek(int fd, off_t pos, int whence) {
@@ -416,6 +500,10 @@ file_fsync(int fd) {
     }
     fd_array_acquire(file);
     ret = vop_fsync(file->node);
+    /* 超级块和 freemap 是延迟写回的，fsync 时一并写回才能保证持久 */
+    if (ret == 0 && vop_fs(file->node) != NULL) {
+        ret = fsop_sync(vop_fs(file->node));
+    }
     fd_array_release(file);
     return ret;
 }
@@ -453,4 +541,43 @@ file_dup(int fd1, int fd2) {
     return file2->fd;
 }
 
+/* *
+ * file_pipe - make a pipe, fd[0] is its read end and fd[1] its write end
+ * */
+int
+file_pipe(int fd[]) {
+    int ret;
+    struct file *file[2] = {NULL, NULL};
+    struct inode *node[2];
+    if ((ret = fd_array_alloc(NO_FD, &file[0])) != 0) {
+        goto failed_cleanup;
+    }
+    if ((ret = fd_array_alloc(NO_FD, &file[1])) != 0) {
+        goto failed_cleanup;
+    }
+    if ((ret = pipe_create(&node[0], &node[1])) != 0) {
+        goto failed_cleanup;
+    }
+
+    int i;
+    for (i = 0; i < 2; i ++) {
+        file[i]->pos = 0;
+        file[i]->node = node[i];
+        file[i]->readable = (i == 0);
+        file[i]->writable = (i == 1);
+        fd_array_open(file[i]);
+        fd[i] = file[i]->fd;
+    }
+    return 0;
+
+failed_cleanup:
+    if (file[0] != NULL) {
+        fd_array_free(file[0]);
+    }
+    if (file[1] != NULL) {
+        fd_array_free(file[1]);
+    }
+    return ret;
+}
+
 
@@ -15,29 +15,39 @@ struct dirent;
 /**
  * 指定文件文件系统的相关类型，包括读写权限，文件描述符fd,当前读到的位置POS
  * 文件系统中与硬盘特定区域所对应的节点node，以及打开此文件次数open_count
+ * ra_window/ra_next 记录顺序读的预读状态(见 file_read)
+ * readable/writable 只占一个字节, 使 struct file 保持 28 字节, 一页中仍能放下 128 个以上的文件
  */ 
 struct file {
     enum {
         FD_NONE, FD_INIT, FD_OPENED, FD_CLOSED,
     } status;                   //访问文件的执行状态
-    bool readable;              //文件是否可读
-    bool writable;              //文件是否可写
+    uint8_t readable;           //文件是否可读
+    uint8_t writable;           //文件是否可写
+    uint16_t ra_window;         //预读窗口(页数), 0表示当前不是顺序读
     int fd;                     //文件在filemap中的索引值
     off_t pos;                  //访问文件的当前位置
     struct inode *node;         //读文件对应的内存指针inode
     int open_count;             //打开此文件的次数
+    off_t ra_next;              //上一次读结束的位置, 从这里开始的读才算顺序读
 };
 
+#define FILE_RA_MIN_PAGES       4       /* window when a sequential read starts */
+#define FILE_RA_MAX_PAGES       16      /* window stops doubling here */
+
 void fd_array_init(struct file *fd_array);
 void fd_array_open(struct file *file);
 void fd_array_close(struct file *file);
 void fd_array_dup(struct file *to, struct file *from);
 bool file_testfd(int fd, bool readable, bool writable);
+int file_node(int fd, struct inode **node_store);
 
 int file_open(char *path, uint32_t open_flags);
 int file_close(int fd);
 int file_read(int fd, void *base, size_t len, size_t *copied_store);
 int file_write(int fd, void *base, size_t len, size_t *copied_store);
+int file_pread(int fd, void *base, size_t len, off_t offset, size_t *copied_store);
+int file_pwrite(int fd, void *base, size_t len, off_t offset, size_t *copied_store);
 int file_seek(int fd, off_t pos, int whence);
 int file_fstat(int fd, struct stat *stat);
 int file_fsync(int fd);
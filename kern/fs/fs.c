@@ -6,7 +6,63 @@
 #include <file.h>
 #include <sfs.h>
 #include <inode.h>
+#include <bcache.h>
+#include <proc.h>
+#include <sched.h>
+#include <sync.h>
 #include <assert.h>
+
+#define WB_TICK                             100     // kflushd 被定时器唤醒的周期 (1s)
+
+/**
+ * kflushd - 后台写回内核线程。
+ * write 只修改缓存中的 inode 和块就返回, 脏数据由 kflushd 批量写回:
+ * 它每隔 WB_TICK 由 add_timer 唤醒一次, 调用各文件系统的 fs_writeback,
+ * 后者按自己的 struct fs_wbctl 参数, 每 interval 写回脏了 expire 以上的
+ * inode、超级块/freemap 和缓存块, 脏块超过 dirty_thresh 时全部写回.
+ * 脏块超过阈值时文件系统还会用 fs_writeback_wakeup 提前唤醒它.
+ * fsync 与卸载时仍由 fsop_sync 立即写回.
+ */
+struct proc_struct *kflushd = NULL;
+
+static int
+kflushd_main(void *arg) {
+    timer_t __timer, *timer = &__timer;
+    while (1) {
+        vfs_writeback();
+        bool intr_flag;
+        local_intr_save(intr_flag);
+        {
+            timer_init(timer, current, WB_TICK);
+            current->state = PROC_SLEEPING;
+            current->wait_state = WT_WRITEBACK;
+            add_timer(timer);
+        }
+        local_intr_restore(intr_flag);
+        schedule();
+        del_timer(timer);
+    }
+    return 0;
+}
+
+static void
+kflushd_init(void) {
+    int pid = kernel_thread(kflushd_main, NULL, 0);
+    if (pid <= 0) {
+        panic("create kflushd failed.\n");
+    }
+    kflushd = find_proc(pid);
+    set_proc_name(kflushd, "kflushd");
+}
+
+// fs_writeback_wakeup - called when a fs has too many dirty blocks, run kflushd before its timer expires
+void
+fs_writeback_wakeup(void) {
+    if (kflushd != NULL && kflushd->wait_state == WT_WRITEBACK) {
+        wakeup_proc(kflushd);
+    }
+}
+
 //called when init_main proc start
 /**
  * init_main 进程出
@@ -14,8 +70,10 @@
 void
 fs_init(void) {
     vfs_init();
+    bcache_init();
     dev_init();
     sfs_init();
+    kflushd_init();
 }
 
 void
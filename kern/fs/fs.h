@@ -15,6 +15,10 @@
 
 void fs_init(void);
 void fs_cleanup(void);
+void fs_writeback_wakeup(void);
+
+struct proc_struct;
+extern struct proc_struct *kflushd;
 
 struct inode;
 struct file;
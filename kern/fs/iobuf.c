@@ -25,6 +25,7 @@ iobuf_init(struct iobuf *iob, void *base, size_t len, off_t offset) {
     iob->io_base = base;
     iob->io_offset = offset;
     iob->io_len = iob->io_resid = len;
+    iob->io_readahead = 0;
     return iob;
 }
 
@@ -11,6 +11,7 @@ struct iobuf {
     off_t io_offset;   // 当前读写的位置
     size_t io_len;     // 缓冲区长度
     size_t io_resid;   // 当前缓冲区剩余长度
+    size_t io_readahead; // 读操作的预读提示: 读完后预取之后这么多字节, 0表示不预读
 };
 
 #define iobuf_used(iob)                         ((size_t)((iob)->io_len - (iob)->io_resid))
@@ -0,0 +1,229 @@
+#include <defs.h>
+#include <string.h>
+#include <stat.h>
+#include <kmalloc.h>
+#include <proc.h>
+#include <sched.h>
+#include <vfs.h>
+#include <inode.h>
+#include <iobuf.h>
+#include <unistd.h>
+#include <error.h>
+#include <assert.h>
+#include <pipe.h>
+
+/* *
+ * The kernel is not preemptive and no interrupt handler touches a pipe, so
+ * the ring buffer needs no lock: a reader or writer only gives up the cpu when
+ * it waits, and looks at the buffer again when it wakes up.
+ *
+ * A read takes what there is, at least one byte: it waits while the pipe is
+ * empty, and gets 0 (end of file) once the write end is closed. A write of at
+ * most PIPE_BUF bytes goes into the buffer in one piece, so the writes of
+ * several writers do not mix; a longer one goes in as room comes. Writing to
+ * a pipe whose read end is closed fails with -E_PIPE.
+ * */
+
+#define pipe_used(state)                    ((state)->wpos - (state)->rpos)
+
+// pipe_wait - sleep on queue until the other end wakes us, -E_KILLED if it is a kill instead
+static int
+pipe_wait(wait_queue_t *queue) {
+    wait_t __wait, *wait = &__wait;
+    wait_current_set(queue, wait, WT_PIPE);
+    schedule();
+    wait_current_del(queue, wait);
+    if (wait->wakeup_flags != WT_PIPE) {
+        return -E_KILLED;
+    }
+    return 0;
+}
+
+static int
+pipe_read(struct inode *node, struct iobuf *iob) {
+    struct pipe_inode *pin = vop_info(node, pipe_inode);
+    struct pipe_state *state = pin->state;
+    int ret;
+    if (pin->write_end) {
+        return -E_INVAL;
+    }
+    while (pipe_used(state) == 0) {
+        if (!state->write_open) {
+            return 0;
+        }
+        if ((ret = pipe_wait(&(state->reader_queue))) != 0) {
+            return ret;
+        }
+    }
+
+    size_t alen, off, n;
+    while (iob->io_resid != 0 && (alen = pipe_used(state)) != 0) {
+        // up to the end of the buffer first, the rest from its start next time round
+        off = state->rpos % PIPE_SIZE;
+        if ((n = PIPE_SIZE - off) > alen) {
+            n = alen;
+        }
+        iobuf_move(iob, state->buf + off, n, 1, &n);
+        state->rpos += n;
+    }
+    wakeup_queue(&(state->writer_queue), WT_PIPE, 1);
+    return 0;
+}
+
+static int
+pipe_write(struct inode *node, struct iobuf *iob) {
+    struct pipe_inode *pin = vop_info(node, pipe_inode);
+    struct pipe_state *state = pin->state;
+    int ret;
+    if (!pin->write_end) {
+        return -E_INVAL;
+    }
+    bool atomic = (iob->io_resid <= PIPE_BUF);
+    size_t room, off, n;
+    while (iob->io_resid != 0) {
+        if (!state->read_open) {
+            return -E_PIPE;
+        }
+        room = PIPE_SIZE - pipe_used(state);
+        if (room == 0 || (atomic && room < iob->io_resid)) {
+            if ((ret = pipe_wait(&(state->writer_queue))) != 0) {
+                return ret;
+            }
+            continue;
+        }
+        off = state->wpos % PIPE_SIZE;
+        if ((n = PIPE_SIZE - off) > room) {
+            n = room;
+        }
+        iobuf_move(iob, state->buf + off, n, 0, &n);
+        state->wpos += n;
+        wakeup_queue(&(state->reader_queue), WT_PIPE, 1);
+    }
+    return 0;
+}
+
+// pipe_close - the last file that has the end open is closed, wake up the other end
+static int
+pipe_close(struct inode *node) {
+    struct pipe_inode *pin = vop_info(node, pipe_inode);
+    struct pipe_state *state = pin->state;
+    if (pin->write_end) {
+        state->write_open = 0;
+        wakeup_queue(&(state->reader_queue), WT_PIPE, 1);
+    }
+    else {
+        state->read_open = 0;
+        wakeup_queue(&(state->writer_queue), WT_PIPE, 1);
+    }
+    return 0;
+}
+
+// pipe_reclaim - free the end, and the buffer with the last end
+static int
+pipe_reclaim(struct inode *node) {
+    struct pipe_state *state = vop_info(node, pipe_inode)->state;
+    if (inode_ref_count(node) != 0) {
+        return -E_BUSY;
+    }
+    if (-- state->nr_ends == 0) {
+        assert(wait_queue_empty(&(state->reader_queue)) && wait_queue_empty(&(state->writer_queue)));
+        kfree(state->buf);
+        kfree(state);
+    }
+    vop_kill(node);
+    return 0;
+}
+
+static int
+pipe_gettype(struct inode *node, uint32_t *type_store) {
+    *type_store = S_IFIFO;
+    return 0;
+}
+
+// pipe_fstat - st_size is the bytes in the buffer
+static int
+pipe_fstat(struct inode *node, struct stat *stat) {
+    int ret;
+    memset(stat, 0, sizeof(struct stat));
+    if ((ret = vop_gettype(node, &(stat->st_mode))) != 0) {
+        return ret;
+    }
+    stat->st_nlinks = 1;
+    stat->st_size = pipe_used(vop_info(node, pipe_inode)->state);
+    return 0;
+}
+
+static int
+pipe_fsync(struct inode *node) {
+    return 0;
+}
+
+static int
+pipe_tryseek(struct inode *node, off_t pos) {
+    return -E_SEEK;
+}
+
+static const struct inode_ops pipe_node_ops = {
+    .vop_magic                      = VOP_MAGIC,
+    .vop_close                      = pipe_close,
+    .vop_read                       = pipe_read,
+    .vop_write                      = pipe_write,
+    .vop_fstat                      = pipe_fstat,
+    .vop_fsync                      = pipe_fsync,
+    .vop_reclaim                    = pipe_reclaim,
+    .vop_gettype                    = pipe_gettype,
+    .vop_tryseek                    = pipe_tryseek,
+};
+
+static struct inode *
+pipe_create_inode(struct pipe_state *state, bool write_end) {
+    struct inode *node;
+    if ((node = alloc_inode(pipe_inode)) != NULL) {
+        vop_init(node, &pipe_node_ops, NULL);
+        vop_open_inc(node);
+        struct pipe_inode *pin = vop_info(node, pipe_inode);
+        pin->state = state, pin->write_end = write_end;
+    }
+    return node;
+}
+
+/* *
+ * pipe_create - make a new pipe, its two ends come back referenced and open,
+ * as from vfs_open, and are given up with vfs_close.
+ * */
+int
+pipe_create(struct inode **rnode_store, struct inode **wnode_store) {
+    struct pipe_state *state;
+    struct inode *rnode, *wnode;
+    if ((state = kmalloc(sizeof(struct pipe_state))) == NULL) {
+        goto failed;
+    }
+    if ((state->buf = kmalloc(PIPE_SIZE)) == NULL) {
+        goto failed_cleanup_state;
+    }
+    state->rpos = state->wpos = 0;
+    state->read_open = state->write_open = 1;
+    state->nr_ends = 2;
+    wait_queue_init(&(state->reader_queue));
+    wait_queue_init(&(state->writer_queue));
+
+    if ((rnode = pipe_create_inode(state, 0)) == NULL) {
+        goto failed_cleanup_buf;
+    }
+    if ((wnode = pipe_create_inode(state, 1)) == NULL) {
+        goto failed_cleanup_rnode;
+    }
+    *rnode_store = rnode, *wnode_store = wnode;
+    return 0;
+
+failed_cleanup_rnode:
+    state->nr_ends = 1;
+    vfs_close(rnode);
+    return -E_NO_MEM;
+failed_cleanup_buf:
+    kfree(state->buf);
+failed_cleanup_state:
+    kfree(state);
+failed:
+    return -E_NO_MEM;
+}
@@ -0,0 +1,37 @@
+#ifndef __KERN_FS_PIPE_PIPE_H__
+#define __KERN_FS_PIPE_PIPE_H__
+
+#include <defs.h>
+#include <mmu.h>
+#include <wait.h>
+
+struct inode;
+
+/* *
+ * A pipe is a ring buffer of PIPE_SIZE bytes with two ends, each an inode of
+ * its own: the read end and the write end. An end is closed (vop_close) when
+ * the last file that has it open is closed, so the other end can tell that no
+ * one reads or writes any more.
+ * */
+
+#define PIPE_SIZE                   PGSIZE      // bytes the ring buffer holds
+
+/* what the two ends of a pipe share */
+struct pipe_state {
+    char *buf;                              // the ring buffer
+    size_t rpos, wpos;                      // read and write positions, they only grow
+    bool read_open, write_open;             // the ends not closed yet
+    int nr_ends;                            // the end inodes not reclaimed yet
+    wait_queue_t reader_queue;              // readers waiting for data
+    wait_queue_t writer_queue;              // writers waiting for room
+};
+
+/* an end of a pipe */
+struct pipe_inode {
+    struct pipe_state *state;
+    bool write_end;                         // the write end or the read end
+};
+
+int pipe_create(struct inode **rnode_store, struct inode **wnode_store);
+
+#endif /* !__KERN_FS_PIPE_PIPE_H__ */
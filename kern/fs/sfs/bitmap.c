@@ -54,19 +54,57 @@ bitmap_create(uint32_t nbits) {
 // 找到第一个值为1的位, 置为0并返回
 int
 bitmap_alloc(struct bitmap *bitmap, uint32_t *index_store) {
+    return bitmap_alloc_near(bitmap, 0, index_store);
+}
+
+/* *
+ * bitmap_alloc_near - like bitmap_alloc, but take the first free bit at or
+ * after goal, and only then (going round) one before it. The map is scanned
+ * a word at a time, and a free bit in a word found with one bsf.
+ * 从goal开始(到末尾后再从头)找第一个值为1的位
+ * */
+int
+bitmap_alloc_near(struct bitmap *bitmap, uint32_t goal, uint32_t *index_store) {
+    WORD_TYPE *map = bitmap->map, word;
+    uint32_t ix, i, nwords = bitmap->nwords;
+    if (goal >= bitmap->nbits) {
+        goal = 0;
+    }
+    ix = goal / WORD_BITS;
+    // the bits before goal in its word are looked at last, when the scan comes round
+    word = map[ix] & ((WORD_TYPE)(-1) << (goal % WORD_BITS));
+    for (i = 0; i <= nwords; i ++) {
+        if (word != 0) {
+            uint32_t offset = __builtin_ctz(word);
+            map[ix] ^= ((WORD_TYPE)1 << offset);
+            *index_store = ix * WORD_BITS + offset;
+            return 0;
+        }
+        if (++ ix == nwords) {
+            ix = 0;
+        }
+        word = map[ix];
+    }
+    return -E_NO_MEM;
+}
+
+/* *
+ * bitmap_find_run - find a word of free bits only (a run of WORD_BITS), the
+ * first at or after goal, going round. Nothing is allocated.
+ * 找一个全部空闲的字(连续WORD_BITS个空闲位), 返回其第一位
+ * */
+int
+bitmap_find_run(struct bitmap *bitmap, uint32_t goal, uint32_t *index_store) {
     WORD_TYPE *map = bitmap->map;
-    uint32_t ix, offset, nwords = bitmap->nwords;
-    for (ix = 0; ix < nwords; ix ++) {
-        if (map[ix] != 0) {
-            for (offset = 0; offset < WORD_BITS; offset ++) {
-                WORD_TYPE mask = (1 << offset);
-                if (map[ix] & mask) {
-                    map[ix] ^= mask;
-                    *index_store = ix * WORD_BITS + offset;
-                    return 0;
-                }
-            }
-            assert(0);
+    uint32_t ix, i, nwords = bitmap->nwords;
+    ix = (goal < bitmap->nbits) ? ROUNDUP_DIV(goal, WORD_BITS) : 0;
+    for (i = 0; i < nwords; i ++, ix ++) {
+        if (ix == nwords) {
+            ix = 0;
+        }
+        if (map[ix] == (WORD_TYPE)(-1)) {
+            *index_store = ix * WORD_BITS;
+            return 0;
         }
     }
     return -E_NO_MEM;
@@ -12,6 +12,8 @@
  *                      Returns NULL on error.
  *     bitmap_getdata - return pointer to raw bit data (for I/O).
  *     bitmap_alloc   - locate a cleared bit, set it, and return its index.
+ *     bitmap_alloc_near - likewise, the first one at or after a goal.
+ *     bitmap_find_run - locate a whole word of cleared bits.
  *     bitmap_mark    - set a clear bit by its index.
  *     bitmap_unmark  - clear a set bit by its index.
  *     bitmap_isset   - return whether a particular bit is set or not.
@@ -23,6 +25,8 @@ struct bitmap;
 
 struct bitmap *bitmap_create(uint32_t nbits);                     // allocate a new bitmap object.
 int bitmap_alloc(struct bitmap *bitmap, uint32_t *index_store);   // locate a cleared bit, set it, and return its index.
+int bitmap_alloc_near(struct bitmap *bitmap, uint32_t goal, uint32_t *index_store);   // likewise, at or after goal first
+int bitmap_find_run(struct bitmap *bitmap, uint32_t goal, uint32_t *index_store);     // a free word at or after goal
 bool bitmap_test(struct bitmap *bitmap, uint32_t index);          // return whether a particular bit is set or not.
 void bitmap_free(struct bitmap *bitmap, uint32_t index);          // according index, set related bit to 1
 void bitmap_destroy(struct bitmap *bitmap);                       // free memory contains bitmap
@@ -89,8 +89,11 @@ struct sfs_disk_entry {
  * din 磁盘上的inode
  * ino ino的编号
  * dirty 表示此inode是否被修改过
+ * dirtied 变脏时的ticks, kflushd据此按脏的时长写回
  * reclaim 当reclaim_count=0的时候从内存中删除这个索引节点
  * sem 这个din的信号量
+ * dirhash 目录的文件名索引, 第一次查找目录时建立
+ * alloc_goal 为该inode分配下一个块的目标位置, 0表示还未确定
  * inode_link inode链表
  * hash_link inode哈系表
  */ 
@@ -98,8 +101,11 @@ struct sfs_inode {
     struct sfs_disk_inode *din;                     /* on-disk inode */
     uint32_t ino;                                   /* inode number */
     bool dirty;                                     /* true if inode modified */
+    size_t dirtied;                                 /* ticks when it became dirty */
     int reclaim_count;                              /* kill inode if it hits zero */
     semaphore_t sem;                                /* semaphore for din */
+    struct sfs_dirhash *dirhash;                    /* name index of a dir, NULL until the first search */
+    uint32_t alloc_goal;                            /* the next block allocated for it goes here if free */
     list_entry_t inode_link;                        /* entry for linked-list in sfs_fs */
     list_entry_t hash_link;                         /* entry for hash linked-list in sfs_fs */
 };
@@ -113,6 +119,7 @@ struct sfs_fs {
     struct device *dev;                             /* device mounted on */
     struct bitmap *freemap;                         /* blocks in use are mared 0 */
     bool super_dirty;                               /* true if super/freemap modified */
+    size_t super_dirtied;                           /* ticks when super/freemap became dirty */
     void *sfs_buffer;                               /* buffer for non-block aligned io */
     semaphore_t fs_sem;                             /* semaphore for fs */
     semaphore_t io_sem;                             /* semaphore for io */
@@ -126,6 +133,15 @@ struct sfs_fs {
 #define SFS_HLIST_SIZE                              (1 << SFS_HLIST_SHIFT)
 #define sin_hashfn(x)                               (hash32(x, SFS_HLIST_SHIFT))
 
+/* name index of a dir (in memory), see sfs_dirent_search_nolock */
+#define SFS_DIRHASH_SHIFT                           7
+#define SFS_DIRHASH_SIZE                            (1 << SFS_DIRHASH_SHIFT)
+
+struct sfs_dirhash {
+    list_entry_t hash_list[SFS_DIRHASH_SIZE];       /* the slots in use, hashed by name */
+    list_entry_t free_list;                         /* the empty slots */
+};
+
 /* size of freemap (in bits) */
 #define sfs_freemap_bits(super)                     ROUNDUP((super)->blocks, SFS_BLKBITS)
 
@@ -145,6 +161,8 @@ void unlock_sfs_io(struct sfs_fs *sfs);
 
 int sfs_rblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks);
 int sfs_wblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks);
+int sfs_rablock(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
+bool sfs_block_cached(struct sfs_fs *sfs, uint32_t blkno);
 int sfs_rbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset);
 int sfs_wbuf(struct sfs_fs *sfs, void *buf, size_t len, uint32_t blkno, off_t offset);
 int sfs_sync_super(struct sfs_fs *sfs);
@@ -152,6 +170,7 @@ int sfs_sync_freemap(struct sfs_fs *sfs);
 int sfs_clear_block(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks);
 
 int sfs_load_inode(struct sfs_fs *sfs, struct inode **node_store, uint32_t ino);
+void sfs_dirhash_release(struct sfs_fs *sfs);
 
 #endif /* !__KERN_FS_SFS_SFS_H__ */
 
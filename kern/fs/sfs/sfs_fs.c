@@ -10,27 +10,38 @@
 #include <inode.h>
 #include <iobuf.h>
 #include <bitmap.h>
+#include <bcache.h>
+#include <clock.h>
 #include <error.h>
 #include <assert.h>
 
+/* writeback tunables of a newly mounted sfs (fs->fs_wb), see kflushd in fs.c */
+#define SFS_WB_INTERVAL                     500                 // 5s
+#define SFS_WB_EXPIRE                       3000                // 30s
+#define SFS_WB_DIRTY_THRESH                 (BCACHE_NBUF / 4)
+
 /*
- * sfs_sync - sync sfs's superblock and freemap in memroy into disk
+ * sfs_flush - write the inodes, superblock and freemap dirty for at least age
+ *             ticks into the buffer cache, then write back the blocks of
+ *             sfs->dev dirty for at least age ticks; age 0 writes back all
  */
 static int
-sfs_sync(struct fs *fs) {
-    struct sfs_fs *sfs = fsop_info(fs, sfs);
+sfs_flush(struct sfs_fs *sfs, unsigned int age) {
+    size_t now = ticks;
     lock_sfs_fs(sfs);
     {
         list_entry_t *list = &(sfs->inode_list), *le = list;
         while ((le = list_next(le)) != list) {
             struct sfs_inode *sin = le2sin(le, inode_link);
-            vop_fsync(info2node(sin, sfs_inode));
+            if (sin->dirty && now - sin->dirtied >= age) {
+                vop_fsync(info2node(sin, sfs_inode));
+            }
         }
     }
     unlock_sfs_fs(sfs);
 
     int ret;
-    if (sfs->super_dirty) {
+    if (sfs->super_dirty && now - sfs->super_dirtied >= age) {
         sfs->super_dirty = 0;
         if ((ret = sfs_sync_super(sfs)) != 0) {
             sfs->super_dirty = 1;
@@ -41,6 +52,34 @@ sfs_sync(struct fs *fs) {
             return ret;
         }
     }
+    return bcache_writeback(sfs->dev, age);
+}
+
+/*
+ * sfs_sync - sync the inodes, superblock and freemap in memroy into disk,
+ *            then write back the dirty blocks of sfs->dev in the buffer cache
+ */
+static int
+sfs_sync(struct fs *fs) {
+    return sfs_flush(fsop_info(fs, sfs), 0);
+}
+
+/*
+ * sfs_writeback - called by kflushd every second: every fs_wb.interval write
+ *                 back what has been dirty for fs_wb.expire, and all dirty
+ *                 blocks at once when there are more than fs_wb.dirty_thresh
+ */
+static int
+sfs_writeback(struct fs *fs) {
+    struct sfs_fs *sfs = fsop_info(fs, sfs);
+    struct fs_wbctl *wb = &(fs->fs_wb);
+    if (ticks - wb->last >= wb->interval) {
+        wb->last = ticks;
+        return sfs_flush(sfs, wb->expire);
+    }
+    if (bcache_dirty_count(sfs->dev) > wb->dirty_thresh) {
+        return bcache_writeback(sfs->dev, 0);
+    }
     return 0;
 }
 
@@ -67,6 +106,7 @@ sfs_unmount(struct fs *fs) {
         return -E_BUSY;
     }
     assert(!sfs->super_dirty);
+    bcache_invalidate(sfs->dev);
     bitmap_destroy(sfs->freemap);
     kfree(sfs->sfs_buffer);
     kfree(sfs->hash_list);
@@ -94,6 +134,7 @@ sfs_cleanup(struct fs *fs) {
     if (ret != 0) {
         warn("sfs: sync error: '%s': %e.\n", sfs->super.info, ret);
     }
+    sfs_dirhash_release(sfs);
 }
 
 /*
@@ -241,7 +282,7 @@ sfs_do_mount(struct device *dev, struct fs **fs_store) {
 
     /* and other fields */
     /* 其他部分字段初始化 */
-    sfs->super_dirty = 0;
+    sfs->super_dirty = 0, sfs->super_dirtied = 0;
     sem_init(&(sfs->fs_sem), 1);
     sem_init(&(sfs->io_sem), 1);
     sem_init(&(sfs->mutex_sem), 1);
@@ -255,6 +296,11 @@ sfs_do_mount(struct device *dev, struct fs **fs_store) {
     fs->fs_get_root = sfs_get_root;
     fs->fs_unmount = sfs_unmount;
     fs->fs_cleanup = sfs_cleanup;
+    fs->fs_writeback = sfs_writeback;
+    fs->fs_wb.interval = SFS_WB_INTERVAL;
+    fs->fs_wb.expire = SFS_WB_EXPIRE;
+    fs->fs_wb.dirty_thresh = SFS_WB_DIRTY_THRESH;
+    fs->fs_wb.last = ticks;
     *fs_store = fs;
     return 0;
 
@@ -10,6 +10,8 @@
 #include <inode.h>
 #include <iobuf.h>
 #include <bitmap.h>
+#include <bcache.h>
+#include <clock.h>
 #include <error.h>
 #include <assert.h>
 
@@ -76,6 +78,26 @@ sfs_remove_links(struct sfs_inode *sin) {
     list_del(&(sin->hash_link));
 }
 
+/*
+ * sfs_dirty_inode - mark sin modified, remember since when (kflushd writes it back by age)
+ */
+static inline void
+sfs_dirty_inode(struct sfs_inode *sin) {
+    if (!sin->dirty) {
+        sin->dirty = 1, sin->dirtied = ticks;
+    }
+}
+
+/*
+ * sfs_dirty_super - mark the superblock and freemap modified, remember since when
+ */
+static inline void
+sfs_dirty_super(struct sfs_fs *sfs) {
+    if (!sfs->super_dirty) {
+        sfs->super_dirty = 1, sfs->super_dirtied = ticks;
+    }
+}
+
 /*
  * sfs_block_inuse - check the inode with NO. ino inuse info in bitmap
  * 查询对应块是否被使用
@@ -88,35 +110,21 @@ sfs_block_inuse(struct sfs_fs *sfs, uint32_t ino) {
     panic("sfs_block_inuse: called out of range (0, %u) %u.\n", sfs->super.blocks, ino);
 }
 
-static int sfs_super_sync(struct sfs_fs *sfs)
-{
-    int ret;
-    if (sfs->super_dirty) {
-        sfs->super_dirty = 0;
-        if ((ret = sfs_sync_super(sfs)) != 0) {
-            sfs->super_dirty = 1;
-            return ret;
-        }
-        if ((ret = sfs_sync_freemap(sfs)) != 0) {
-            sfs->super_dirty = 1;
-            return ret;
-        }
-    }
-}
-
 /*
  * sfs_block_alloc -  check and get a free disk block
  * 分配一个空闲块, 可用于inode或数据
+ * 取goal处或其后第一个空闲块; 超级块和freemap只标记为dirty, 由kflushd或sfs_sync写回
+ * 新块清零也只写到块缓存中
  */
 static int
-sfs_block_alloc(struct sfs_fs *sfs, uint32_t *ino_store) {
+sfs_block_alloc(struct sfs_fs *sfs, uint32_t goal, uint32_t *ino_store) {
     int ret;
-    if ((ret = bitmap_alloc(sfs->freemap, ino_store)) != 0) {
+    if ((ret = bitmap_alloc_near(sfs->freemap, goal, ino_store)) != 0) {
         return ret;
     }
     assert(sfs->super.unused_blocks > 0);
-    sfs->super.unused_blocks --, sfs->super_dirty = 1;
-    sfs_super_sync(sfs);
+    sfs->super.unused_blocks --;
+    sfs_dirty_super(sfs);
     assert(sfs_block_inuse(sfs, *ino_store));
     return sfs_clear_block(sfs, *ino_store, 1);
 }
@@ -129,8 +137,42 @@ static void
 sfs_block_free(struct sfs_fs *sfs, uint32_t ino) {
     assert(sfs_block_inuse(sfs, ino));
     bitmap_free(sfs->freemap, ino);
-    sfs->super.unused_blocks ++, sfs->super_dirty = 1;
-    sfs_super_sync(sfs);
+    sfs->super.unused_blocks ++;
+    sfs_dirty_super(sfs);
+}
+
+/*
+ * sfs_block_run - the start of a free run (a word of the freemap) at or after
+ * near, for something that is to grow there; near itself if there is none
+ * 找near之后一段连续的空闲块的起点, 新文件的inode从这里开始, 数据块紧随其后
+ */
+static uint32_t
+sfs_block_run(struct sfs_fs *sfs, uint32_t near) {
+    uint32_t start;
+    if (bitmap_find_run(sfs->freemap, near, &start) == 0) {
+        return start;
+    }
+    return near;
+}
+
+/*
+ * sfs_block_goal - where the next block of sin goes: right after the last one
+ * allocated for it, so that a file being appended to gets contiguous blocks
+ * 文件下一个块的目标位置: 紧跟在上一次为它分配的块之后
+ */
+static uint32_t
+sfs_block_goal(struct sfs_fs *sfs, struct sfs_inode *sin) {
+    struct sfs_disk_inode *din = sin->din;
+    if (sin->alloc_goal == 0) {
+        // not allocated since loaded: after its last direct block, or after the inode
+        if (din->blocks != 0 && din->blocks <= SFS_NDIRECT && din->direct[din->blocks - 1] != 0) {
+            sin->alloc_goal = din->direct[din->blocks - 1] + 1;
+        }
+        else {
+            sin->alloc_goal = sin->ino + 1;
+        }
+    }
+    return sin->alloc_goal;
 }
 
 /*
@@ -145,7 +187,8 @@ sfs_create_inode(struct sfs_fs *sfs, struct sfs_disk_inode *din, uint32_t ino, s
     if ((node = alloc_inode(sfs_inode)) != NULL) {
         vop_init(node, sfs_get_ops(din->type), info2fs(sfs, sfs));
         struct sfs_inode *sin = vop_info(node, sfs_inode);
-        sin->din = din, sin->ino = ino, sin->dirty = 0, sin->reclaim_count = 1;
+        sin->din = din, sin->ino = ino, sin->dirty = 0, sin->dirtied = 0, sin->reclaim_count = 1;
+        sin->dirhash = NULL, sin->alloc_goal = 0;
         sem_init(&(sin->sem), 1);
         *node_store = node;
         return 0;
@@ -239,7 +282,7 @@ failed_unlock:
  * - 当对应的索引项未分配索引块时, 分配一个索引块
  **/
 static int
-sfs_bmap_get_sub_nolock(struct sfs_fs *sfs, uint32_t *entp, uint32_t index, bool create, uint32_t *ino_store) {
+sfs_bmap_get_sub_nolock(struct sfs_fs *sfs, uint32_t *entp, uint32_t index, bool create, uint32_t *goalp, uint32_t *ino_store) {
     assert(index < SFS_BLK_NENTRY);
     int ret;
     uint32_t ent, ino = 0;
@@ -258,14 +301,16 @@ sfs_bmap_get_sub_nolock(struct sfs_fs *sfs, uint32_t *entp, uint32_t index, bool
             goto out;
         }
 		//if entry block isn't existd, allocated a entry block (for indrect block)
-        if ((ret = sfs_block_alloc(sfs, &ent)) != 0) {
+        if ((ret = sfs_block_alloc(sfs, *goalp, &ent)) != 0) {
             return ret;
         }
+        *goalp = ent + 1;
     }
     
-    if ((ret = sfs_block_alloc(sfs, &ino)) != 0) {
+    if ((ret = sfs_block_alloc(sfs, *goalp, &ino)) != 0) {
         goto failed_cleanup;
     }
+    *goalp = ino + 1;
     if ((ret = sfs_wbuf(sfs, &ino, sizeof(uint32_t), ent, offset)) != 0) {
         sfs_block_free(sfs, ino);
         goto failed_cleanup;
@@ -308,11 +353,12 @@ sfs_bmap_get_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, b
 	// the index of disk block is in the fist SFS_NDIRECT  direct blocks
     if (index < SFS_NDIRECT) {
         if ((ino = din->direct[index]) == 0 && create) {
-            if ((ret = sfs_block_alloc(sfs, &ino)) != 0) {
+            if ((ret = sfs_block_alloc(sfs, sfs_block_goal(sfs, sin), &ino)) != 0) {
                 return ret;
             }
+            sin->alloc_goal = ino + 1;
             din->direct[index] = ino;
-            sin->dirty = 1;
+            sfs_dirty_inode(sin);
         }
         goto out;
     }
@@ -320,13 +366,15 @@ sfs_bmap_get_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index, b
     index -= SFS_NDIRECT;
     if (index < SFS_BLK_NENTRY) {
         ent = din->indirect;
-        if ((ret = sfs_bmap_get_sub_nolock(sfs, &ent, index, create, &ino)) != 0) {
+        uint32_t goal = sfs_block_goal(sfs, sin);
+        if ((ret = sfs_bmap_get_sub_nolock(sfs, &ent, index, create, &goal, &ino)) != 0) {
             return ret;
         }
+        sin->alloc_goal = goal;
         if (ent != din->indirect) {
             assert(din->indirect == 0);
             din->indirect = ent;
-            sin->dirty = 1;
+            sfs_dirty_inode(sin);
         }
         goto out;
     } else {
@@ -375,7 +423,7 @@ sfs_bmap_free_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, uint32_t index)
 			// free the block
             sfs_block_free(sfs, ino);
             din->direct[index] = 0;
-            sin->dirty = 1;
+            sfs_dirty_inode(sin);
         }
         return 0;
     }
@@ -434,7 +482,7 @@ sfs_bmap_truncate_nolock(struct sfs_fs *sfs, struct sfs_inode *sin) {
         return ret;
     }
     din->blocks --;
-    sin->dirty = 1;
+    sfs_dirty_inode(sin);
     return 0;
 }
 
@@ -465,6 +513,182 @@ sfs_dirent_read_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int slot, stru
     return 0;
 }
 
+/* *
+ * A dir keeps one entry per block, its slot. The first search of a dir reads
+ * all its slots once and builds sin->dirhash: the names in use hashed to their
+ * slots, and a list of the empty slots. From then on search, link and unlink
+ * go by the index and read no slot to find a name, whatever the size of the
+ * dir. If there is no memory for the index, a search reads the slots.
+ * */
+struct sfs_dirhash_entry {
+    uint32_t ino;                                   /* 0 for an empty slot */
+    int slot;                                       /* the slot of the entry */
+    list_entry_t link;                              /* in a hash list, or in the free list if empty */
+    char name[0];                                   /* the name, "" for an empty slot */
+};
+
+#define le2dhe(le)                                  \
+    to_struct((le), struct sfs_dirhash_entry, link)
+
+static list_entry_t *
+sfs_dirhash_list(struct sfs_dirhash *dh, const char *name) {
+    uint32_t h = 0;
+    while (*name != '\0') {
+        h = h * 31 + (unsigned char)(*name ++);
+    }
+    return dh->hash_list + hash32(h, SFS_DIRHASH_SHIFT);
+}
+
+static struct sfs_dirhash_entry *
+sfs_dirhash_lookup(struct sfs_dirhash *dh, const char *name) {
+    list_entry_t *list = sfs_dirhash_list(dh, name), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct sfs_dirhash_entry *dhe = le2dhe(le);
+        if (strcmp(name, dhe->name) == 0) {
+            return dhe;
+        }
+    }
+    return NULL;
+}
+
+// sfs_dirhash_add - index slot as name -> ino, or as an empty slot if ino is 0
+static int
+sfs_dirhash_add(struct sfs_dirhash *dh, int slot, uint32_t ino, const char *name) {
+    size_t len = (ino != 0) ? strlen(name) : 0;
+    struct sfs_dirhash_entry *dhe;
+    if ((dhe = kmalloc(sizeof(struct sfs_dirhash_entry) + len + 1)) == NULL) {
+        return -E_NO_MEM;
+    }
+    dhe->ino = ino, dhe->slot = slot;
+    memcpy(dhe->name, name, len);
+    dhe->name[len] = '\0';
+    list_add((ino != 0) ? sfs_dirhash_list(dh, name) : &(dh->free_list), &(dhe->link));
+    return 0;
+}
+
+static void
+sfs_dirhash_free_list(list_entry_t *list) {
+    list_entry_t *le;
+    while ((le = list_next(list)) != list) {
+        list_del(le);
+        kfree(le2dhe(le));
+    }
+}
+
+// sfs_dirhash_destroy - drop the index of the dir, the next search builds it again
+static void
+sfs_dirhash_destroy(struct sfs_inode *sin) {
+    struct sfs_dirhash *dh;
+    if ((dh = sin->dirhash) != NULL) {
+        int i;
+        for (i = 0; i < SFS_DIRHASH_SIZE; i ++) {
+            sfs_dirhash_free_list(dh->hash_list + i);
+        }
+        sfs_dirhash_free_list(&(dh->free_list));
+        kfree(dh);
+        sin->dirhash = NULL;
+    }
+}
+
+/*
+ * sfs_dirhash_release - drop the index of every dir in memory, called by
+ * sfs_cleanup so that the memory is given back; a later search rebuilds it
+ */
+void
+sfs_dirhash_release(struct sfs_fs *sfs) {
+    lock_sfs_fs(sfs);
+    {
+        list_entry_t *list = &(sfs->inode_list), *le = list;
+        while ((le = list_next(le)) != list) {
+            struct sfs_inode *sin = le2sin(le, inode_link);
+            if (sin->dirhash != NULL) {
+                lock_sin(sin);
+                sfs_dirhash_destroy(sin);
+                unlock_sin(sin);
+            }
+        }
+    }
+    unlock_sfs_fs(sfs);
+}
+
+// sfs_dirhash_build - read every slot of the dir once and index it
+static int
+sfs_dirhash_build(struct sfs_fs *sfs, struct sfs_inode *sin) {
+    assert(sin->dirhash == NULL);
+    struct sfs_dirhash *dh;
+    struct sfs_disk_entry *entry;
+    if ((dh = kmalloc(sizeof(struct sfs_dirhash))) == NULL) {
+        return -E_NO_MEM;
+    }
+    int ret, i, nslots = sin->din->blocks;
+    for (i = 0; i < SFS_DIRHASH_SIZE; i ++) {
+        list_init(dh->hash_list + i);
+    }
+    list_init(&(dh->free_list));
+    sin->dirhash = dh;
+
+    ret = -E_NO_MEM;
+    if ((entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
+        goto failed;
+    }
+    for (i = 0; i < nslots; i ++) {
+        if ((ret = sfs_dirent_read_nolock(sfs, sin, i, entry)) != 0) {
+            goto failed_cleanup_entry;
+        }
+        if ((ret = sfs_dirhash_add(dh, i, entry->ino, entry->name)) != 0) {
+            goto failed_cleanup_entry;
+        }
+    }
+    kfree(entry);
+    return 0;
+
+failed_cleanup_entry:
+    kfree(entry);
+failed:
+    sfs_dirhash_destroy(sin);
+    return ret;
+}
+
+// sfs_dirhash_link - the empty (or new) slot now holds name -> ino
+static void
+sfs_dirhash_link(struct sfs_inode *sin, int slot, uint32_t ino, const char *name) {
+    struct sfs_dirhash *dh;
+    if ((dh = sin->dirhash) == NULL) {
+        return;
+    }
+    // the search hands out the first empty slot, so it is found at once
+    list_entry_t *list = &(dh->free_list), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct sfs_dirhash_entry *dhe = le2dhe(le);
+        if (dhe->slot == slot) {
+            list_del(le);
+            kfree(dhe);
+            break;
+        }
+    }
+    if (sfs_dirhash_add(dh, slot, ino, name) != 0) {
+        sfs_dirhash_destroy(sin);
+    }
+}
+
+// sfs_dirhash_unlink - the slot of name is empty now
+static void
+sfs_dirhash_unlink(struct sfs_inode *sin, int slot, const char *name) {
+    struct sfs_dirhash *dh;
+    struct sfs_dirhash_entry *dhe;
+    if ((dh = sin->dirhash) == NULL) {
+        return;
+    }
+    if ((dhe = sfs_dirhash_lookup(dh, name)) == NULL || dhe->slot != slot) {
+        // not what the index says, do not trust it any more
+        sfs_dirhash_destroy(sin);
+        return;
+    }
+    list_del(&(dhe->link));
+    dhe->ino = 0, dhe->name[0] = '\0';
+    list_add(&(dh->free_list), &(dhe->link));
+}
+
 /**
  * sfs_dirent_link_nolock - 将目录项链接到一个inode上
  * @sfs: sfs文件系统
@@ -497,10 +721,11 @@ static int sfs_dirent_link_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, int
         kfree(entry);
         return ret;
     }
+    sfs_dirhash_link(sin, slot, lnksin->ino, entry->name);
     // 更新被链接inode的链接数
-    lnksin->dirty = 1;
+    sfs_dirty_inode(lnksin);
     lnksin->din->nlinks ++;
-    sin->dirty = 1;
+    sfs_dirty_inode(sin);
     kfree(entry);
     return 0;
 }
@@ -541,15 +766,16 @@ static int sfs_dirent_unlink_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, i
         goto failed_cleanup;
     // 清空目录项
     if ((ret = sfs_clear_block(sfs, ino, 1)) != 0) {
-        return ret;
+        goto failed_cleanup;
     }
+    sfs_dirhash_unlink(sin, slot, entry->name);
     lnkdin->nlinks --;
     // 如果是被链接的文件是目录文件, 父目录的硬链接数减1(".."目录项)
     if(S_ISDIR(lnkdin->type)) {
         din->nlinks --;
     }
-    lnksin->dirty = 1;
-    sin->dirty = 1;
+    sfs_dirty_inode(lnksin);
+    sfs_dirty_inode(sin);
 
     kfree(entry);
     return 0;
@@ -569,19 +795,35 @@ failed_cleanup:
  * @slot:       logical index of file entry (NOTICE: each file entry ocupied one  disk block)
  * @empty_slot: the empty logical index of file entry.
  * 读取目录inode中的每一个块的目录项并检查与目标文件名是否匹配
- * 对应的块索引存储在slot内, 对应文件的inode块号存储在ino_store中, empty_slot中存储最后一个无效目录项的索引号
+ * 对应的块索引存储在slot内, 对应文件的inode块号存储在ino_store中, empty_slot中存储一个无效目录项的索引号
+ * 目录有索引(sin->dirhash)时直接查索引, 第一次查找时建立索引
  */
 static int
 sfs_dirent_search_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, const char *name, uint32_t *ino_store, int *slot, int *empty_slot) {
     assert(strlen(name) <= SFS_MAX_FNAME_LEN);
+#define set_pvalue(x, v)            do { if ((x) != NULL) { *(x) = (v); } } while (0)
+    int ret, i, nslots = sin->din->blocks;
+    set_pvalue(empty_slot, nslots);
+
+    struct sfs_dirhash *dh;
+    if (sin->dirhash != NULL || sfs_dirhash_build(sfs, sin) == 0) {
+        dh = sin->dirhash;
+        struct sfs_dirhash_entry *dhe;
+        if ((dhe = sfs_dirhash_lookup(dh, name)) != NULL) {
+            set_pvalue(slot, dhe->slot);
+            set_pvalue(ino_store, dhe->ino);
+            return 0;
+        }
+        if (!list_empty(&(dh->free_list))) {
+            set_pvalue(empty_slot, le2dhe(list_next(&(dh->free_list)))->slot);
+        }
+        return -E_NOENT;
+    }
+
     struct sfs_disk_entry *entry;
     if ((entry = kmalloc(sizeof(struct sfs_disk_entry))) == NULL) {
         return -E_NO_MEM;
     }
-
-#define set_pvalue(x, v)            do { if ((x) != NULL) { *(x) = (v); } } while (0)
-    int ret, i, nslots = sin->din->blocks;
-    set_pvalue(empty_slot, nslots);
     for (i = 0; i < nslots; i ++) {
         if ((ret = sfs_dirent_read_nolock(sfs, sin, i, entry)) != 0) {
             goto out;
@@ -793,15 +1035,25 @@ sfs_io_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, void *buf, off_t offset
         buf += size, blkno ++, nblks --;
     }
 
-    size = SFS_BLKSIZE;
+    /* 物理上连续的块合并成一个 extent, 一次 sfs_block_op 完成, 最多 d_maxblks 块 */
+    uint32_t len, next, maxblks = sfs->dev->d_maxblks;
     while (nblks != 0) {
         if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno, &ino)) != 0) {
             goto out;
         }
-        if ((ret = sfs_block_op(sfs, buf, ino, 1)) != 0) {
+        for (len = 1; len < nblks && len < maxblks; len ++) {
+            if ((ret = sfs_bmap_load_nolock(sfs, sin, blkno + len, &next)) != 0) {
+                goto out;
+            }
+            if (next != ino + len) {
+                break;
+            }
+        }
+        if ((ret = sfs_block_op(sfs, buf, ino, len)) != 0) {
             goto out;
         }
-        alen += size, buf += size, blkno ++, nblks --;
+        size = len * SFS_BLKSIZE;
+        alen += size, buf += size, blkno += len, nblks -= len;
     }
 
     if ((size = endpos % SFS_BLKSIZE) != 0) {
@@ -817,11 +1069,58 @@ out:
     *alenp = alen;
     if (offset + alen > sin->din->size) {
         sin->din->size = offset + alen;
-        sin->dirty = 1;
+        sfs_dirty_inode(sin);
     }
     return ret;
 }
 
+/*
+ * sfs_readahead_nolock - prefetch the blocks of file that cover [pos, pos + len) into the buffer cache
+ * 预读从pos开始长度为len的文件数据块, 物理上连续的块一次读入
+ * 只有当窗口后半部分的块已不在缓存中时才发起预读, 这样每次预读都能批量读入半个窗口以上的块
+ * 预读失败不影响本次读操作, 所以不返回错误
+ */
+static void
+sfs_readahead_nolock(struct sfs_fs *sfs, struct sfs_inode *sin, off_t pos, size_t len) {
+    struct sfs_disk_inode *din = sin->din;
+    uint32_t blkno = pos / SFS_BLKSIZE, endblk, ino, next, n;
+    if (pos >= din->size) {
+        return;
+    }
+    if (len > din->size - pos) {
+        len = din->size - pos;
+    }
+    endblk = ROUNDUP_DIV(pos + len, SFS_BLKSIZE);
+    if (endblk > din->blocks) {
+        endblk = din->blocks;
+    }
+    if (blkno >= endblk) {
+        return;
+    }
+    // at most BCACHE_RA_MAX buffers hold prefetched blocks, more would push out the ones not read yet
+    if (endblk - blkno > BCACHE_RA_MAX) {
+        endblk = blkno + BCACHE_RA_MAX;
+    }
+
+    if (sfs_bmap_get_nolock(sfs, sin, blkno + (endblk - blkno) / 2, 0, &ino) != 0 || sfs_block_cached(sfs, ino)) {
+        return;
+    }
+    while (blkno < endblk) {
+        if (sfs_bmap_get_nolock(sfs, sin, blkno, 0, &ino) != 0) {
+            return;
+        }
+        for (n = 1; blkno + n < endblk && n < BCACHE_RA_NBLKS; n ++) {
+            if (sfs_bmap_get_nolock(sfs, sin, blkno + n, 0, &next) != 0 || next != ino + n) {
+                break;
+            }
+        }
+        if (sfs_rablock(sfs, ino, n) != 0) {
+            return;
+        }
+        blkno += n;
+    }
+}
+
 /*
  * sfs_io - Rd/Wr file. the wrapper of sfs_io_nolock
             with lock protect
@@ -839,6 +1138,9 @@ sfs_io(struct inode *node, struct iobuf *iob, bool write) {
         if (alen != 0) {
             iobuf_skip(iob, alen);
         }
+        if (!write && ret == 0 && iob->io_readahead != 0) {
+            sfs_readahead_nolock(sfs, sin, iob->io_offset, iob->io_readahead);
+        }
     }
     unlock_sin(sin);
     return ret;
@@ -1066,6 +1368,7 @@ sfs_reclaim(struct inode *node) {
             sfs_block_free(sfs, ent);
         }
     }
+    sfs_dirhash_destroy(sin);
     kfree(sin->din);
     vop_kill(node);
     return 0;
@@ -1156,7 +1459,7 @@ sfs_truncfile(struct inode *node, off_t len) {
     }
     assert(din->blocks == tblks);
     din->size = len;
-    sin->dirty = 1;
+    sfs_dirty_inode(sin);
 
 out_unlock:
     unlock_sin(sin);
@@ -1213,7 +1516,7 @@ static int sfs_create_sub_nolock(struct sfs_fs *sfs, struct inode **node_store,
     }
 
     struct sfs_inode *sin = vop_info(*node_store, sfs_inode);
-    sin->dirty = 1;
+    sfs_dirty_inode(sin);
     sfs_set_links(sfs, sin);
 
     return 0;
@@ -1249,8 +1552,8 @@ int sfs_create(struct inode *node, const char *name, bool excl, struct inode **n
 
     /* 如果inode不存在, 创建文件的inode */
     struct inode *new_node;
-    // 申请磁盘块
-    if ((ret = sfs_block_alloc(sfs, &ino)) != 0) {
+    // 申请磁盘块, 在父目录之后的一段空闲块开头, 留出文件增长的空间
+    if ((ret = sfs_block_alloc(sfs, sfs_block_run(sfs, sin->ino), &ino)) != 0) {
         goto failed_unlock;
     }
     assert(sfs_block_inuse(sfs, ino));
@@ -1298,7 +1601,7 @@ int sfs_mkdir(struct inode *node, const char *name)
         return -E_EXISTS;
     }
     // 申请磁盘块, 用于inode
-    if ((ret = sfs_block_alloc(sfs, &ino)) != 0) {
+    if ((ret = sfs_block_alloc(sfs, sfs_block_run(sfs, sin->ino), &ino)) != 0) {
         goto failed_unlock;
     }
     // 构造目录文件inode
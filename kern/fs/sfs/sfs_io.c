@@ -4,6 +4,9 @@
 #include <sfs.h>
 #include <iobuf.h>
 #include <bitmap.h>
+#include <bcache.h>
+#include <vfs.h>
+#include <fs.h>
 #include <assert.h>
 
 //Basic block-level I/O routines
@@ -15,12 +18,24 @@
  * @blkno: the NO. of disk block
  * @write: BOOL: Read or Write
  * @check: BOOL: if check (blono < sfs super.blocks)
+ *
+ * All block I/O goes through the buffer cache; writes are deferred until
+ * kflushd writes them back (see sfs_writeback), until sfs_sync or until the
+ * buffer is evicted. Too many dirty blocks wake kflushd at once.
  */
 static int
 sfs_rwblock_nolock(struct sfs_fs *sfs, void *buf, uint32_t blkno, bool write, bool check) {
     assert((blkno != 0 || !check) && blkno < sfs->super.blocks);
-    struct iobuf __iob, *iob = iobuf_init(&__iob, buf, SFS_BLKSIZE, blkno * SFS_BLKSIZE);
-    return dop_io(sfs->dev, iob, write);
+    if (write) {
+        int ret;
+        size_t thresh = info2fs(sfs, sfs)->fs_wb.dirty_thresh;
+        if ((ret = bcache_write(sfs->dev, buf, blkno)) == 0
+            && bcache_dirty_count(NULL) > thresh && bcache_dirty_count(sfs->dev) > thresh) {
+            fs_writeback_wakeup();
+        }
+        return ret;
+    }
+    return bcache_read(sfs->dev, buf, blkno);
 }
 
 /* sfs_rwblock - Basic block-level I/O routine for Rd/Wr N disk blocks ,
@@ -30,18 +45,21 @@ sfs_rwblock_nolock(struct sfs_fs *sfs, void *buf, uint32_t blkno, bool write, bo
  * @blkno: the NO. of disk block
  * @nblks: Rd/Wr number of disk block
  * @write: BOOL: Read - 0 or Write - 1
+ *
+ * A single block goes through the buffer cache; a run of blocks is moved with
+ * one device request by bcache_rwblocks, which keeps cached copies coherent.
  */
 static int
 sfs_rwblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks, bool write) {
     int ret = 0;
     lock_sfs_io(sfs);
     {
-        while (nblks != 0) {
-            if ((ret = sfs_rwblock_nolock(sfs, buf, blkno, write, 1)) != 0) {
-                break;
-            }
-            blkno ++, nblks --;
-            buf += SFS_BLKSIZE;
+        if (nblks == 1) {
+            ret = sfs_rwblock_nolock(sfs, buf, blkno, write, 1);
+        }
+        else if (nblks != 0) {
+            assert(blkno != 0 && blkno + nblks <= sfs->super.blocks);
+            ret = bcache_rwblocks(sfs->dev, buf, blkno, nblks, write);
         }
     }
     unlock_sfs_io(sfs);
@@ -72,6 +90,30 @@ sfs_wblock(struct sfs_fs *sfs, void *buf, uint32_t blkno, uint32_t nblks) {
     return sfs_rwblock(sfs, buf, blkno, nblks, 1);
 }
 
+/* sfs_rablock - Prefetch N disk blocks into the buffer cache (read-ahead),
+ *               with lock protect for mutex process on Rd/Wr disk block
+ * @sfs:   sfs_fs which will be process
+ * @blkno: the NO. of disk block
+ * @nblks: number of disk blocks to prefetch
+ */
+int
+sfs_rablock(struct sfs_fs *sfs, uint32_t blkno, uint32_t nblks) {
+    int ret;
+    assert(blkno != 0 && blkno + nblks <= sfs->super.blocks);
+    lock_sfs_io(sfs);
+    {
+        ret = bcache_prefetch(sfs->dev, blkno, nblks);
+    }
+    unlock_sfs_io(sfs);
+    return ret;
+}
+
+/* sfs_block_cached - test if disk block blkno is in the buffer cache */
+bool
+sfs_block_cached(struct sfs_fs *sfs, uint32_t blkno) {
+    return bcache_cached(sfs->dev, blkno);
+}
+
 /* sfs_rbuf - The Basic block-level I/O routine for  Rd( non-block & non-aligned io) one disk block(using sfs->sfs_buffer)
  *            with lock protect for mutex process on Rd/Wr disk block
  * @sfs:    sfs_fs which will be process
@@ -9,6 +9,7 @@
 void
 swapfs_init(void) {
     static_assert((PGSIZE % SECTSIZE) == 0);
+    static_assert(SWAPFS_MAX_CLUSTER <= MAX_NVECS && SWAPFS_MAX_CLUSTER * PAGE_NSECT <= MAX_NSECS);
     if (!ide_device_valid(SWAP_DEV_NO)) {
         panic("swap fs isn't available.\n");
     }
@@ -25,3 +26,30 @@ swapfs_write(swap_entry_t entry, struct Page *page) {
     return ide_write_secs(SWAP_DEV_NO, swap_offset(entry) * PAGE_NSECT, page2kva(page), PAGE_NSECT);
 }
 
+/* *
+ * swapfs_rw_cluster - move the n pages in the swap slots from the one of
+ * entry on, in a single disk command.
+ * */
+static int
+swapfs_rw_cluster(swap_entry_t entry, struct Page **pages, size_t n, bool write) {
+    assert(n <= SWAPFS_MAX_CLUSTER && swap_offset(entry) + n <= max_swap_offset);
+    void *bufs[SWAPFS_MAX_CLUSTER];
+    size_t i;
+    for (i = 0; i < n; i ++) {
+        bufs[i] = page2kva(pages[i]);
+    }
+    uint32_t secno = swap_offset(entry) * PAGE_NSECT;
+    return write ? ide_write_vecs(SWAP_DEV_NO, secno, bufs, n, PAGE_NSECT)
+                 : ide_read_vecs(SWAP_DEV_NO, secno, bufs, n, PAGE_NSECT);
+}
+
+int
+swapfs_read_cluster(swap_entry_t entry, struct Page **pages, size_t n) {
+    return swapfs_rw_cluster(entry, pages, n, 0);
+}
+
+int
+swapfs_write_cluster(swap_entry_t entry, struct Page **pages, size_t n) {
+    return swapfs_rw_cluster(entry, pages, n, 1);
+}
+
@@ -4,9 +4,14 @@
 #include <memlayout.h>
 #include <swap.h>
 
+/* max # of pages moved by one swapfs_read_cluster/swapfs_write_cluster */
+#define SWAPFS_MAX_CLUSTER          16
+
 void swapfs_init(void);
 int swapfs_read(swap_entry_t entry, struct Page *page);
 int swapfs_write(swap_entry_t entry, struct Page *page);
+int swapfs_read_cluster(swap_entry_t entry, struct Page **pages, size_t n);
+int swapfs_write_cluster(swap_entry_t entry, struct Page **pages, size_t n);
 
 #endif /* !__KERN_FS_SWAP_SWAPFS_H__ */
 
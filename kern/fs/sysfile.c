@@ -3,18 +3,18 @@
 #include <vmm.h>
 #include <proc.h>
 #include <kmalloc.h>
+#include <pmm.h>
 #include <vfs.h>
 #include <file.h>
 #include <iobuf.h>
 #include <sysfile.h>
 #include <stat.h>
 #include <dirent.h>
+#include <uio.h>
 #include <unistd.h>
 #include <error.h>
 #include <assert.h>
 
-#define IOBUF_SIZE                          4096
-
 /* copy_path - copy path name */
 static int
 copy_path(char **to, const char *from) {
@@ -56,6 +56,100 @@ sysfile_close(int fd) {
     return file_close(fd);
 }
 
+/* *
+ * read and write use the user's buffer in place: sysfile_rw pins its pages
+ * with get_user_pages, SYSFILE_NR_PAGES at a time, and hands the file layer
+ * their kernel addresses, a run of physically adjacent pages at a time. So
+ * the data moves between the user's pages and the disk or the block cache
+ * with one copy (none for whole blocks) and no bounce buffer. A kernel
+ * thread, which has no mm, passes a kernel buffer.
+ *
+ * A write of at most PIPE_BUF bytes is copied to the kernel stack instead,
+ * so that it reaches the file layer in one call even if it crosses a page
+ * boundary: a pipe does not split such a write. A short transfer (end of
+ * file, or a pipe with less data than asked for) ends the call.
+ * */
+#define SYSFILE_NR_PAGES                    16
+
+// sysfile_move - one call to the file layer, at the file position, or at *posp which moves on
+static int
+sysfile_move(int fd, void *base, size_t len, off_t *posp, bool write, size_t *copied_store) {
+    int ret;
+    if (posp == NULL) {
+        return (write) ? file_write(fd, base, len, copied_store) : file_read(fd, base, len, copied_store);
+    }
+    if (write) {
+        ret = file_pwrite(fd, base, len, *posp, copied_store);
+    }
+    else {
+        ret = file_pread(fd, base, len, *posp, copied_store);
+    }
+    *posp += *copied_store;
+    return ret;
+}
+
+static int
+sysfile_rw(int fd, void *base, size_t len, off_t *posp, bool write) {
+    struct mm_struct *mm = current->mm;
+    struct Page *pages[SYSFILE_NR_PAGES];
+    int ret = 0, nr, i, j;
+    size_t copied = 0, alen = 0, off, n = 0;
+
+    if (mm != NULL && write && len <= PIPE_BUF) {
+        char buffer[PIPE_BUF];
+        bool ok;
+        lock_mm(mm);
+        {
+            ok = copy_from_user(mm, buffer, base, len, 0);
+        }
+        unlock_mm(mm);
+        if (!ok) {
+            return -E_INVAL;
+        }
+        ret = sysfile_move(fd, buffer, len, posp, write, &alen);
+        return (alen != 0) ? alen : ret;
+    }
+
+    while (len != 0 && ret == 0 && alen == n) {
+        if (mm == NULL) {
+            n = len;
+            ret = sysfile_move(fd, base, len, posp, write, &alen);
+            base += alen, len -= alen, copied += alen;
+            continue;
+        }
+        lock_mm(mm);
+        {
+            nr = get_user_pages(mm, (uintptr_t)base, len, !write, pages, SYSFILE_NR_PAGES);
+        }
+        unlock_mm(mm);
+        if (nr < 0) {
+            ret = nr;
+            break;
+        }
+        off = (uintptr_t)base % PGSIZE;
+        for (i = 0; i < nr && ret == 0; i = j, off = 0) {
+            for (j = i + 1; j < nr && pages[j] == pages[j - 1] + 1; j ++)
+                /* nothing */ ;
+            if ((n = (j - i) * PGSIZE - off) > len) {
+                n = len;
+            }
+            ret = sysfile_move(fd, page2kva(pages[i]) + off, n, posp, write, &alen);
+            assert(len >= alen);
+            base += alen, len -= alen, copied += alen;
+            if (alen != n) {
+                break;
+            }
+        }
+        for (i = 0; i < nr; i ++) {
+            put_page(pages[i]);
+        }
+    }
+    if (copied != 0) {
+        return copied;
+    }
+    return ret;
+}
+
 /* sysfile_read - read file */
 /**
  * @brief 系统调用接口
@@ -67,97 +161,106 @@ sysfile_close(int fd) {
  */
 int
 sysfile_read(int fd, void *base, size_t len) {
-    struct mm_struct *mm = current->mm;
     if (len == 0) {
         return 0;
     }
     if (!file_testfd(fd, 1, 0)) { /* 读写权限检查 */
         return -E_INVAL;
     }
-    void *buffer;
-    if ((buffer = kmalloc(IOBUF_SIZE)) == NULL) {
-        return -E_NO_MEM;
-    }
+    return sysfile_rw(fd, base, len, NULL, 0);
+}
 
-    int ret = 0;
-    size_t copied = 0, alen;
-    while (len != 0) {
-        if ((alen = IOBUF_SIZE) > len) {
-            alen = len;
-        }
-        ret = file_read(fd, buffer, alen, &alen);
-        if (alen != 0) {
-            lock_mm(mm);
-            {
-                if (copy_to_user(mm, base, buffer, alen)) {
-                    assert(len >= alen);
-                    base += alen, len -= alen, copied += alen;
-                }
-                else if (ret == 0) {
-                    ret = -E_INVAL;
-                }
-            }
-            unlock_mm(mm);
-        }
-        if (ret != 0 || alen == 0) {
-            goto out;
-        }
+/* sysfile_write - write file */
+int
+sysfile_write(int fd, void *base, size_t len) {
+    if (len == 0) {
+        return 0;
     }
+    if (!file_testfd(fd, 0, 1)) {
+        return -E_INVAL;
+    }
+    return sysfile_rw(fd, base, len, NULL, 1);
+}
 
-out:
-    kfree(buffer);
-    if (copied != 0) {
-        return copied;
+/* sysfile_pread - read file at offset, the file position stays */
+int
+sysfile_pread(int fd, void *base, size_t len, off_t offset) {
+    if (len == 0) {
+        return 0;
     }
-    return ret;
+    if (offset < 0 || !file_testfd(fd, 1, 0)) {
+        return -E_INVAL;
+    }
+    return sysfile_rw(fd, base, len, &offset, 0);
 }
 
-/* sysfile_write - write file */
+/* sysfile_pwrite - write file at offset, the file position stays */
 int
-sysfile_write(int fd, void *base, size_t len) {
-    struct mm_struct *mm = current->mm;
+sysfile_pwrite(int fd, void *base, size_t len, off_t offset) {
     if (len == 0) {
         return 0;
     }
-    if (!file_testfd(fd, 0, 1)) {
+    if (offset < 0 || !file_testfd(fd, 0, 1)) {
         return -E_INVAL;
     }
-    void *buffer;
-    if ((buffer = kmalloc(IOBUF_SIZE)) == NULL) {
-        return -E_NO_MEM;
+    return sysfile_rw(fd, base, len, &offset, 1);
+}
+
+/* *
+ * sysfile_rwv - readv/writev: the iovcnt buffers of iov one after the other,
+ * from/to the file position. It stops at the first buffer that is not filled
+ * (or not written) whole, and returns the bytes moved in all.
+ * */
+static int
+sysfile_rwv(int fd, const struct iovec *iov, int iovcnt, bool write) {
+    struct mm_struct *mm = current->mm;
+    struct iovec kiov[UIO_MAXIOV];
+    if (iovcnt <= 0 || iovcnt > UIO_MAXIOV) {
+        return -E_INVAL;
+    }
+    if (!file_testfd(fd, !write, write)) {
+        return -E_INVAL;
+    }
+    bool ok;
+    lock_mm(mm);
+    {
+        ok = copy_from_user(mm, kiov, iov, sizeof(struct iovec) * iovcnt, 0);
+    }
+    unlock_mm(mm);
+    if (!ok) {
+        return -E_INVAL;
     }
 
-    int ret = 0;
-    size_t copied = 0, alen;
-    while (len != 0) {
-        if ((alen = IOBUF_SIZE) > len) {
-            alen = len;
+    int ret = 0, i;
+    size_t copied = 0;
+    for (i = 0; i < iovcnt; i ++) {
+        if (kiov[i].iov_len == 0) {
+            continue;
         }
-        lock_mm(mm);
-        {
-            if (!copy_from_user(mm, buffer, base, alen, 0)) {
-                ret = -E_INVAL;
-            }
+        if ((ret = sysfile_rw(fd, kiov[i].iov_base, kiov[i].iov_len, NULL, write)) < 0) {
+            break;
         }
-        unlock_mm(mm);
-        if (ret == 0) {
-            ret = file_write(fd, buffer, alen, &alen);
-            if (alen != 0) {
-                assert(len >= alen);
-                base += alen, len -= alen, copied += alen;
-            }
-        }
-        if (ret != 0 || alen == 0) {
-            goto out;
+        copied += ret;
+        if (ret != kiov[i].iov_len) {
+            break;
         }
     }
-
-out:
-    kfree(buffer);
     if (copied != 0) {
         return copied;
     }
-    return ret;
+    return (ret < 0) ? ret : 0;
+}
+
+/* sysfile_readv - read file into several buffers */
+int
+sysfile_readv(int fd, const struct iovec *iov, int iovcnt) {
+    return sysfile_rwv(fd, iov, iovcnt, 0);
+}
+
+/* sysfile_writev - write file from several buffers */
+int
+sysfile_writev(int fd, const struct iovec *iov, int iovcnt) {
+    return sysfile_rwv(fd, iov, iovcnt, 1);
 }
 
 /* sysfile_seek - seek file */
@@ -328,9 +431,25 @@ sysfile_dup(int fd1, int fd2) {
     return file_dup(fd1, fd2);
 }
 
+/* sysfile_pipe - make a pipe, its read end and write end go to fd_store[0] and fd_store[1] */
 int
 sysfile_pipe(int *fd_store) {
-    return -E_UNIMP;
+    struct mm_struct *mm = current->mm;
+    int ret, fd[2];
+    if ((ret = file_pipe(fd)) != 0) {
+        return ret;
+    }
+    lock_mm(mm);
+    {
+        if (!copy_to_user(mm, fd_store, fd, sizeof(fd))) {
+            ret = -E_INVAL;
+        }
+    }
+    unlock_mm(mm);
+    if (ret != 0) {
+        file_close(fd[0]), file_close(fd[1]);
+    }
+    return ret;
 }
 
 int
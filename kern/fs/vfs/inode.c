@@ -8,6 +8,19 @@
 #include <assert.h>
 #include <kmalloc.h>
 
+// inode_cachep - the slab cache inodes (and so the sfs_inode/device in them) come from
+static struct kmem_cache *inode_cachep;
+
+/* *
+ * inode_cache_init - create the inode cache, called by vfs_init
+ * */
+void
+inode_cache_init(void) {
+    if ((inode_cachep = kmem_cache_create("inode", sizeof(struct inode), NULL)) == NULL) {
+        panic("cannot create inode cache.\n");
+    }
+}
+
 /* *
  * __alloc_inode - alloc a inode structure and initialize in_type
  * 为inode动态分配内存, 并设定inode的type
@@ -23,7 +36,7 @@
 struct inode *
 __alloc_inode(int type) {
     struct inode *node;
-    if ((node = kmalloc(sizeof(struct inode))) != NULL) {
+    if ((node = kmem_cache_alloc(inode_cachep)) != NULL) {
         node->in_type = type;
     }
     return node;
@@ -71,7 +84,7 @@ void
 inode_kill(struct inode *node) {
     assert(inode_ref_count(node) == 0);
     assert(inode_open_count(node) == 0);
-    kfree(node);
+    kmem_cache_free(inode_cachep, node);
 }
 
 /* *
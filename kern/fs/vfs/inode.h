@@ -4,6 +4,7 @@
 #include <defs.h>
 #include <dev.h>
 #include <sfs.h>
+#include <pipe.h>
 #include <atomic.h>
 #include <assert.h>
 
@@ -39,10 +40,12 @@ struct inode {
     union {
         struct device __device_info;
         struct sfs_inode __sfs_inode_info;
+        struct pipe_inode __pipe_inode_info;
     } in_info;
     enum {
         inode_type_device_info = 0x1234,
         inode_type_sfs_inode_info,
+        inode_type_pipe_inode_info,
     } in_type;
     int ref_count;
     int open_count;
@@ -66,6 +69,7 @@ struct inode {
 #define info2node(info, type)                                       \
     to_struct((info), struct inode, in_info.__##type##_info)
 
+void inode_cache_init(void);
 struct inode *__alloc_inode(int type);
 
 #define alloc_inode(type)                                           __alloc_inode(__in_type(type))
@@ -25,6 +25,7 @@ __alloc_fs(int type) {
     struct fs *fs;
     if ((fs = kmalloc(sizeof(struct fs))) != NULL) {
         fs->fs_type = type;
+        fs->fs_writeback = NULL;
     }
     return fs;
 }
@@ -33,7 +34,9 @@ __alloc_fs(int type) {
 void
 vfs_init(void) {
     sem_init(&bootfs_sem, 1);
+    inode_cache_init();
     vfs_devlist_init();
+    vfs_dcache_init();
 }
 
 // lock_bootfs - lock  for bootfs
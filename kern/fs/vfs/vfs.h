@@ -45,6 +45,17 @@ struct iobuf;   // kernel or userspace I/O buffer (iobuf.h)
  *      fs_unmount    - Attempt unmount of filesystem.
  *      fs_cleanup    - Cleanup of filesystem.???      
  */
+/*
+ * Writeback tunables of a filesystem, used by its fs_writeback, which the
+ * writeback thread (kflushd, see fs.c) calls every second. Times are in ticks.
+ */
+struct fs_wbctl {
+    unsigned int interval;                          // ticks between two periodic writebacks
+    unsigned int expire;                            // inodes/blocks dirty for so long are written back
+    size_t dirty_thresh;                            // write back all dirty blocks beyond this many
+    size_t last;                                    // ticks of the last periodic writeback
+};
+
 struct fs {
     union {
         struct sfs_fs __sfs_info;                   
@@ -56,6 +67,8 @@ struct fs {
     struct inode *(*fs_get_root)(struct fs *fs);   // 返回当前文件系统根目录接口
     int (*fs_unmount)(struct fs *fs);              // 尝试卸载文件系统接口
     void (*fs_cleanup)(struct fs *fs);             // 清除文件系统
+    int (*fs_writeback)(struct fs *fs);            // 按 fs_wb 后台写回脏数据, 可为 NULL
+    struct fs_wbctl fs_wb;                         // 写回参数
 };
 
 #define __fs_type(type)                                             fs_type_##type##_info
@@ -82,6 +95,7 @@ struct fs *__alloc_fs(int type);
 #define fsop_get_root(fs)                   ((fs)->fs_get_root(fs))
 #define fsop_unmount(fs)                    ((fs)->fs_unmount(fs))
 #define fsop_cleanup(fs)                    ((fs)->fs_cleanup(fs))
+#define fsop_writeback(fs)                  ((fs)->fs_writeback(fs))
 
 /*
  * Virtual File System layer functions.
@@ -184,6 +198,18 @@ int vfs_getcwd(struct iobuf *iob);
 int vfs_lookup(char *path, struct inode **node_store);
 int vfs_lookup_parent(char *path, struct inode **node_store, char **endp);
 
+/*
+ * Dentry cache (vfsdcache.c), the names looked up lately in each dir.
+ *
+ *    vfs_dcache_walk       - look up a path from a dir, through the cache.
+ *    vfs_dcache_invalidate - forget a name of a dir, after it is added or removed.
+ *    vfs_dcache_flush      - forget everything, e.g. before an unmount.
+ */
+void vfs_dcache_init(void);
+int vfs_dcache_walk(struct inode *dir, char *path, struct inode **node_store, char **last_store);
+void vfs_dcache_invalidate(struct inode *dir, const char *name);
+void vfs_dcache_flush(void);
+
 /*
  * Misc
  *
@@ -222,6 +248,12 @@ int vfs_lookup_parent(char *path, struct inode **node_store, char **endp);
  *                    specified device.
  *
  *    vfs_unmountall - Unmount all mounted filesystems.
+ *
+ *    vfs_sync       - Write back the dirty state of all mounted
+ *                    filesystems without unmounting them.
+ *
+ *    vfs_writeback  - Let each mounted filesystem write back what its
+ *                    writeback tunables call for (see fs_writeback).
  */
 int vfs_set_bootfs(char *fsname);
 int vfs_get_bootfs(struct inode **node_store);
@@ -232,6 +264,8 @@ int vfs_add_dev(const char *devname, struct inode *devnode, bool mountable);
 int vfs_mount(const char *devname, int (*mountfunc)(struct device *dev, struct fs **fs_store));
 int vfs_unmount(const char *devname);
 int vfs_unmount_all(void);
+int vfs_sync(void);
+int vfs_writeback(void);
 
 #endif /* !__KERN_FS_VFS_VFS_H__ */
 
@@ -0,0 +1,239 @@
+#include <defs.h>
+#include <string.h>
+#include <stdlib.h>
+#include <list.h>
+#include <kmalloc.h>
+#include <vfs.h>
+#include <inode.h>
+#include <error.h>
+#include <assert.h>
+
+/* *
+ * The dentry cache remembers what vop_lookup said about a name in a dir: the
+ * inode of it, or (a negative entry) that there is no such name. vfs_lookup
+ * asks the cache first for every component of a path, so opening the same
+ * paths again does not go down to the filesystem.
+ *
+ * An entry holds a reference to the dir and to the inode it names, so neither
+ * is reclaimed (and reused for something else) while the entry is there. The
+ * cache keeps at most DCACHE_MAX entries and drops the least recently used.
+ * Whatever adds or removes a name in a dir calls vfs_dcache_invalidate for it.
+ *
+ * A lookup may sleep in the filesystem; if the dir changed meanwhile (the
+ * generation moved on) what it found is not put into the cache.
+ * */
+
+#define DCACHE_HLIST_SHIFT                  8
+#define DCACHE_HLIST_SIZE                   (1 << DCACHE_HLIST_SHIFT)
+#define DCACHE_MAX                          256
+
+struct dentry {
+    struct inode *dir;                      // the dir the name is in
+    struct inode *node;                     // the inode of the name, NULL for a negative entry
+    list_entry_t hash_link;                 // entry of the hash list
+    list_entry_t lru_link;                  // entry of the lru list, the most recent at the head
+    char name[0];
+};
+
+#define le2dentry(le, member)               \
+    to_struct((le), struct dentry, member)
+
+static list_entry_t dcache_hash[DCACHE_HLIST_SIZE];
+static list_entry_t dcache_lru;
+static int dcache_count;
+static uint32_t dcache_gen;                 // moves on with every invalidation
+
+static list_entry_t *
+dcache_hash_list(struct inode *dir, const char *name) {
+    uint32_t h = (uint32_t)dir;
+    while (*name != '\0') {
+        h = h * 31 + (unsigned char)(*name ++);
+    }
+    return dcache_hash + hash32(h, DCACHE_HLIST_SHIFT);
+}
+
+static struct dentry *
+dcache_find(struct inode *dir, const char *name) {
+    list_entry_t *list = dcache_hash_list(dir, name), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct dentry *dentry = le2dentry(le, hash_link);
+        if (dentry->dir == dir && strcmp(dentry->name, name) == 0) {
+            return dentry;
+        }
+    }
+    return NULL;
+}
+
+// dcache_del - take dentry out of the cache, the caller drops its references with dcache_free
+static void
+dcache_del(struct dentry *dentry) {
+    list_del(&(dentry->hash_link));
+    list_del(&(dentry->lru_link));
+    dcache_count --;
+}
+
+// dcache_free - may sleep, as the last reference to an inode reclaims it
+static void
+dcache_free(struct dentry *dentry) {
+    if (dentry->node != NULL) {
+        vop_ref_dec(dentry->node);
+    }
+    vop_ref_dec(dentry->dir);
+    kfree(dentry);
+}
+
+void
+vfs_dcache_init(void) {
+    int i;
+    for (i = 0; i < DCACHE_HLIST_SIZE; i ++) {
+        list_init(dcache_hash + i);
+    }
+    list_init(&dcache_lru);
+    dcache_count = 0, dcache_gen = 0;
+}
+
+/* *
+ * dcache_add - remember the lookup of name in dir, node is NULL if there is no
+ * such name. gen is dcache_gen before the lookup; kmalloc may sleep too, so it
+ * is checked again after the allocation.
+ * */
+static void
+dcache_add(struct inode *dir, const char *name, struct inode *node, uint32_t gen) {
+    struct dentry *dentry, *victim = NULL;
+    size_t len = strlen(name);
+    if ((dentry = kmalloc(sizeof(struct dentry) + len + 1)) == NULL) {
+        return;
+    }
+    if (gen != dcache_gen) {
+        kfree(dentry);
+        return;
+    }
+    vop_ref_inc(dir);
+    if (node != NULL) {
+        vop_ref_inc(node);
+    }
+    dentry->dir = dir, dentry->node = node;
+    memcpy(dentry->name, name, len + 1);
+
+    // kmalloc may have slept
+    struct dentry *old;
+    if ((old = dcache_find(dir, name)) != NULL) {
+        dcache_del(old);
+        victim = old;
+    }
+    else if (dcache_count >= DCACHE_MAX) {
+        victim = le2dentry(list_prev(&dcache_lru), lru_link);
+        dcache_del(victim);
+    }
+    list_add(dcache_hash_list(dir, name), &(dentry->hash_link));
+    list_add(&dcache_lru, &(dentry->lru_link));
+    dcache_count ++;
+
+    if (victim != NULL) {
+        dcache_free(victim);
+    }
+}
+
+/* *
+ * dcache_lookup - look up a single name in dir, from the cache if it is there.
+ * Like vop_lookup, it returns a referenced inode in *node_store.
+ * */
+static int
+dcache_lookup(struct inode *dir, char *name, struct inode **node_store) {
+    struct dentry *dentry;
+    if ((dentry = dcache_find(dir, name)) != NULL) {
+        list_del(&(dentry->lru_link));
+        list_add(&dcache_lru, &(dentry->lru_link));
+        if (dentry->node == NULL) {
+            return -E_NOENT;
+        }
+        vop_ref_inc(dentry->node);
+        *node_store = dentry->node;
+        return 0;
+    }
+
+    int ret;
+    uint32_t gen = dcache_gen;
+    ret = vop_lookup(dir, name, node_store);
+    if (ret == 0) {
+        dcache_add(dir, name, *node_store, gen);
+    }
+    else if (ret == -E_NOENT) {
+        dcache_add(dir, name, NULL, gen);
+    }
+    return ret;
+}
+
+/* *
+ * vfs_dcache_walk - look up the path from dir one component at a time. If
+ * last_store is not NULL, the last component is left for the caller: the
+ * dir it is in comes back in *node_store, and the component in *last_store.
+ * The reference to dir is given up either way.
+ * */
+int
+vfs_dcache_walk(struct inode *dir, char *path, struct inode **node_store, char **last_store) {
+    char name[FS_MAX_FNAME_LEN + 1];
+    struct inode *node;
+    int ret;
+    while (1) {
+        while (*path == '/') {
+            path ++;
+        }
+        char *end = path;
+        while (*end != '\0' && *end != '/') {
+            end ++;
+        }
+        char *next = end;
+        while (*next == '/') {
+            next ++;
+        }
+        if (last_store != NULL && *next == '\0') {
+            // the last component, with the slashes after it cut off
+            *end = '\0';
+            break;
+        }
+        if (end == path) {
+            break;
+        }
+        if (end - path > FS_MAX_FNAME_LEN) {
+            vop_ref_dec(dir);
+            return -E_TOO_BIG;
+        }
+        memcpy(name, path, end - path);
+        name[end - path] = '\0';
+        ret = dcache_lookup(dir, name, &node);
+        vop_ref_dec(dir);
+        if (ret != 0) {
+            return ret;
+        }
+        dir = node, path = next;
+    }
+    *node_store = dir;
+    if (last_store != NULL) {
+        *last_store = path;
+    }
+    return 0;
+}
+
+// vfs_dcache_invalidate - a name has been added to or removed from dir (or failed to be)
+void
+vfs_dcache_invalidate(struct inode *dir, const char *name) {
+    struct dentry *dentry;
+    dcache_gen ++;
+    if ((dentry = dcache_find(dir, name)) != NULL) {
+        dcache_del(dentry);
+        dcache_free(dentry);
+    }
+}
+
+// vfs_dcache_flush - empty the cache, e.g. so that a filesystem has no inode in use to unmount
+void
+vfs_dcache_flush(void) {
+    list_entry_t *le;
+    dcache_gen ++;
+    while ((le = list_next(&dcache_lru)) != &dcache_lru) {
+        struct dentry *dentry = le2dentry(le, lru_link);
+        dcache_del(dentry);
+        dcache_free(dentry);
+    }
+}
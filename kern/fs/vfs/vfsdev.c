@@ -55,6 +55,8 @@ vfs_devlist_init(void) {
  */
 void
 vfs_cleanup(void) {
+    // the dentries hold kmalloc'd memory and inode references, let them go first
+    vfs_dcache_flush();
     if (!list_empty(&vdev_list)) {
         lock_vdev_list();
         {
@@ -295,6 +297,9 @@ vfs_unmount(const char *devname) {
     }
     assert(vdev->devname != NULL && vdev->mountable);
 
+    /* dentry缓存中的inode引用会使卸载失败 */
+    vfs_dcache_flush();
+
     /* 将未保存数据写回磁盘 */
     if ((ret = fsop_sync(vdev->fs)) != 0) { 
         goto out;
@@ -318,6 +323,7 @@ out:
 int
 vfs_unmount_all(void) {
     if (!list_empty(&vdev_list)) {
+        vfs_dcache_flush();
         lock_vdev_list();
         {
             list_entry_t *list = &vdev_list, *le = list;
@@ -344,3 +350,56 @@ vfs_unmount_all(void) {
     return 0;
 }
 
+/*
+ * vfs_sync - 将所有已挂载文件系统的脏数据(超级块、freemap、inode、缓冲块)立即写回设备,
+ *            不必等 kflushd
+ */
+int
+vfs_sync(void) {
+    int ret = 0;
+    if (!list_empty(&vdev_list)) {
+        lock_vdev_list();
+        {
+            list_entry_t *list = &vdev_list, *le = list;
+            while ((le = list_next(le)) != list) {
+                vfs_dev_t *vdev = le2vdev(le, vdev_link);
+                if (vdev->mountable && vdev->fs != NULL) {
+                    int err;
+                    if ((err = fsop_sync(vdev->fs)) != 0) {
+                        cprintf("vfs: warning: sync failed for %s: %e.\n", vdev->devname, err);
+                        ret = err;
+                    }
+                }
+            }
+        }
+        unlock_vdev_list();
+    }
+    return ret;
+}
+
+/*
+ * vfs_writeback - 由写回线程 kflushd 周期调用, 各文件系统按自己的 fs_wb 参数写回
+ */
+int
+vfs_writeback(void) {
+    int ret = 0;
+    if (!list_empty(&vdev_list)) {
+        lock_vdev_list();
+        {
+            list_entry_t *list = &vdev_list, *le = list;
+            while ((le = list_next(le)) != list) {
+                vfs_dev_t *vdev = le2vdev(le, vdev_link);
+                if (vdev->mountable && vdev->fs != NULL && vdev->fs->fs_writeback != NULL) {
+                    int err;
+                    if ((err = fsop_writeback(vdev->fs)) != 0) {
+                        cprintf("vfs: warning: writeback failed for %s: %e.\n", vdev->devname, err);
+                        ret = err;
+                    }
+                }
+            }
+        }
+        unlock_vdev_list();
+    }
+    return ret;
+}
+
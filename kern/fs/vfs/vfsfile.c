@@ -51,6 +51,11 @@ int vfs_open(char *path, uint32_t open_flags, struct inode **node_store)
             }
             /* 下层创建文件 */
             ret = vop_create(dir, name, excl, &node);
+            vfs_dcache_invalidate(dir, name);
+            vop_ref_dec(dir);
+            if (ret != 0) {
+                return ret;
+            }
         } else return ret;
     } else if (excl && create) {
         /* 设置excl并以创建模式打开并且文件存在返回错误 */
@@ -93,6 +98,7 @@ int vfs_unlink(char *path) {
         return ret;
     }
     ret = vop_unlink(dir, name);
+    vfs_dcache_invalidate(dir, name);
     vop_ref_dec(dir);
     return ret;
 }
@@ -115,6 +121,7 @@ int vfs_link(char *old_path, char *new_path) {
         return ret;
     }
     ret = vop_link(dir, name, node);
+    vfs_dcache_invalidate(dir, name);
     vop_ref_dec(dir);
     vop_ref_dec(node);
     return ret;
@@ -140,6 +147,7 @@ int vfs_mkdir(char *path)
         return ret;
     }
     ret = vop_mkdir(dir, name);
+    vfs_dcache_invalidate(dir, name);
     vop_ref_dec(dir);
     return ret;
 }
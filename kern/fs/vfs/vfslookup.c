@@ -90,18 +90,12 @@ vfs_lookup(char *path, struct inode **node_store) {
     if ((ret = get_device(path, &path, &node)) != 0) {
         return ret;
     }
-    if (*path != '\0') {
-        /* 根据根目录inode找子目录的inode */
-        ret = vop_lookup(node, path, node_store);
-        vop_ref_dec(node);
-        return ret;
-    }
-    *node_store = node;
-    return 0;
+    /* 根据根目录inode逐级找子目录的inode, 先查dentry缓存 */
+    return vfs_dcache_walk(node, path, node_store, NULL);
 }
 
 /* 
- * 获得设备/文件系统/相对路径根目录对应inode ,以及相对根目录的路径 
+ * 获得路径最后一项所在目录对应inode, 以及最后一项的名字
  * 下层调用了get_device
  */
 int
@@ -111,7 +105,5 @@ vfs_lookup_parent(char *path, struct inode **node_store, char **endp){
     if ((ret = get_device(path, &path, &node)) != 0) {
         return ret;
     }
-    *endp = path;
-    *node_store = node;
-    return 0;
+    return vfs_dcache_walk(node, path, node_store, endp);
 }
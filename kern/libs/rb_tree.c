@@ -0,0 +1,386 @@
+#include <defs.h>
+#include <rb_tree.h>
+#include <kmalloc.h>
+#include <stdio.h>
+#include <assert.h>
+
+/* *
+ * The algorithms follow Chapter 13 "Red-Black Trees" of Introduction to
+ * Algorithms (CLRS), with the sentinel tree->nil standing for every leaf
+ * and for the parent of the root. The sentinel is always black; its parent
+ * pointer may be set by rb_transplant and is read by rb_delete_fixup.
+ * */
+
+#define nil(tree)                   (&((tree)->nil))
+
+void
+rb_tree_init(rb_tree *tree, int (*compare)(rb_node *node1, rb_node *node2)) {
+    tree->compare = compare;
+    tree->nil.red = 0;
+    tree->nil.parent = tree->nil.left = tree->nil.right = nil(tree);
+    tree->root = nil(tree);
+}
+
+static inline void
+rb_left_rotate(rb_tree *tree, rb_node *x) {
+    rb_node *y = x->right;
+    x->right = y->left;
+    if (y->left != nil(tree)) {
+        y->left->parent = x;
+    }
+    y->parent = x->parent;
+    if (x->parent == nil(tree)) {
+        tree->root = y;
+    }
+    else if (x == x->parent->left) {
+        x->parent->left = y;
+    }
+    else {
+        x->parent->right = y;
+    }
+    y->left = x;
+    x->parent = y;
+}
+
+static inline void
+rb_right_rotate(rb_tree *tree, rb_node *x) {
+    rb_node *y = x->left;
+    x->left = y->right;
+    if (y->right != nil(tree)) {
+        y->right->parent = x;
+    }
+    y->parent = x->parent;
+    if (x->parent == nil(tree)) {
+        tree->root = y;
+    }
+    else if (x == x->parent->right) {
+        x->parent->right = y;
+    }
+    else {
+        x->parent->left = y;
+    }
+    y->right = x;
+    x->parent = y;
+}
+
+static void
+rb_insert_fixup(rb_tree *tree, rb_node *z) {
+    while (z->parent->red) {
+        rb_node *gp = z->parent->parent, *y;
+        if (z->parent == gp->left) {
+            if ((y = gp->right)->red) {
+                z->parent->red = y->red = 0, gp->red = 1;
+                z = gp;
+                continue;
+            }
+            if (z == z->parent->right) {
+                z = z->parent;
+                rb_left_rotate(tree, z);
+            }
+            z->parent->red = 0, z->parent->parent->red = 1;
+            rb_right_rotate(tree, z->parent->parent);
+        }
+        else {
+            if ((y = gp->left)->red) {
+                z->parent->red = y->red = 0, gp->red = 1;
+                z = gp;
+                continue;
+            }
+            if (z == z->parent->left) {
+                z = z->parent;
+                rb_right_rotate(tree, z);
+            }
+            z->parent->red = 0, z->parent->parent->red = 1;
+            rb_left_rotate(tree, z->parent->parent);
+        }
+    }
+    tree->root->red = 0;
+}
+
+void
+rb_insert(rb_tree *tree, rb_node *node) {
+    rb_node *y = nil(tree), *x = tree->root;
+    while (x != nil(tree)) {
+        y = x;
+        x = (tree->compare(node, x) < 0) ? x->left : x->right;
+    }
+    node->parent = y;
+    if (y == nil(tree)) {
+        tree->root = node;
+    }
+    else if (tree->compare(node, y) < 0) {
+        y->left = node;
+    }
+    else {
+        y->right = node;
+    }
+    node->left = node->right = nil(tree);
+    node->red = 1;
+    rb_insert_fixup(tree, node);
+}
+
+static inline rb_node *
+rb_minimum(rb_tree *tree, rb_node *x) {
+    while (x->left != nil(tree)) {
+        x = x->left;
+    }
+    return x;
+}
+
+static inline rb_node *
+rb_maximum(rb_tree *tree, rb_node *x) {
+    while (x->right != nil(tree)) {
+        x = x->right;
+    }
+    return x;
+}
+
+// rb_transplant - put the subtree v where the subtree u was
+static inline void
+rb_transplant(rb_tree *tree, rb_node *u, rb_node *v) {
+    if (u->parent == nil(tree)) {
+        tree->root = v;
+    }
+    else if (u == u->parent->left) {
+        u->parent->left = v;
+    }
+    else {
+        u->parent->right = v;
+    }
+    v->parent = u->parent;
+}
+
+static void
+rb_delete_fixup(rb_tree *tree, rb_node *x) {
+    while (x != tree->root && !x->red) {
+        rb_node *w;
+        if (x == x->parent->left) {
+            if ((w = x->parent->right)->red) {
+                w->red = 0, x->parent->red = 1;
+                rb_left_rotate(tree, x->parent);
+                w = x->parent->right;
+            }
+            if (!w->left->red && !w->right->red) {
+                w->red = 1;
+                x = x->parent;
+                continue;
+            }
+            if (!w->right->red) {
+                w->left->red = 0, w->red = 1;
+                rb_right_rotate(tree, w);
+                w = x->parent->right;
+            }
+            w->red = x->parent->red;
+            x->parent->red = w->right->red = 0;
+            rb_left_rotate(tree, x->parent);
+        }
+        else {
+            if ((w = x->parent->left)->red) {
+                w->red = 0, x->parent->red = 1;
+                rb_right_rotate(tree, x->parent);
+                w = x->parent->left;
+            }
+            if (!w->left->red && !w->right->red) {
+                w->red = 1;
+                x = x->parent;
+                continue;
+            }
+            if (!w->left->red) {
+                w->right->red = 0, w->red = 1;
+                rb_left_rotate(tree, w);
+                w = x->parent->left;
+            }
+            w->red = x->parent->red;
+            x->parent->red = w->left->red = 0;
+            rb_right_rotate(tree, x->parent);
+        }
+        x = tree->root;
+    }
+    x->red = 0;
+}
+
+void
+rb_delete(rb_tree *tree, rb_node *z) {
+    rb_node *x, *y = z;
+    bool y_red = y->red;
+    if (z->left == nil(tree)) {
+        x = z->right;
+        rb_transplant(tree, z, z->right);
+    }
+    else if (z->right == nil(tree)) {
+        x = z->left;
+        rb_transplant(tree, z, z->left);
+    }
+    else {
+        y = rb_minimum(tree, z->right);
+        y_red = y->red;
+        x = y->right;
+        if (y->parent == z) {
+            x->parent = y;
+        }
+        else {
+            rb_transplant(tree, y, y->right);
+            y->right = z->right;
+            y->right->parent = y;
+        }
+        rb_transplant(tree, z, y);
+        y->left = z->left;
+        y->left->parent = y;
+        y->red = z->red;
+    }
+    if (!y_red) {
+        rb_delete_fixup(tree, x);
+    }
+    nil(tree)->parent = nil(tree);
+}
+
+/* *
+ * rb_search - find a node that compare(node, key) returns 0 for, compare
+ * returns < 0 if key sorts before node and > 0 if it sorts after.
+ * */
+rb_node *
+rb_search(rb_tree *tree, int (*compare)(rb_node *node, void *key), void *key) {
+    rb_node *x = tree->root;
+    while (x != nil(tree)) {
+        int r = compare(x, key);
+        if (r == 0) {
+            return x;
+        }
+        x = (r < 0) ? x->left : x->right;
+    }
+    return NULL;
+}
+
+// rb_node_prev - the node before node in order, NULL if it is the first
+rb_node *
+rb_node_prev(rb_tree *tree, rb_node *x) {
+    if (x->left != nil(tree)) {
+        return rb_maximum(tree, x->left);
+    }
+    rb_node *y = x->parent;
+    while (y != nil(tree) && x == y->left) {
+        x = y, y = y->parent;
+    }
+    return (y != nil(tree)) ? y : NULL;
+}
+
+// rb_node_next - the node after node in order, NULL if it is the last
+rb_node *
+rb_node_next(rb_tree *tree, rb_node *x) {
+    if (x->right != nil(tree)) {
+        return rb_minimum(tree, x->right);
+    }
+    rb_node *y = x->parent;
+    while (y != nil(tree) && x == y->right) {
+        x = y, y = y->parent;
+    }
+    return (y != nil(tree)) ? y : NULL;
+}
+
+// rb_node_left - the first node in order, NULL if the tree is empty
+rb_node *
+rb_node_left(rb_tree *tree) {
+    return rb_tree_empty(tree) ? NULL : rb_minimum(tree, tree->root);
+}
+
+// rb_node_right - the last node in order, NULL if the tree is empty
+rb_node *
+rb_node_right(rb_tree *tree) {
+    return rb_tree_empty(tree) ? NULL : rb_maximum(tree, tree->root);
+}
+
+/* ----------------------------------------------------------------------- */
+
+struct check_data {
+    int key;
+    rb_node rb_link;
+};
+
+#define rbn2data(node)              rbn2struct(node, struct check_data, rb_link)
+
+static int
+check_compare1(rb_node *node1, rb_node *node2) {
+    return rbn2data(node1)->key - rbn2data(node2)->key;
+}
+
+static int
+check_compare2(rb_node *node, void *key) {
+    return (int)(long)key - rbn2data(node)->key;
+}
+
+// check_subtree - verify the red-black properties below x, return its black height
+static int
+check_subtree(rb_tree *tree, rb_node *x) {
+    if (x == nil(tree)) {
+        assert(!x->red);
+        return 1;
+    }
+    if (x->left != nil(tree)) {
+        assert(x->left->parent == x && tree->compare(x->left, x) <= 0);
+    }
+    if (x->right != nil(tree)) {
+        assert(x->right->parent == x && tree->compare(x, x->right) <= 0);
+    }
+    if (x->red) {
+        assert(!x->left->red && !x->right->red);
+    }
+    int hl = check_subtree(tree, x->left), hr = check_subtree(tree, x->right);
+    assert(hl == hr);
+    return hl + (x->red ? 0 : 1);
+}
+
+static void
+check_tree(rb_tree *tree, int n) {
+    assert(!tree->root->red && tree->root->parent == nil(tree));
+    check_subtree(tree, tree->root);
+    int i = 0;
+    rb_node *node = rb_node_left(tree), *prev = NULL;
+    for (; node != NULL; prev = node, node = rb_node_next(tree, node), i ++) {
+        assert(rb_node_prev(tree, node) == prev);
+        if (prev != NULL) {
+            assert(tree->compare(prev, node) <= 0);
+        }
+    }
+    assert(i == n && rb_node_right(tree) == prev);
+}
+
+void
+check_rb_tree(void) {
+    int i, n = 300;
+    struct check_data *all = kmalloc(sizeof(struct check_data) * n);
+    assert(all != NULL);
+
+    rb_tree __tree, *tree = &__tree;
+    rb_tree_init(tree, check_compare1);
+    assert(rb_tree_empty(tree) && rb_node_left(tree) == NULL);
+
+    // keys in a scrambled order, some of them equal
+    for (i = 0; i < n; i ++) {
+        all[i].key = (i * 37) % 251;
+        rb_insert(tree, &(all[i].rb_link));
+    }
+    check_tree(tree, n);
+
+    for (i = 0; i < n; i ++) {
+        rb_node *node = rb_search(tree, check_compare2, (void *)(long)all[i].key);
+        assert(node != NULL && rbn2data(node)->key == all[i].key);
+    }
+    assert(rb_search(tree, check_compare2, (void *)(long)251) == NULL);
+
+    // delete every other one, then the rest
+    for (i = 0; i < n; i += 2) {
+        rb_delete(tree, &(all[i].rb_link));
+    }
+    check_tree(tree, n / 2);
+    for (i = 1; i < n; i += 2) {
+        rb_delete(tree, &(all[i].rb_link));
+        if (i % 50 == 1) {
+            check_tree(tree, n / 2 - (i + 1) / 2);
+        }
+    }
+    assert(rb_tree_empty(tree));
+
+    kfree(all);
+    cprintf("check_rb_tree() succeeded!\n");
+}
+
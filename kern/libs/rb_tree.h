@@ -0,0 +1,48 @@
+#ifndef __KERN_LIBS_RB_TREE_H__
+#define __KERN_LIBS_RB_TREE_H__
+
+#include <defs.h>
+
+/* *
+ * Intrusive red-black tree: an rb_node is embedded in the struct to be
+ * indexed (like list_entry_t), and the tree orders the nodes with the
+ * compare function given to rb_tree_init. Insert, delete and search are
+ * O(log n). Equal nodes are allowed, a new one goes after the old ones.
+ *
+ * A tree uses its own nil node as the sentinel leaf, so an rb_tree must
+ * not be copied once initialized.
+ * */
+
+typedef struct rb_node {
+    bool red;                                   // color: red or black
+    struct rb_node *parent, *left, *right;
+} rb_node;
+
+typedef struct rb_tree {
+    // < 0 if node1 sorts before node2, 0 if they are equal, > 0 otherwise
+    int (*compare)(rb_node *node1, rb_node *node2);
+    rb_node *root;
+    rb_node nil;                                // the sentinel
+} rb_tree;
+
+#define rbn2struct(node, type, member)          \
+    to_struct((node), type, member)
+
+void rb_tree_init(rb_tree *tree, int (*compare)(rb_node *node1, rb_node *node2));
+void rb_insert(rb_tree *tree, rb_node *node);
+void rb_delete(rb_tree *tree, rb_node *node);
+rb_node *rb_search(rb_tree *tree, int (*compare)(rb_node *node, void *key), void *key);
+rb_node *rb_node_prev(rb_tree *tree, rb_node *node);
+rb_node *rb_node_next(rb_tree *tree, rb_node *node);
+rb_node *rb_node_left(rb_tree *tree);
+rb_node *rb_node_right(rb_tree *tree);
+
+static inline bool
+rb_tree_empty(rb_tree *tree) {
+    return tree->root == &(tree->nil);
+}
+
+void check_rb_tree(void);
+
+#endif /* !__KERN_LIBS_RB_TREE_H__ */
+
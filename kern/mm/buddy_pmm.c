@@ -0,0 +1,224 @@
+#include <pmm.h>
+#include <list.h>
+#include <string.h>
+#include <stdio.h>
+#include <buddy_pmm.h>
+
+/*  In the Buddy System, free memory is kept in blocks of 2^order pages, one
+ * free list per order. A block of order k starting at page index i (counted
+ * from the base of its zone) is always aligned, i % 2^k == 0, and its buddy is
+ * the block at i ^ 2^k. An allocation of n pages takes a block from the
+ * smallest non-empty list of order >= ceil(log2(n)), halving it until it fits;
+ * when a block is freed it is merged with its buddy for as long as the buddy is
+ * free and of the same order. Both walk at most BUDDY_MAX_ORDER levels.
+ *
+ *  Each range given to init_memmap is a zone; page->zone_num records it, so
+ * that buddies are computed relative to the zone base and never cross zones.
+ * A free block is marked on its head page only: PG_property is set and
+ * page->property is the order of the block.
+ *
+ *  Requests that are not a power of two are served from the next order up and
+ * the unused tail is given back at once, so callers may free exactly the n
+ * pages they asked for, or any part of them.
+ */
+
+#define BUDDY_MAX_ZONE              E820MAX
+
+static free_area_t buddy_area[BUDDY_MAX_ORDER + 1];
+
+#define buddy_list(order)           (buddy_area[order].free_list)
+#define buddy_nr_block(order)       (buddy_area[order].nr_free)
+
+static struct {
+    struct Page *mem_base;          // first page of the zone
+    size_t npage;                   // # of pages in the zone
+} buddy_zones[BUDDY_MAX_ZONE];
+
+static int buddy_nr_zone;
+static size_t buddy_nr_free;
+
+#define zone_base(page)             (buddy_zones[(page)->zone_num].mem_base)
+#define zone_npage(page)            (buddy_zones[(page)->zone_num].npage)
+
+static inline unsigned int
+buddy_getorder(size_t n) {
+    unsigned int order = 0;
+    while ((1 << order) < n) {
+        order ++;
+    }
+    return order;
+}
+
+static inline void
+buddy_add_block(struct Page *page, unsigned int order) {
+    page->property = order;
+    SetPageProperty(page);
+    list_add(&buddy_list(order), &(page->page_link));
+    buddy_nr_block(order) ++;
+    buddy_nr_free += (1 << order);
+}
+
+static inline void
+buddy_del_block(struct Page *page, unsigned int order) {
+    list_del(&(page->page_link));
+    ClearPageProperty(page);
+    buddy_nr_block(order) --;
+    buddy_nr_free -= (1 << order);
+}
+
+// buddy_free_block - put a block of 2^order pages back, merging it with its buddies
+static void
+buddy_free_block(struct Page *page, unsigned int order) {
+    struct Page *base = zone_base(page);
+    size_t idx = page - base, npage = zone_npage(page);
+    while (order < BUDDY_MAX_ORDER) {
+        size_t buddy_idx = idx ^ (1 << order);
+        if (buddy_idx + (1 << order) > npage) {
+            break;
+        }
+        struct Page *buddy = base + buddy_idx;
+        if (!PageProperty(buddy) || buddy->property != order) {
+            break;
+        }
+        buddy_del_block(buddy, order);
+        idx &= buddy_idx;
+        order ++;
+    }
+    buddy_add_block(base + idx, order);
+}
+
+// buddy_free_range - free n pages at page, cut into the largest aligned blocks
+static void
+buddy_free_range(struct Page *page, size_t n) {
+    size_t idx = page - zone_base(page);
+    while (n > 0) {
+        unsigned int order = BUDDY_MAX_ORDER;
+        while ((idx & ((1 << order) - 1)) != 0 || (1 << order) > n) {
+            order --;
+        }
+        buddy_free_block(page, order);
+        page += (1 << order), idx += (1 << order), n -= (1 << order);
+    }
+}
+
+static void
+buddy_init(void) {
+    int i;
+    for (i = 0; i <= BUDDY_MAX_ORDER; i ++) {
+        list_init(&buddy_list(i));
+        buddy_nr_block(i) = 0;
+    }
+    buddy_nr_zone = 0;
+    buddy_nr_free = 0;
+}
+
+static void
+buddy_init_memmap(struct Page *base, size_t n) {
+    assert(n > 0 && buddy_nr_zone < BUDDY_MAX_ZONE);
+    int zone_num = buddy_nr_zone ++;
+    buddy_zones[zone_num].mem_base = base;
+    buddy_zones[zone_num].npage = n;
+    struct Page *p = base;
+    for (; p != base + n; p ++) {
+        assert(PageReserved(p));
+        p->flags = p->property = 0;
+        p->zone_num = zone_num;
+        set_page_ref(p, 0);
+    }
+    buddy_free_range(base, n);
+}
+
+static struct Page *
+buddy_alloc_pages(size_t n) {
+    assert(n > 0);
+    if (n > (1 << BUDDY_MAX_ORDER) || n > buddy_nr_free) {
+        return NULL;
+    }
+    unsigned int order = buddy_getorder(n), cur = order;
+    while (cur <= BUDDY_MAX_ORDER && list_empty(&buddy_list(cur))) {
+        cur ++;
+    }
+    if (cur > BUDDY_MAX_ORDER) {
+        return NULL;
+    }
+    struct Page *page = le2page(list_next(&buddy_list(cur)), page_link);
+    buddy_del_block(page, cur);
+    while (cur > order) {
+        cur --;
+        buddy_add_block(page + (1 << cur), cur);
+    }
+    if (n < (1 << order)) {
+        buddy_free_range(page + n, (1 << order) - n);
+    }
+    return page;
+}
+
+static void
+buddy_free_pages(struct Page *base, size_t n) {
+    assert(n > 0);
+    struct Page *p = base;
+    for (; p != base + n; p ++) {
+        assert(!PageReserved(p) && !PageProperty(p));
+        assert(p->zone_num == base->zone_num);
+        p->flags = 0;
+        set_page_ref(p, 0);
+    }
+    buddy_free_range(base, n);
+}
+
+static size_t
+buddy_nr_free_pages(void) {
+    return buddy_nr_free;
+}
+
+static void
+buddy_check(void) {
+    size_t nr_free_store = buddy_nr_free;
+    struct Page *p0, *p1, *p2;
+
+    // every block comes aligned to its own size within the zone
+    unsigned int order;
+    for (order = 0; order <= BUDDY_MAX_ORDER; order ++) {
+        if ((p0 = buddy_alloc_pages(1 << order)) != NULL) {
+            assert(((p0 - zone_base(p0)) & ((1 << order) - 1)) == 0);
+            assert(!PageProperty(p0) && buddy_nr_free == nr_free_store - (1 << order));
+            buddy_free_pages(p0, 1 << order);
+        }
+        assert(buddy_nr_free == nr_free_store);
+    }
+
+    // buddies that are freed one by one merge back into their parent
+    assert((p0 = buddy_alloc_pages(2)) != NULL);
+    buddy_free_pages(p0 + 1, 1);
+    assert(PageProperty(p0 + 1) && (p0 + 1)->property == 0);
+    assert((p1 = buddy_alloc_pages(1)) == p0 + 1);
+    assert((p2 = buddy_alloc_pages(1)) != NULL && p2 != p0);
+    buddy_free_pages(p0, 1);
+    assert(PageProperty(p0) && p0->property == 0);
+    buddy_free_pages(p1, 1);
+    assert(!PageProperty(p1));
+    buddy_free_pages(p2, 1);
+    assert(buddy_nr_free == nr_free_store);
+
+    // the tail of an odd sized request is not wasted
+    assert((p0 = buddy_alloc_pages(5)) != NULL);
+    assert(buddy_nr_free == nr_free_store - 5);
+    assert(PageProperty(p0 + 5) && (p0 + 5)->property == 0);
+    assert(PageProperty(p0 + 6) && (p0 + 6)->property == 1);
+    buddy_free_pages(p0, 5);
+    assert(buddy_nr_free == nr_free_store);
+
+    assert(buddy_alloc_pages((1 << BUDDY_MAX_ORDER) + 1) == NULL);
+    cprintf("buddy_check() succeeded!\n");
+}
+
+const struct pmm_manager buddy_pmm_manager = {
+    .name = "buddy_pmm_manager",
+    .init = buddy_init,
+    .init_memmap = buddy_init_memmap,
+    .alloc_pages = buddy_alloc_pages,
+    .free_pages = buddy_free_pages,
+    .nr_free_pages = buddy_nr_free_pages,
+    .check = buddy_check,
+};
+
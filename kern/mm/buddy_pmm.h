@@ -0,0 +1,11 @@
+#ifndef __KERN_MM_BUDDY_PMM_H__
+#define  __KERN_MM_BUDDY_PMM_H__
+
+#include <pmm.h>
+
+#define BUDDY_MAX_ORDER             10      // the largest block is 2^BUDDY_MAX_ORDER pages
+
+extern const struct pmm_manager buddy_pmm_manager;
+
+#endif /* ! __KERN_MM_BUDDY_PMM_H__ */
+
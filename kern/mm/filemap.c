@@ -0,0 +1,232 @@
+#include <defs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <list.h>
+#include <error.h>
+#include <assert.h>
+#include <pmm.h>
+#include <vmm.h>
+#include <swap.h>
+#include <iobuf.h>
+#include <inode.h>
+#include <stat.h>
+#include <filemap.h>
+
+/* *
+ * A vma may map a file (vma->vm_file): its pages in [vm_file_start, vm_file_end)
+ * hold the file from offset vm_file_off on, the rest of it reads as zeros. Such
+ * pages are not there until they fault, filemap_fault reads them then.
+ *
+ * A page that holds a whole page of the file at a page aligned offset goes
+ * into the file cache, a hash table of (inode, offset). Another fault on the
+ * same page of the file, from this or any other process, maps the cached page
+ * read-only instead of reading it again, so the text of a program is shared
+ * by all the processes that run it. Writing to a cached page copies it, see
+ * do_pgfault. The cache holds no reference: a page leaves it when it is freed,
+ * and swap_out just drops a cached page, since it can be read again.
+ *
+ * A page that is only partly from the file, or that is written right away,
+ * is private to the process and works like anonymous memory.
+ *
+ * A shared vma (VM_SHARED, see mmap) maps the cached pages writable instead:
+ * every process mapping the file sees the writes, and the pages written
+ * (PTE_D) go back to the file on msync, munmap and exit, or when swap_out
+ * drops them.
+ * */
+
+#define FILEMAP_HLIST_SHIFT                 8
+#define FILEMAP_HLIST_SIZE                  (1 << FILEMAP_HLIST_SHIFT)
+#define filemap_hashfn(node, offset)        \
+    (hash32((uint32_t)(node) + (uint32_t)(offset) / PGSIZE, FILEMAP_HLIST_SHIFT))
+
+static list_entry_t filemap_hash[FILEMAP_HLIST_SIZE];
+
+#define le2page_file(le)                    le2page(le, file_link)
+
+void
+filemap_init(void) {
+    int i;
+    for (i = 0; i < FILEMAP_HLIST_SIZE; i ++) {
+        list_init(filemap_hash + i);
+    }
+}
+
+static struct Page *
+filemap_find(struct inode *node, off_t offset) {
+    list_entry_t *list = filemap_hash + filemap_hashfn(node, offset), *le = list;
+    while ((le = list_next(le)) != list) {
+        struct Page *page = le2page_file(le);
+        if (page->file == node && page->file_off == offset) {
+            return page;
+        }
+    }
+    return NULL;
+}
+
+static void
+filemap_add(struct Page *page, struct inode *node, off_t offset) {
+    assert(!PageFileCache(page) && filemap_find(node, offset) == NULL);
+    page->file = node, page->file_off = offset;
+    list_add(filemap_hash + filemap_hashfn(node, offset), &(page->file_link));
+    SetPageFileCache(page);
+}
+
+// filemap_del - take the page out of the file cache
+void
+filemap_del(struct Page *page) {
+    assert(PageFileCache(page));
+    list_del(&(page->file_link));
+    page->file = NULL;
+    ClearPageFileCache(page);
+}
+
+/* *
+ * filemap_update - the len bytes at base have been written to the file at
+ * offset, copy them to the cached pages of the range too, so that the
+ * mappings of the file see them.
+ * */
+void
+filemap_update(struct inode *node, off_t offset, const void *base, size_t len) {
+    off_t end = offset + len, pos;
+    struct Page *page;
+    for (pos = ROUNDDOWN(offset, PGSIZE); pos < end; pos += PGSIZE) {
+        if ((page = filemap_find(node, pos)) != NULL) {
+            off_t from = (pos > offset) ? pos : offset, to = (pos + PGSIZE < end) ? pos + PGSIZE : end;
+            memcpy(page2kva(page) + (from - pos), base + (from - offset), to - from);
+        }
+    }
+}
+
+// filemap_read - fill page with what the vma maps at la
+static int
+filemap_read(struct vma_struct *vma, uintptr_t la, struct Page *page) {
+    uintptr_t start = (la > vma->vm_file_start) ? la : vma->vm_file_start;
+    uintptr_t end = (la + PGSIZE < vma->vm_file_end) ? la + PGSIZE : vma->vm_file_end;
+    memset(page2kva(page), 0, PGSIZE);
+    if (start < end) {
+        // a short read leaves zeros after the end of file
+        struct iobuf __iob, *iob = iobuf_init(&__iob, page2kva(page) + (start - la), end - start,
+                                              vma->vm_file_off + (start - vma->vm_file_start));
+        return vop_read(vma->vm_file, iob);
+    }
+    return 0;
+}
+
+/* *
+ * filemap_writepage - write a page of the file cache back to the file, not
+ * past the end of the file.
+ * */
+int
+filemap_writepage(struct Page *page) {
+    assert(PageFileCache(page));
+    struct stat __stat, *stat = &__stat;
+    int ret;
+    if ((ret = vop_fstat(page->file, stat)) != 0) {
+        return ret;
+    }
+    if (page->file_off >= stat->st_size) {
+        return 0;
+    }
+    size_t len = stat->st_size - page->file_off;
+    struct iobuf __iob, *iob = iobuf_init(&__iob, page2kva(page), (len < PGSIZE) ? len : PGSIZE, page->file_off);
+    return vop_write(page->file, iob);
+}
+
+/* *
+ * filemap_sync - write the pages of the shared file vma in [start, end) that
+ * have been written through mm back to the file.
+ * */
+int
+filemap_sync(struct mm_struct *mm, struct vma_struct *vma, uintptr_t start, uintptr_t end) {
+    assert(vma->vm_file != NULL && (vma->vm_flags & VM_SHARED));
+    int ret = 0;
+    for (; start < end; start += PGSIZE) {
+        pte_t *ptep = get_pte(mm->pgdir, start, 0);
+        if (ptep == NULL || (*ptep & (PTE_P | PTE_D)) != (PTE_P | PTE_D)) {
+            continue;
+        }
+        // clean before the write, so that a write during it makes the page dirty again
+        *ptep &= ~PTE_D;
+        tlb_invalidate(mm->pgdir, start);
+        if ((ret = filemap_writepage(pte2page(*ptep))) != 0) {
+            *ptep |= PTE_D;
+            break;
+        }
+    }
+    return ret;
+}
+
+/* *
+ * filemap_fault - map the page of the file vma at la, whose pte is empty. A
+ * write fault gets a private page, a read fault the page of the file cache if
+ * there can be one. A shared vma always gets the page of the file cache.
+ * */
+int
+filemap_fault(struct mm_struct *mm, struct vma_struct *vma, uintptr_t la, bool write) {
+    struct inode *node = vma->vm_file;
+    off_t offset = vma->vm_file_off + (off_t)(la - vma->vm_file_start);
+    bool cacheable = (la >= vma->vm_file_start && la + PGSIZE <= vma->vm_file_end && offset % PGSIZE == 0);
+    bool shared = ((vma->vm_flags & VM_SHARED) != 0);
+    uint32_t perm = PTE_U;
+    if (vma->vm_flags & VM_WRITE) {
+        perm |= PTE_W;
+    }
+    if (shared) {
+        // mmap takes care that the page of a shared vma is whole in the file
+        assert(cacheable);
+        write = 0;
+    }
+
+    struct Page *page, *cpage = NULL;
+    int ret;
+    if ((page = alloc_page()) == NULL) {
+        return -E_NO_MEM;
+    }
+    // alloc_page may sleep, look in the cache after it
+    if (cacheable && (cpage = filemap_find(node, offset)) != NULL) {
+        if (write) {
+            memcpy(page2kva(page), page2kva(cpage), PGSIZE);
+            cpage = NULL;
+        }
+    }
+    else if ((ret = filemap_read(vma, la, page)) != 0) {
+        free_page(page);
+        return ret;
+    }
+    else if (cacheable && !write) {
+        // another fault may have read the page while this one slept
+        cpage = filemap_find(node, offset);
+    }
+
+    pte_t *ptep = get_pte(mm->pgdir, la, 0);
+    if (ptep == NULL || *ptep != 0) {
+        // mapped by a fault of another thread meanwhile
+        free_page(page);
+        return 0;
+    }
+    if (cpage != NULL) {
+        free_page(page);
+        page = cpage;
+    }
+    else if (cacheable && !write) {
+        filemap_add(page, node, offset);
+    }
+    if (PageFileCache(page) && !shared) {
+        perm &= ~PTE_W;
+    }
+    if ((ret = page_insert(mm->pgdir, page, la, perm)) != 0) {
+        if (page_ref(page) == 0) {
+            if (PageFileCache(page)) {
+                filemap_del(page);
+            }
+            free_page(page);
+        }
+        return ret;
+    }
+    if (swap_init_ok) {
+        swap_map_swappable(mm, la, page, 0);
+    }
+    return 0;
+}
+
@@ -0,0 +1,19 @@
+#ifndef __KERN_MM_FILEMAP_H__
+#define __KERN_MM_FILEMAP_H__
+
+#include <defs.h>
+#include <memlayout.h>
+
+struct mm_struct;
+struct vma_struct;
+struct inode;
+
+void filemap_init(void);
+int filemap_fault(struct mm_struct *mm, struct vma_struct *vma, uintptr_t la, bool write);
+void filemap_del(struct Page *page);
+int filemap_writepage(struct Page *page);
+int filemap_sync(struct mm_struct *mm, struct vma_struct *vma, uintptr_t start, uintptr_t end);
+void filemap_update(struct inode *node, off_t offset, const void *base, size_t len);
+
+#endif /* !__KERN_MM_FILEMAP_H__ */
+
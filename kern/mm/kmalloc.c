@@ -6,210 +6,585 @@
 #include <sync.h>
 #include <pmm.h>
 #include <stdio.h>
+#include <string.h>
+#include <kdebug.h>
 
 /*
- * SLOB Allocator: Simple List Of Blocks
+ * SLAB Allocator, after Jeff Bonwick's "The Slab Allocator: An
+ * Object-Caching Kernel Memory Allocator" (USENIX Summer 1994).
  *
- * Matt Mackall <mpm@selenic.com> 12/30/03
+ * How SLAB works:
  *
- * How SLOB works:
+ * A kmem_cache hands out objects of a single size. Its memory comes in
+ * slabs of 2^page_order pages, and every slab of a cache sits on one of
+ * three lists: full (no free object), partial, or free (no object in
+ * use). Allocation takes an object from the first partial slab, then
+ * from a free slab, and only grows the cache by a new slab when both
+ * lists are empty; freeing puts the object back on its own slab. Both
+ * are O(1).
  *
- * The core of SLOB is a traditional K&R style heap allocator, with
- * support for returning aligned objects. The granularity of this
- * allocator is 8 bytes on x86, though it's perhaps possible to reduce
- * this to 4 if it's deemed worth the effort. The slob heap is a
- * singly-linked list of pages from __get_free_page, grown on demand
- * and allocation from the heap is currently first-fit.
+ * The slab descriptor and its bufctl array sit at the head of the slab,
+ * the objects follow. bufctl[i] is the index of the free object after
+ * object i, so the free objects of a slab form a chain starting at
+ * slab->free without writing into the objects themselves. Every page
+ * of a slab is marked PG_slab, and its page_link (unused while the page
+ * is allocated) points to the cache and the slab, so an object finds
+ * its slab from kva2page alone.
  *
- * Above this is an implementation of kmalloc/kfree. Blocks returned
- * from kmalloc are 8-byte aligned and prepended with a 8-byte header.
- * If kmalloc is asked for objects of PAGE_SIZE or larger, it calls
- * __get_free_pages directly so that it can return page-aligned blocks
- * and keeps a linked list of such pages and their orders. These
- * objects are detected in kfree() by their page alignment.
+ * An optional constructor runs once on each object when its slab is
+ * created; users are expected to give objects back in constructed state.
  *
- * SLAB is emulated on top of SLOB by simply calling constructors and
- * destructors for every SLAB allocation. Objects are returned with
- * the 8-byte alignment unless the SLAB_MUST_HWCACHE_ALIGN flag is
- * set, in which case the low-level allocator will fragment blocks to
- * create the proper alignment. Again, objects of page-size or greater
- * are allocated by calling __get_free_pages. As SLAB objects know
- * their size, no separate size bookkeeping is necessary and there is
- * essentially no allocation space overhead.
+ * A cache keeps at most KMEM_CACHE_FREE_SLABS free slabs for reuse,
+ * the others are given back to the pmm at once, and kmem_cache_reap
+ * gives back the spare ones of every cache.
+ *
+ * Above this is an implementation of kmalloc/kfree. Requests up to
+ * KMALLOC_MAX_SIZE bytes are served by power-of-two size-class caches
+ * ("size-32" ... "size-2048"). Larger ones call alloc_pages directly,
+ * so they come back page-aligned; these bigblocks are kept on a linked
+ * list with their orders, and kfree tells them apart from slab objects
+ * by the PG_slab flag of their page.
+ *
+ * Every allocation is charged to its call site, the return address of
+ * kmalloc or kmem_cache_alloc, in the kmem_sites table. A slab object
+ * remembers its site in its own bufctl entry, which is unused while the
+ * object is allocated; a bigblock remembers it in its bigblock_t.
+ * kmalloc_print_stat (the "kmem" command of the kernel monitor) dumps
+ * the sites and the caches.
  */
 
 
 //some helper
 #define spin_lock_irqsave(l, f) local_intr_save(f)
 #define spin_unlock_irqrestore(l, f) local_intr_restore(f)
-typedef unsigned int gfp_t;
 #ifndef PAGE_SIZE
 #define PAGE_SIZE PGSIZE
 #endif
 
-#ifndef L1_CACHE_BYTES
-#define L1_CACHE_BYTES 64
-#endif
+#define KMEM_ALIGN                  sizeof(long long)   // alignment of every object
+#define KMEM_SLAB_MAX_ORDER         3                   // a slab is at most 2^3 pages
+#define KMEM_CACHE_FREE_SLABS       1                   // free slabs a cache holds on to
 
-#ifndef ALIGN
-#define ALIGN(addr,size)   (((addr)+(size)-1)&(~((size)-1))) 
-#endif
+#define KMALLOC_MIN_SHIFT           5
+#define KMALLOC_MAX_SHIFT           11
+#define KMALLOC_MAX_SIZE            (1 << KMALLOC_MAX_SHIFT)
+#define KMALLOC_NR_CACHES           (KMALLOC_MAX_SHIFT - KMALLOC_MIN_SHIFT + 1)
+
+typedef uint16_t kmem_bufctl_t;
 
+#define BUFCTL_END                  ((kmem_bufctl_t)-1)
 
-struct slob_block {
-	int units;
-	struct slob_block *next;
+#define KMEM_NR_SITES               128                 // size of the call site table, a power of 2
+
+struct slab {
+    list_entry_t slab_link;         // entry in slabs_full/partial/free of the cache
+    void *s_mem;                    // the first object
+    size_t inuse;                   // # of objects in use
+    kmem_bufctl_t free;             // index of the first free object
+};
+
+#define le2slab(le, member)         \
+    to_struct((le), struct slab, member)
+
+#define slab_bufctl(slabp)          ((kmem_bufctl_t *)((struct slab *)(slabp) + 1))
+
+struct kmem_cache {
+    const char *name;
+    list_entry_t slabs_full;
+    list_entry_t slabs_partial;
+    list_entry_t slabs_free;
+    size_t nr_free_slabs;           // # of slabs on slabs_free
+    size_t objsize;                 // size of an object, aligned to KMEM_ALIGN
+    size_t num;                     // # of objects in a slab
+    size_t offset;                  // offset of the first object in a slab
+    size_t page_order;              // a slab is 2^page_order pages
+    size_t nr_slabs;                // # of slabs of the cache
+    size_t nr_active;               // # of objects in use
+    void (*ctor)(void *objp);
+    list_entry_t cache_link;        // entry in cache_chain
 };
-typedef struct slob_block slob_t;
 
-#define SLOB_UNIT sizeof(slob_t)
-#define SLOB_UNITS(size) (((size) + SLOB_UNIT - 1)/SLOB_UNIT)
-#define SLOB_ALIGN L1_CACHE_BYTES
+#define le2cache(le, member)        \
+    to_struct((le), struct kmem_cache, member)
+
+#define SET_PAGE_CACHE(page, cachep)    ((page)->page_link.next = (list_entry_t *)(cachep))
+#define GET_PAGE_CACHE(page)            ((struct kmem_cache *)((page)->page_link.next))
+#define SET_PAGE_SLAB(page, slabp)      ((page)->page_link.prev = (list_entry_t *)(slabp))
+#define GET_PAGE_SLAB(page)             ((struct slab *)((page)->page_link.prev))
 
 struct bigblock {
 	int order;
+	int site;
 	void *pages;
 	struct bigblock *next;
 };
 typedef struct bigblock bigblock_t;
 
-static slob_t arena = { .next = &arena, .units = 1 };
-static slob_t *slobfree = &arena;
 static bigblock_t *bigblocks;
 
+// cache_cache - the cache that struct kmem_cache themselves come from
+static struct kmem_cache cache_cache;
+static list_entry_t cache_chain;
 
-static void* __slob_get_free_pages(gfp_t gfp, int order)
-{
-  struct Page * page = alloc_pages(1 << order);
-  if(!page)
-    return NULL;
-  return page2kva(page);
-}
-
-#define __slob_get_free_page(gfp) __slob_get_free_pages(gfp, 0)
-
-static inline void __slob_free_pages(unsigned long kva, int order)
-{
-  free_pages(kva2page(kva), 1 << order);
-}
+static struct kmem_cache *kmalloc_caches[KMALLOC_NR_CACHES];
+static struct kmem_cache *bigblock_cachep;
 
-static void slob_free(void *b, int size);
-
-static void *slob_alloc(size_t size, gfp_t gfp, int align)
-{
-  assert( (size + SLOB_UNIT) < PAGE_SIZE );
+static const char *kmalloc_cache_names[KMALLOC_NR_CACHES] = {
+    "size-32", "size-64", "size-128", "size-256", "size-512", "size-1024", "size-2048",
+};
 
-	slob_t *prev, *cur, *aligned = 0;
-	int delta = 0, units = SLOB_UNITS(size);
-	unsigned long flags;
+/* *
+ * kmem_site - what the allocations made at one call site hold. kmem_sites[0]
+ * collects the sites that find the table full.
+ * */
+struct kmem_site {
+    uintptr_t caller;               // return address of the allocation call, 0 if unused
+    size_t count;                   // # of objects in use
+    size_t bytes;                   // bytes in use
+    size_t max_bytes;               // high-water mark of bytes
+    size_t nr_allocs;               // # of allocations ever made
+};
 
-	spin_lock_irqsave(&slob_lock, flags);
-	prev = slobfree;
-	for (cur = prev->next; ; prev = cur, cur = cur->next) {
-		if (align) {
-			aligned = (slob_t *)ALIGN((unsigned long)cur, align);
-			delta = aligned - cur;
-		}
-		if (cur->units >= units + delta) { /* room enough? */
-			if (delta) { /* need to fragment head to align? */
-				aligned->units = cur->units - delta;
-				aligned->next = cur->next;
-				cur->next = aligned;
-				cur->units = delta;
-				prev = cur;
-				cur = aligned;
-			}
-
-			if (cur->units == units) /* exact fit? */
-				prev->next = cur->next; /* unlink */
-			else { /* fragment */
-				prev->next = cur + units;
-				prev->next->units = cur->units - units;
-				prev->next->next = cur->next;
-				cur->units = units;
-			}
-
-			slobfree = prev;
-			spin_unlock_irqrestore(&slob_lock, flags);
-			return cur;
-		}
-		if (cur == slobfree) {
-			spin_unlock_irqrestore(&slob_lock, flags);
+static struct kmem_site kmem_sites[KMEM_NR_SITES];
+static struct kmalloc_stat kmem_stat;
+
+// kmem_site_get - the index of the site of caller, called with interrupts disabled
+static int
+kmem_site_get(uintptr_t caller) {
+    int i, idx = (caller >> 2) & (KMEM_NR_SITES - 1);
+    for (i = 0; i < KMEM_NR_SITES; i ++, idx = (idx + 1) & (KMEM_NR_SITES - 1)) {
+        if (idx == 0) {
+            continue;
+        }
+        if (kmem_sites[idx].caller == caller) {
+            return idx;
+        }
+        if (kmem_sites[idx].caller == 0) {
+            kmem_sites[idx].caller = caller;
+            kmem_stat.nr_sites ++;
+            return idx;
+        }
+    }
+    return 0;
+}
 
-			if (size == PAGE_SIZE) /* trying to shrink arena? */
-				return 0;
+// kmem_account - charge (or credit, if !alloc) bytes to a site, called with interrupts disabled
+static void
+kmem_account(int site, size_t bytes, bool big, bool alloc) {
+    struct kmem_site *s = kmem_sites + site;
+    size_t *total = big ? &(kmem_stat.big_bytes) : &(kmem_stat.slab_bytes);
+    if (alloc) {
+        s->count ++, s->nr_allocs ++, s->bytes += bytes, *total += bytes;
+        if (s->bytes > s->max_bytes) {
+            s->max_bytes = s->bytes;
+        }
+        if (kmem_stat.slab_bytes + kmem_stat.big_bytes > kmem_stat.max_bytes) {
+            kmem_stat.max_bytes = kmem_stat.slab_bytes + kmem_stat.big_bytes;
+        }
+    }
+    else {
+        assert(s->count > 0 && s->bytes >= bytes && *total >= bytes);
+        s->count --, s->bytes -= bytes, *total -= bytes;
+    }
+}
 
-			cur = (slob_t *)__slob_get_free_page(gfp);
-			if (!cur)
-				return 0;
+// kmem_cache_estimate - the smallest slab order that wastes no more than 1/8 of the slab
+static void
+kmem_cache_estimate(struct kmem_cache *cachep) {
+    size_t order, num = 0, offset = 0;
+    for (order = 0; order <= KMEM_SLAB_MAX_ORDER; order ++) {
+        size_t slab_size = (PGSIZE << order);
+        num = (slab_size - sizeof(struct slab)) / (cachep->objsize + sizeof(kmem_bufctl_t));
+        offset = ROUNDUP(sizeof(struct slab) + num * sizeof(kmem_bufctl_t), KMEM_ALIGN);
+        while (num > 0 && offset + num * cachep->objsize > slab_size) {
+            num --;
+            offset = ROUNDUP(sizeof(struct slab) + num * sizeof(kmem_bufctl_t), KMEM_ALIGN);
+        }
+        if (num > 0 && (slab_size - offset - num * cachep->objsize) * 8 <= slab_size) {
+            break;
+        }
+    }
+    if (order > KMEM_SLAB_MAX_ORDER) {
+        order = KMEM_SLAB_MAX_ORDER;
+    }
+    assert(num > 0 && num < BUFCTL_END);
+    cachep->num = num, cachep->offset = offset, cachep->page_order = order;
+}
 
-			slob_free(cur, PAGE_SIZE);
-			spin_lock_irqsave(&slob_lock, flags);
-			cur = slobfree;
-		}
-	}
+static void
+kmem_cache_setup(struct kmem_cache *cachep, const char *name, size_t size, void (*ctor)(void *)) {
+    cachep->name = name;
+    list_init(&(cachep->slabs_full));
+    list_init(&(cachep->slabs_partial));
+    list_init(&(cachep->slabs_free));
+    cachep->nr_free_slabs = 0;
+    cachep->nr_slabs = cachep->nr_active = 0;
+    cachep->objsize = ROUNDUP(size, KMEM_ALIGN);
+    cachep->ctor = ctor;
+    kmem_cache_estimate(cachep);
+    list_add_before(&cache_chain, &(cachep->cache_link));
 }
 
-static void slob_free(void *block, int size)
-{
-	slob_t *cur, *b = (slob_t *)block;
-	unsigned long flags;
+// kmem_cache_grow - make a new slab for cachep and put it on slabs_free
+static bool
+kmem_cache_grow(struct kmem_cache *cachep) {
+    size_t i, npages = (1 << cachep->page_order);
+    struct Page *page = alloc_pages(npages);
+    if (page == NULL) {
+        return 0;
+    }
+
+    struct slab *slabp = page2kva(page);
+    slabp->s_mem = (void *)slabp + cachep->offset;
+    slabp->inuse = 0;
+    slabp->free = 0;
+    kmem_bufctl_t *bufctl = slab_bufctl(slabp);
+    for (i = 0; i < cachep->num; i ++) {
+        bufctl[i] = i + 1;
+        if (cachep->ctor != NULL) {
+            cachep->ctor(slabp->s_mem + i * cachep->objsize);
+        }
+    }
+    bufctl[cachep->num - 1] = BUFCTL_END;
+
+    for (i = 0; i < npages; i ++) {
+        SetPageSlab(page + i);
+        SET_PAGE_CACHE(page + i, cachep);
+        SET_PAGE_SLAB(page + i, slabp);
+    }
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        list_add(&(cachep->slabs_free), &(slabp->slab_link));
+        cachep->nr_free_slabs ++;
+        cachep->nr_slabs ++;
+        kmem_stat.slab_pages += npages;
+    }
+    local_intr_restore(intr_flag);
+    return 1;
+}
 
-	if (!block)
-		return;
+// kmem_slab_destroy - give the pages of a slab that is off every list back to the pmm
+static void
+kmem_slab_destroy(struct kmem_cache *cachep, struct slab *slabp) {
+    assert(slabp->inuse == 0);
+    size_t i, npages = (1 << cachep->page_order);
+    struct Page *page = kva2page(slabp);
+    for (i = 0; i < npages; i ++) {
+        ClearPageSlab(page + i);
+        SET_PAGE_CACHE(page + i, NULL);
+        SET_PAGE_SLAB(page + i, NULL);
+    }
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        cachep->nr_slabs --;
+        kmem_stat.slab_pages -= npages;
+    }
+    local_intr_restore(intr_flag);
+    free_pages(page, npages);
+}
 
-	if (size)
-		b->units = SLOB_UNITS(size);
+/* *
+ * kmem_cache_create - make a cache of objects of @size bytes, @ctor (if not NULL)
+ * initializes each object once when its slab is created
+ * */
+struct kmem_cache *
+kmem_cache_create(const char *name, size_t size, void (*ctor)(void *)) {
+    assert(size > 0 && size <= (PGSIZE << KMEM_SLAB_MAX_ORDER) / 2);
+    struct kmem_cache *cachep;
+    if ((cachep = kmem_cache_alloc(&cache_cache)) != NULL) {
+        bool intr_flag;
+        local_intr_save(intr_flag);
+        {
+            kmem_cache_setup(cachep, name, size, ctor);
+        }
+        local_intr_restore(intr_flag);
+    }
+    return cachep;
+}
 
-	/* Find reinsertion point */
-	spin_lock_irqsave(&slob_lock, flags);
-	for (cur = slobfree; !(b > cur && b < cur->next); cur = cur->next)
-		if (cur >= cur->next && (b > cur || b < cur->next))
-			break;
+// kmem_cache_reap_one - give every free slab of cachep back, return # of pages freed
+static size_t
+kmem_cache_reap_one(struct kmem_cache *cachep) {
+    size_t nr_pages = 0;
+    while (1) {
+        struct slab *slabp = NULL;
+        bool intr_flag;
+        local_intr_save(intr_flag);
+        {
+            list_entry_t *le = list_next(&(cachep->slabs_free));
+            if (le != &(cachep->slabs_free)) {
+                slabp = le2slab(le, slab_link);
+                list_del(le);
+                cachep->nr_free_slabs --;
+            }
+        }
+        local_intr_restore(intr_flag);
+        if (slabp == NULL) {
+            break;
+        }
+        kmem_slab_destroy(cachep, slabp);
+        nr_pages += (1 << cachep->page_order);
+    }
+    return nr_pages;
+}
 
-	if (b + b->units == cur->next) {
-		b->units += cur->next->units;
-		b->next = cur->next->next;
-	} else
-		b->next = cur->next;
+// kmem_cache_destroy - remove a cache, all of its objects must have been freed
+void
+kmem_cache_destroy(struct kmem_cache *cachep) {
+    assert(list_empty(&(cachep->slabs_full)) && list_empty(&(cachep->slabs_partial)));
+    kmem_cache_reap_one(cachep);
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        list_del(&(cachep->cache_link));
+    }
+    local_intr_restore(intr_flag);
+    kmem_cache_free(&cache_cache, cachep);
+}
 
-	if (cur + cur->units == b) {
-		cur->units += b->units;
-		cur->next = b->next;
-	} else
-		cur->next = b;
+// kmem_cache_reap - give the free slabs of every cache back to the pmm, return # of pages freed
+size_t
+kmem_cache_reap(void) {
+    size_t nr_pages = 0;
+    list_entry_t *le = &cache_chain;
+    while ((le = list_next(le)) != &cache_chain) {
+        nr_pages += kmem_cache_reap_one(le2cache(le, cache_link));
+    }
+    return nr_pages;
+}
 
-	slobfree = cur;
+// kmem_cache_alloc_site - take an object from cachep, charged to caller
+static void *
+kmem_cache_alloc_site(struct kmem_cache *cachep, uintptr_t caller) {
+    void *objp = NULL;
+    bool intr_flag;
+    while (1) {
+        local_intr_save(intr_flag);
+        list_entry_t *le = list_next(&(cachep->slabs_partial));
+        if (le == &(cachep->slabs_partial)) {
+            if ((le = list_next(&(cachep->slabs_free))) != &(cachep->slabs_free)) {
+                cachep->nr_free_slabs --;
+            }
+        }
+        if (le != &(cachep->slabs_free)) {
+            struct slab *slabp = le2slab(le, slab_link);
+            kmem_bufctl_t idx = slabp->free, site = kmem_site_get(caller);
+            objp = slabp->s_mem + idx * cachep->objsize;
+            slabp->free = slab_bufctl(slabp)[idx];
+            slab_bufctl(slabp)[idx] = site;
+            slabp->inuse ++;
+            cachep->nr_active ++;
+            kmem_account(site, cachep->objsize, 0, 1);
+            list_del(le);
+            if (slabp->inuse == cachep->num) {
+                list_add(&(cachep->slabs_full), le);
+            }
+            else {
+                list_add(&(cachep->slabs_partial), le);
+            }
+            local_intr_restore(intr_flag);
+            return objp;
+        }
+        local_intr_restore(intr_flag);
+
+        if (!kmem_cache_grow(cachep)) {
+            return NULL;
+        }
+    }
+}
 
-	spin_unlock_irqrestore(&slob_lock, flags);
+void *
+kmem_cache_alloc(struct kmem_cache *cachep) {
+    return kmem_cache_alloc_site(cachep, (uintptr_t)__builtin_return_address(0));
 }
 
+void
+kmem_cache_free(struct kmem_cache *cachep, void *objp) {
+    struct Page *page = kva2page(objp);
+    assert(PageSlab(page) && GET_PAGE_CACHE(page) == cachep);
+    struct slab *slabp = GET_PAGE_SLAB(page), *destroy = NULL;
+    size_t idx = (objp - slabp->s_mem) / cachep->objsize;
+    assert(idx < cachep->num && slabp->s_mem + idx * cachep->objsize == objp);
+
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        kmem_account(slab_bufctl(slabp)[idx], cachep->objsize, 0, 0);
+        cachep->nr_active --;
+        slab_bufctl(slabp)[idx] = slabp->free;
+        slabp->free = idx;
+        list_del(&(slabp->slab_link));
+        if (-- slabp->inuse != 0) {
+            list_add(&(cachep->slabs_partial), &(slabp->slab_link));
+        }
+        else if (cachep->nr_free_slabs < KMEM_CACHE_FREE_SLABS) {
+            list_add(&(cachep->slabs_free), &(slabp->slab_link));
+            cachep->nr_free_slabs ++;
+        }
+        else {
+            destroy = slabp;
+        }
+    }
+    local_intr_restore(intr_flag);
+
+    if (destroy != NULL) {
+        kmem_slab_destroy(cachep, destroy);
+    }
+}
 
+static void
+check_slab_ctor(void *objp) {
+    memset(objp, 0x5a, 100);
+}
 
 void check_slab(void) {
-  cprintf("check_slab() success\n");
+    size_t nr_free_pages_store = nr_free_pages();
+    size_t kernel_allocated_store = kallocated();
+    struct kmem_cache *cachep;
+    assert((cachep = kmem_cache_create("check_slab", 100, check_slab_ctor)) != NULL);
+    assert(cachep->objsize == 104 && cachep->page_order == 0);
+
+    // fill one slab and start the next, every object arrives constructed
+    size_t i, j, n = cachep->num + 1;
+    void **objs = kmalloc(n * sizeof(void *));
+    assert(objs != NULL);
+    for (i = 0; i < n; i ++) {
+        assert((objs[i] = kmem_cache_alloc(cachep)) != NULL);
+        assert(((uintptr_t)objs[i] % KMEM_ALIGN) == 0);
+        assert(*(uint32_t *)objs[i] == 0x5a5a5a5a && *((uint8_t *)objs[i] + 99) == 0x5a);
+        for (j = 0; j < i; j ++) {
+            assert(objs[j] != objs[i]);
+        }
+    }
+    assert(!list_empty(&(cachep->slabs_full)) && !list_empty(&(cachep->slabs_partial)));
+    assert(list_empty(&(cachep->slabs_free)));
+
+    // the freed object is the next one handed out
+    kmem_cache_free(cachep, objs[1]);
+    assert(kmem_cache_alloc(cachep) == objs[1]);
+
+    // a slab that empties out is kept, the second one is given back
+    for (i = 0; i < n; i ++) {
+        kmem_cache_free(cachep, objs[i]);
+    }
+    assert(list_empty(&(cachep->slabs_full)) && list_empty(&(cachep->slabs_partial)));
+    assert(cachep->nr_free_slabs == 1 && cachep->nr_active == 0);
+    kfree(objs);
+    kmem_cache_destroy(cachep);
+
+    // every size class, and a bigblock
+    for (i = 1; i <= KMALLOC_MAX_SIZE * 2; i += 97) {
+        void *p0 = kmalloc(i), *p1 = kmalloc(i);
+        assert(p0 != NULL && p1 != NULL && p0 != p1);
+        assert(ksize(p0) >= i && ksize(p1) >= i);
+        memset(p0, 0, i), memset(p1, 0xff, i);
+        kfree(p0), kfree(p1);
+    }
+
+    kmem_cache_reap();
+    assert(nr_free_pages_store == nr_free_pages());
+    assert(kernel_allocated_store == kallocated());
+    cprintf("check_slab() success\n");
 }
 
 void
 slab_init(void) {
-  cprintf("use SLOB allocator\n");
-//   check_slab();
+    list_init(&cache_chain);
+    kmem_cache_setup(&cache_cache, "kmem_cache", sizeof(struct kmem_cache), NULL);
+
+    int i;
+    for (i = 0; i < KMALLOC_NR_CACHES; i ++) {
+        kmalloc_caches[i] = kmem_cache_create(kmalloc_cache_names[i], 1 << (i + KMALLOC_MIN_SHIFT), NULL);
+        assert(kmalloc_caches[i] != NULL);
+    }
+    bigblock_cachep = kmem_cache_create("bigblock", sizeof(bigblock_t), NULL);
+    assert(bigblock_cachep != NULL);
+
+    cprintf("use SLAB allocator\n");
+    check_slab();
 }
 
-inline void 
+inline void
 kmalloc_init(void) {
     slab_init();
     cprintf("kmalloc_init() succeeded!\n");
 }
 
+// slab_allocated - bytes of slab objects in use
 size_t
 slab_allocated(void) {
-  return 0;
+    size_t ret;
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        ret = kmem_stat.slab_bytes;
+    }
+    local_intr_restore(intr_flag);
+    return ret;
 }
 
+// kallocated - bytes of kernel heap in use, slab objects and bigblocks
 size_t
 kallocated(void) {
-   return slab_allocated();
+    struct kmalloc_stat stat;
+    kmalloc_get_stat(&stat);
+    return stat.slab_bytes + stat.big_bytes;
+}
+
+void
+kmalloc_get_stat(struct kmalloc_stat *stat) {
+    bool intr_flag;
+    local_intr_save(intr_flag);
+    {
+        *stat = kmem_stat;
+    }
+    local_intr_restore(intr_flag);
+}
+
+void
+kmalloc_print_stat(void) {
+    struct kmalloc_stat stat;
+    kmalloc_get_stat(&stat);
+    cprintf("kmalloc: %d bytes in use (max %d): %d in slab objects on %d pages, %d in bigblocks.\n",
+            stat.slab_bytes + stat.big_bytes, stat.max_bytes, stat.slab_bytes,
+            stat.slab_pages, stat.big_bytes);
+
+    cprintf("  %-16s %8s %8s %8s %8s\n", "cache", "objsize", "active", "objects", "slabs");
+    list_entry_t *le = &cache_chain;
+    while ((le = list_next(le)) != &cache_chain) {
+        struct kmem_cache *cachep = le2cache(le, cache_link);
+        cprintf("  %-16s %8d %8d %8d %8d\n", cachep->name, cachep->objsize,
+                cachep->nr_active, cachep->nr_slabs * cachep->num, cachep->nr_slabs);
+    }
+
+    // sites, largest in use first
+    bool printed[KMEM_NR_SITES] = {0};
+    cprintf("  %d call sites:\n", stat.nr_sites);
+    while (1) {
+        int i, max = -1;
+        for (i = 0; i < KMEM_NR_SITES; i ++) {
+            if (!printed[i] && kmem_sites[i].nr_allocs != 0
+                    && (max < 0 || kmem_sites[i].bytes > kmem_sites[max].bytes)) {
+                max = i;
+            }
+        }
+        if (max < 0) {
+            break;
+        }
+        printed[max] = 1;
+        struct kmem_site site = kmem_sites[max];
+        cprintf("  %8d bytes in %d objs, max %d bytes, %d allocs, at\n",
+                site.bytes, site.count, site.max_bytes, site.nr_allocs);
+        if (site.caller != 0) {
+            print_debuginfo(site.caller - 1);
+        }
+        else {
+            cprintf("    <other sites>\n");
+        }
+    }
 }
 
 static int find_order(int size)
@@ -220,40 +595,51 @@ static int find_order(int size)
 	return order;
 }
 
-static void *__kmalloc(size_t size, gfp_t gfp)
+// kmalloc_index - the size class of a request of size bytes
+static inline int
+kmalloc_index(size_t size) {
+    int shift = KMALLOC_MIN_SHIFT;
+    while ((1 << shift) < size) {
+        shift ++;
+    }
+    return shift - KMALLOC_MIN_SHIFT;
+}
+
+static void *__kmalloc(size_t size, uintptr_t caller)
 {
-	slob_t *m;
 	bigblock_t *bb;
 	unsigned long flags;
 
-	if (size < PAGE_SIZE - SLOB_UNIT) {
-		m = slob_alloc(size + SLOB_UNIT, gfp, 0);
-		return m ? (void *)(m + 1) : 0;
+	if (size <= KMALLOC_MAX_SIZE) {
+		return kmem_cache_alloc_site(kmalloc_caches[kmalloc_index(size)], caller);
 	}
 
-	bb = slob_alloc(sizeof(bigblock_t), gfp, 0);
+	bb = kmem_cache_alloc_site(bigblock_cachep, caller);
 	if (!bb)
 		return 0;
 
 	bb->order = find_order(size);
-	bb->pages = (void *)__slob_get_free_pages(gfp, bb->order);
+	struct Page *page = alloc_pages(1 << bb->order);
+	bb->pages = (page != NULL) ? page2kva(page) : NULL;
 
 	if (bb->pages) {
 		spin_lock_irqsave(&block_lock, flags);
 		bb->next = bigblocks;
 		bigblocks = bb;
+		bb->site = kmem_site_get(caller);
+		kmem_account(bb->site, PAGE_SIZE << bb->order, 1, 1);
 		spin_unlock_irqrestore(&block_lock, flags);
 		return bb->pages;
 	}
 
-	slob_free(bb, sizeof(bigblock_t));
+	kmem_cache_free(bigblock_cachep, bb);
 	return 0;
 }
 
 void *
 kmalloc(size_t size)
 {
-  return __kmalloc(size, 0);
+  return __kmalloc(size, (uintptr_t)__builtin_return_address(0));
 }
 
 
@@ -265,23 +651,25 @@ void kfree(void *block)
 	if (!block)
 		return;
 
-	if (!((unsigned long)block & (PAGE_SIZE-1))) {
-		/* might be on the big block list */
-		spin_lock_irqsave(&block_lock, flags);
-		for (bb = bigblocks; bb; last = &bb->next, bb = bb->next) {
-			if (bb->pages == block) {
-				*last = bb->next;
-				spin_unlock_irqrestore(&block_lock, flags);
-				__slob_free_pages((unsigned long)block, bb->order);
-				slob_free(bb, sizeof(bigblock_t));
-				return;
-			}
-		}
-		spin_unlock_irqrestore(&block_lock, flags);
+	struct Page *page = kva2page(block);
+	if (PageSlab(page)) {
+		kmem_cache_free(GET_PAGE_CACHE(page), block);
+		return;
 	}
 
-	slob_free((slob_t *)block - 1, 0);
-	return;
+	spin_lock_irqsave(&block_lock, flags);
+	for (bb = bigblocks; bb; last = &bb->next, bb = bb->next) {
+		if (bb->pages == block) {
+			*last = bb->next;
+			kmem_account(bb->site, PAGE_SIZE << bb->order, 1, 0);
+			spin_unlock_irqrestore(&block_lock, flags);
+			free_pages(page, 1 << bb->order);
+			kmem_cache_free(bigblock_cachep, bb);
+			return;
+		}
+	}
+	spin_unlock_irqrestore(&block_lock, flags);
+	panic("kfree: %p was not allocated by kmalloc.\n", block);
 }
 
 
@@ -293,18 +681,18 @@ unsigned int ksize(const void *block)
 	if (!block)
 		return 0;
 
-	if (!((unsigned long)block & (PAGE_SIZE-1))) {
-		spin_lock_irqsave(&block_lock, flags);
-		for (bb = bigblocks; bb; bb = bb->next)
-			if (bb->pages == block) {
-				spin_unlock_irqrestore(&slob_lock, flags);
-				return PAGE_SIZE << bb->order;
-			}
-		spin_unlock_irqrestore(&block_lock, flags);
+	struct Page *page = kva2page((void *)block);
+	if (PageSlab(page)) {
+		return GET_PAGE_CACHE(page)->objsize;
 	}
 
-	return ((slob_t *)block - 1)->units * SLOB_UNIT;
-}
-
-
+	spin_lock_irqsave(&block_lock, flags);
+	for (bb = bigblocks; bb; bb = bb->next)
+		if (bb->pages == block) {
+			spin_unlock_irqrestore(&block_lock, flags);
+			return PAGE_SIZE << bb->order;
+		}
+	spin_unlock_irqrestore(&block_lock, flags);
 
+	return 0;
+}
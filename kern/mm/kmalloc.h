@@ -9,8 +9,30 @@ void kmalloc_init(void);
 
 void *kmalloc(size_t n);
 void kfree(void *objp);
+unsigned int ksize(const void *objp);
+
+struct kmem_cache;
+
+struct kmem_cache *kmem_cache_create(const char *name, size_t size, void (*ctor)(void *));
+void kmem_cache_destroy(struct kmem_cache *cachep);
+void *kmem_cache_alloc(struct kmem_cache *cachep);
+void kmem_cache_free(struct kmem_cache *cachep, void *objp);
+size_t kmem_cache_reap(void);
 
 size_t kallocated(void);
+size_t slab_allocated(void);
+
+/* kernel heap statistics, see kmalloc_print_stat */
+struct kmalloc_stat {
+    size_t slab_bytes;          // bytes of slab objects in use
+    size_t big_bytes;           // bytes of bigblocks in use
+    size_t max_bytes;           // high-water mark of slab_bytes + big_bytes
+    size_t slab_pages;          // pages held by slabs, free objects included
+    size_t nr_sites;            // # of call sites seen
+};
+
+void kmalloc_get_stat(struct kmalloc_stat *stat);
+void kmalloc_print_stat(void);
 
 #endif /* !__KERN_MM_SLAB_H__ */
 
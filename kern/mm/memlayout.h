@@ -134,11 +134,20 @@ struct Page {
     list_entry_t page_link;         // free list link
     list_entry_t pra_page_link;     // used for pra (page replace algorithm)
     uintptr_t pra_vaddr;            // used for pra (page replace algorithm)
+    swap_entry_t swap_entry;        // the swap slot of a page in the swap cache, see swap.c
+    struct inode *file;             // the file of a page in the file cache, see filemap.c
+    off_t file_off;                 // and the offset of the page in it
+    list_entry_t file_link;         // the hash list of the file cache
 };
 
 /* Flags describing the status of a page frame */
 #define PG_reserved                 0       // the page descriptor is reserved for kernel or unusable
 #define PG_property                 1       // the member 'property' is valid
+#define PG_slab                     2       // the page belongs to a slab of kmalloc, see kmalloc.c
+#define PG_swap                     3       // the page is on the page replacement list of a mm, see swap.h
+#define PG_swapcache                4       // the page is in the swap cache, see swap.c
+#define PG_writeback                5       // swap_out is writing the page to the disk
+#define PG_filecache                6       // the page is in the file cache, see filemap.c
 
 #define SetPageReserved(page)       set_bit(PG_reserved, &((page)->flags))
 #define ClearPageReserved(page)     clear_bit(PG_reserved, &((page)->flags))
@@ -146,6 +155,21 @@ struct Page {
 #define SetPageProperty(page)       set_bit(PG_property, &((page)->flags))
 #define ClearPageProperty(page)     clear_bit(PG_property, &((page)->flags))
 #define PageProperty(page)          test_bit(PG_property, &((page)->flags))
+#define SetPageSlab(page)           set_bit(PG_slab, &((page)->flags))
+#define ClearPageSlab(page)         clear_bit(PG_slab, &((page)->flags))
+#define PageSlab(page)              test_bit(PG_slab, &((page)->flags))
+#define SetPageSwap(page)           set_bit(PG_swap, &((page)->flags))
+#define ClearPageSwap(page)         clear_bit(PG_swap, &((page)->flags))
+#define PageSwap(page)              test_bit(PG_swap, &((page)->flags))
+#define SetPageSwapCache(page)      set_bit(PG_swapcache, &((page)->flags))
+#define ClearPageSwapCache(page)    clear_bit(PG_swapcache, &((page)->flags))
+#define PageSwapCache(page)         test_bit(PG_swapcache, &((page)->flags))
+#define SetPageWriteback(page)      set_bit(PG_writeback, &((page)->flags))
+#define ClearPageWriteback(page)    clear_bit(PG_writeback, &((page)->flags))
+#define PageWriteback(page)         test_bit(PG_writeback, &((page)->flags))
+#define SetPageFileCache(page)      set_bit(PG_filecache, &((page)->flags))
+#define ClearPageFileCache(page)    clear_bit(PG_filecache, &((page)->flags))
+#define PageFileCache(page)         test_bit(PG_filecache, &((page)->flags))
 
 // convert list entry to page
 #define le2page(le, member)                 \
@@ -6,11 +6,13 @@
 #include <memlayout.h>
 #include <pmm.h>
 #include <default_pmm.h>
+#include <buddy_pmm.h>
 #include <sync.h>
 #include <error.h>
 #include <swap.h>
 #include <vmm.h>
 #include <kmalloc.h>
+#include <filemap.h>
 
 /* *
  * Task State Segment:
@@ -90,6 +92,11 @@ static struct pseudodesc gdt_pd = {
     sizeof(gdt) - 1, (uintptr_t)gdt
 };
 
+#define PMM_BENCH_NPAGES            512         // pages given to each manager
+#define PMM_BENCH_NSLOT             96          // max # of live allocations
+#define PMM_BENCH_NOPS              4096        // # of alloc/free operations
+
+static void check_pmm_bench(struct Page *base, size_t n);
 static void check_alloc_page(void);
 static void check_pgdir(void);
 static void check_boot_pgdir(void);
@@ -140,7 +147,8 @@ gdt_init(void) {
 //init_pmm_manager - initialize a pmm_manager instance
 static void
 init_pmm_manager(void) {
-    pmm_manager = &default_pmm_manager;
+    // first fit: &default_pmm_manager, buddy system: &buddy_pmm_manager
+    pmm_manager = &buddy_pmm_manager;
     cprintf("memory management: %s\n", pmm_manager->name);
     pmm_manager->init();
 }
@@ -169,7 +177,15 @@ alloc_pages(size_t n) {
          
          extern struct mm_struct *check_mm_struct;
          //cprintf("page %x, call swap_out in alloc_pages %d\n",page, n);
-         swap_out(check_mm_struct, n, 0);
+         if (check_mm_struct != NULL) {
+              swap_out(check_mm_struct, n, 0);
+         }
+         else if (try_free_pages(n) == 0) {  // kswapd has fallen behind, reclaim here
+              break;
+         }
+    }
+    if (swap_init_ok) {
+         kswapd_wakeup();
     }
     //cprintf("n %d,get page %x, No %d in alloc_pages\n",n,page,(page-pages));
     return page;
@@ -200,6 +216,30 @@ nr_free_pages(void) {
     return ret;
 }
 
+//e820_free_range - the page aligned part of e820 entry i that is usable RAM above freemem and below KMEMSIZE
+static bool
+e820_free_range(struct e820map *memmap, int i, uintptr_t freemem, uint64_t *begin_store, uint64_t *end_store) {
+    uint64_t begin = memmap->map[i].addr, end = begin + memmap->map[i].size;
+    if (memmap->map[i].type != E820_ARM) {
+        return 0;
+    }
+    if (begin < freemem) {
+        begin = freemem;
+    }
+    if (end > KMEMSIZE) {
+        end = KMEMSIZE;
+    }
+    if (begin < end) {
+        begin = ROUNDUP(begin, PGSIZE);
+        end = ROUNDDOWN(end, PGSIZE);
+        if (begin < end) {
+            *begin_store = begin, *end_store = end;
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /* pmm_init - initialize the physical memory management */
 static void
 page_init(void) {
@@ -232,23 +272,20 @@ page_init(void) {
     }
 
     uintptr_t freemem = PADDR((uintptr_t)pages + sizeof(struct Page) * npage);
+    uint64_t mem_begin, mem_end;
 
+    // run the allocator benchmark on the first free range large enough, before anything is handed out
     for (i = 0; i < memmap->nr_map; i ++) {
-        uint64_t begin = memmap->map[i].addr, end = begin + memmap->map[i].size;
-        if (memmap->map[i].type == E820_ARM) {
-            if (begin < freemem) {
-                begin = freemem;
-            }
-            if (end > KMEMSIZE) {
-                end = KMEMSIZE;
-            }
-            if (begin < end) {
-                begin = ROUNDUP(begin, PGSIZE);
-                end = ROUNDDOWN(end, PGSIZE);
-                if (begin < end) {
-                    init_memmap(pa2page(begin), (end - begin) / PGSIZE);
-                }
-            }
+        if (e820_free_range(memmap, i, freemem, &mem_begin, &mem_end)
+                && mem_end - mem_begin >= PMM_BENCH_NPAGES * PGSIZE) {
+            check_pmm_bench(pa2page(mem_begin), PMM_BENCH_NPAGES);
+            break;
+        }
+    }
+
+    for (i = 0; i < memmap->nr_map; i ++) {
+        if (e820_free_range(memmap, i, freemem, &mem_begin, &mem_end)) {
+            init_memmap(pa2page(mem_begin), (mem_end - mem_begin) / PGSIZE);
         }
     }
 }
@@ -402,6 +439,31 @@ get_page(pde_t *pgdir, uintptr_t la, pte_t **ptep_store) {
     return NULL;
 }
 
+/* *
+ * put_page - drop a reference to a page of user memory (a mapping, or a pin of
+ * get_user_pages), and free the page with the last one.
+ * */
+void
+put_page(struct Page *page) {
+    if (page_ref_dec(page) == 0) {
+        // the last user is gone, take the page off the replacement list it is on
+        if (PageSwap(page)) {
+            list_del(&(page->pra_page_link));
+            ClearPageSwap(page);
+        }
+        // a page being written to swap is freed by swap_out when the write is done
+        if (!PageWriteback(page)) {
+            if (PageSwapCache(page)) {
+                swap_cache_del(page);
+            }
+            if (PageFileCache(page)) {
+                filemap_del(page);
+            }
+            free_page(page);
+        }
+    }
+}
+
 //page_remove_pte - free an Page sturct which is related linear address la
 //                - and clean(invalidate) pte which is related linear address la
 //note: PT is changed, so the TLB need to be invalidate 
@@ -434,12 +496,15 @@ page_remove_pte(pde_t *pgdir, uintptr_t la, pte_t *ptep) {
 #endif
     if (*ptep & PTE_P) {
         struct Page *page = pte2page(*ptep);
-        if (page_ref_dec(page) == 0) {
-            free_page(page);
-        }
+        put_page(page);
         *ptep = 0;
         tlb_invalidate(pgdir, la);
     }
+    else if (*ptep != 0) {
+        // a swap entry, drop its reference to the swap slot
+        swap_free(*ptep);
+        *ptep = 0;
+    }
 }
 
 void
@@ -478,7 +543,9 @@ exit_range(pde_t *pgdir, uintptr_t start, uintptr_t end) {
 /* copy_range - copy content of memory (start, end) of one process A to another process B
  * @to:    the addr of process B's Page Directory
  * @from:  the addr of process A's Page Directory
- * @share: flags to indicate to dup OR share. We just use dup method, so it didn't be used.
+ * @share: flags to indicate to dup OR share. With share, B maps the same pages as A
+ *         and writable ones are turned read-only in both, do_pgfault copies them
+ *         on the first write (copy on write); otherwise every page is copied now.
  *
  * CALL GRAPH: copy_mm-->dup_mmap-->copy_range
  */
@@ -502,11 +569,27 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
         uint32_t perm = (*ptep & PTE_USER);
         //get page from ptep
         struct Page *page = pte2page(*ptep);
-        // alloc a page for process B
-        struct Page *npage=alloc_page();
         assert(page!=NULL);
-        assert(npage!=NULL);
         int ret=0;
+        if (share) {
+            // write-protect A's pte, then map the same page read-only in B (page_insert takes a ref)
+            if (perm & PTE_W) {
+                perm &= ~PTE_W;
+                *ptep &= ~PTE_W;
+                tlb_invalidate(from, start);
+            }
+            ret = page_insert(to, page, start, perm);
+            if (ret != 0) {
+                return ret;
+            }
+            start += PGSIZE;
+            continue;
+        }
+        // alloc a page for process B
+        struct Page *npage=alloc_page();
+        if (npage == NULL) {
+            return -E_NO_MEM;
+        }
         /* LAB5:EXERCISE2 YOUR CODE
          * replicate content of page to npage, build the map of phy addr of nage with the linear addr start
          *
@@ -529,6 +612,14 @@ copy_range(pde_t *to, pde_t *from, uintptr_t start, uintptr_t end, bool share) {
         ret = page_insert(to, npage, start, perm);
         assert(ret == 0);
         }
+        else if (*ptep != 0) {
+            // swapped out, B shares the swap slot
+            if ((nptep = get_pte(to, start, 1)) == NULL) {
+                return -E_NO_MEM;
+            }
+            swap_duplicate(*ptep);
+            *nptep = *ptep;
+        }
         start += PGSIZE;
     } while (start != 0 && start < end);
     return 0;
@@ -567,6 +658,9 @@ page_insert(pde_t *pgdir, struct Page *page, uintptr_t la, uint32_t perm) {
             page_remove_pte(pgdir, la, ptep);
         }
     }
+    else if (*ptep != 0) {
+        swap_free(*ptep);
+    }
     *ptep = page2pa(page) | PTE_P | perm;
     tlb_invalidate(pgdir, la);
     return 0;
@@ -592,24 +686,122 @@ pgdir_alloc_page(pde_t *pgdir, uintptr_t la, uint32_t perm) {
             free_page(page);
             return NULL;
         }
-        if (swap_init_ok){
-            if(check_mm_struct!=NULL) {
-                swap_map_swappable(check_mm_struct, la, page, 0);
-                page->pra_vaddr=la;
-                assert(page_ref(page) == 1);
-                //cprintf("get No. %d  page: pra_vaddr %x, pra_link.prev %x, pra_link_next %x in pgdir_alloc_page\n", (page-pages), page->pra_vaddr,page->pra_page_link.prev, page->pra_page_link.next);
-            } 
-            else  {  //now current is existed, should fix it in the future
-                //swap_map_swappable(current->mm, la, page, 0);
-                //page->pra_vaddr=la;
-                //assert(page_ref(page) == 1);
-                //panic("pgdir_alloc_page: no pages. now current is existed, should fix it in the future\n");
+        // the page is made swappable by the caller that knows its mm, see mm_alloc_page
+    }
+
+    return page;
+}
+
+/* *
+ * check_pmm_bench - run the same mixed-order workload through each pmm_manager
+ * on the pages [base, base + n), and report the average cycles of an alloc and
+ * of a free, and how fragmented the free memory is when the workload stops
+ * (the largest block that can still be allocated, against all free pages).
+ * It runs before page_init hands memory to the selected manager, which is
+ * initialized again afterwards, and leaves the pages reserved as it found them.
+ * */
+static const struct pmm_manager *pmm_bench_managers[] = {
+    &default_pmm_manager, &buddy_pmm_manager,
+};
+
+static struct {
+    struct Page *page;
+    size_t n;
+} pmm_bench_slots[PMM_BENCH_NSLOT];
+
+// pmm_bench_size - half the requests are single pages, the rest go up to 4, 16 or 32 pages
+static size_t
+pmm_bench_size(uint32_t rand) {
+    uint32_t k = rand % 100, order = (k < 50) ? 0 : (k < 80) ? 2 : (k < 95) ? 4 : 5;
+    return 1 + (rand >> 8) % (1 << order);
+}
+
+// pmm_bench_largest - binary search the largest n that alloc_pages(n) still succeeds for
+static size_t
+pmm_bench_largest(const struct pmm_manager *m) {
+    size_t lo = 0, hi = m->nr_free_pages();
+    while (lo < hi) {
+        size_t mid = (lo + hi + 1) / 2;
+        struct Page *p = m->alloc_pages(mid);
+        if (p != NULL) {
+            m->free_pages(p, mid);
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+// pmm_bench_reset - give [base, base + n) back the state page_init leaves them in, reserved
+static void
+pmm_bench_reset(struct Page *base, size_t n) {
+    struct Page *p;
+    for (p = base; p != base + n; p ++) {
+        p->flags = p->property = p->zone_num = 0;
+        set_page_ref(p, 0);
+        SetPageReserved(p);
+    }
+}
+
+static void
+check_pmm_bench(struct Page *base, size_t n) {
+    int i, j;
+    struct Page *p;
+    for (i = 0; i < sizeof(pmm_bench_managers) / sizeof(pmm_bench_managers[0]); i ++) {
+        const struct pmm_manager *m = pmm_bench_managers[i];
+        m->init();
+        // the previous manager's init_memmap cleared PG_reserved, which the next one expects
+        pmm_bench_reset(base, n);
+        m->init_memmap(base, n);
+        memset(pmm_bench_slots, 0, sizeof(pmm_bench_slots));
+
+        uint64_t alloc_cycles = 0, free_cycles = 0, t;
+        size_t nr_alloc = 0, nr_free = 0, nr_fail = 0;
+        uint32_t rand = 20200101;
+        for (j = 0; j < PMM_BENCH_NOPS; j ++) {
+            rand = rand * 1103515245 + 12345;
+            int slot = (rand >> 16) % PMM_BENCH_NSLOT;
+            if (pmm_bench_slots[slot].page != NULL) {
+                t = rdtsc();
+                m->free_pages(pmm_bench_slots[slot].page, pmm_bench_slots[slot].n);
+                free_cycles += rdtsc() - t, nr_free ++;
+                pmm_bench_slots[slot].page = NULL;
+            }
+            else {
+                size_t size = pmm_bench_size(rand >> 8);
+                t = rdtsc();
+                p = m->alloc_pages(size);
+                alloc_cycles += rdtsc() - t, nr_alloc ++;
+                if (p == NULL) {
+                    nr_fail ++;
+                    continue;
+                }
+                pmm_bench_slots[slot].page = p, pmm_bench_slots[slot].n = size;
             }
         }
 
+        size_t nr_free_pages = m->nr_free_pages(), largest = pmm_bench_largest(m);
+        do_div(alloc_cycles, nr_alloc > 0 ? nr_alloc : 1);
+        do_div(free_cycles, nr_free > 0 ? nr_free : 1);
+        cprintf("pmm bench: %s: alloc %d cycles, free %d cycles, %d of %d allocs failed.\n",
+                m->name, (size_t)alloc_cycles, (size_t)free_cycles, nr_fail, nr_alloc);
+        cprintf("pmm bench: %s: %d pages free, largest block %d pages, fragmentation %d%%.\n",
+                m->name, nr_free_pages, largest,
+                (nr_free_pages > 0) ? 100 - largest * 100 / nr_free_pages : 0);
+
+        for (j = 0; j < PMM_BENCH_NSLOT; j ++) {
+            if (pmm_bench_slots[j].page != NULL) {
+                m->free_pages(pmm_bench_slots[j].page, pmm_bench_slots[j].n);
+            }
+        }
+        assert(m->nr_free_pages() == n && pmm_bench_largest(m) == n);
     }
 
-    return page;
+    pmm_bench_reset(base, n);
+    pmm_manager->init();
+    cprintf("check_pmm_bench() succeeded!\n");
 }
 
 static void
@@ -1,6 +1,7 @@
 #include <swap.h>
 #include <swapfs.h>
 #include <swap_fifo.h>
+#include <swap_clock.h>
 #include <stdio.h>
 #include <string.h>
 #include <memlayout.h>
@@ -8,6 +9,11 @@
 #include <mmu.h>
 #include <default_pmm.h>
 #include <kdebug.h>
+#include <proc.h>
+#include <sched.h>
+#include <error.h>
+#include <kmalloc.h>
+#include <filemap.h>
 
 // the valid vaddr for check is between 0~CHECK_VALID_VADDR-1
 #define CHECK_VALID_VIR_PAGE_NUM 5
@@ -28,6 +34,80 @@ unsigned int swap_page[CHECK_VALID_VIR_PAGE_NUM];
 unsigned int swap_in_seq_no[MAX_SEQ_NO],swap_out_seq_no[MAX_SEQ_NO];
 
 static void check_swap(void);
+static int kswapd_main(void *arg);
+
+/* *
+ * kswapd keeps nr_free_pages() between two watermarks ahead of the allocator:
+ * alloc_pages wakes it when the free pages drop below kswapd_low, and it swaps
+ * out pages until there are kswapd_high free again, so that an allocation
+ * seldom has to wait for a page to be written to disk. It takes pages from the
+ * mms with the lowest fault rate first (see mm_fault_rate), the ones that miss
+ * them the least. When kswapd falls behind, alloc_pages reclaims the same way
+ * itself (try_free_pages).
+ * */
+#define KSWAPD_NR_MM                16      // the mms considered for one reclaim
+#define KSWAPD_CLUSTER              SWAPFS_MAX_CLUSTER  // the pages swapped out of a mm at a time
+
+struct proc_struct *kswapd = NULL;
+size_t kswapd_low, kswapd_high;
+
+/* *
+ * The swap slot map. swap_map[offset] counts the references to a swap slot:
+ * the ptes holding its swap entry, the swap cache, and swap_out while it is
+ * writing the slot; the slot is free when the count is 0. swap_bitmap has a
+ * bit set for every slot in use, so that free slots are found a word at a
+ * time. Slots are handed out next-fit from swap_hint, so the clusters written
+ * one after another lie next to each other on the disk. Slot 0 is never used.
+ *
+ * The swap cache keeps a swapped in page together with its slot as long as
+ * the page may still equal the disk copy (swap_cache[offset] and
+ * page->swap_entry, with PG_swapcache set). swap_out drops such a page
+ * without writing it if its pte is not dirty, and a fault on another pte
+ * holding the same swap entry maps the same page instead of reading it again.
+ * A page is mapped read-only while other ptes hold its swap entry, so that a
+ * write goes through copy on write, which takes the page out of the cache.
+ * */
+static uint16_t *swap_map;
+static uint32_t *swap_bitmap;
+static struct Page **swap_cache;
+static size_t swap_hint, nr_free_slots;
+
+#define swap_slot_used(offset)      (swap_bitmap[(offset) / 32] & (1 << ((offset) % 32)))
+
+/* *
+ * Swap I/O is clustered: swap_out writes a victim together with the cold
+ * pages at the addresses next to it into a run of free slots, and swap_in
+ * reads the swapped out pages after the faulting one along with it, when
+ * their ptes hold the following swap entries. Either way a cluster moves in
+ * a single disk command.
+ *
+ * swap_out changes the ptes of a cluster to swap entries before writing it,
+ * so the process cannot change a page on its way to the disk. The pages are
+ * in the swap cache and have PG_writeback set meanwhile: a fault on one of
+ * them maps it back, and the page is freed when the write is done only if
+ * nobody did.
+ * */
+#define SWAP_CLUSTER                SWAPFS_MAX_CLUSTER
+
+static void
+swap_map_init(void) {
+     size_t nr_words = (max_swap_offset + 31) / 32, offset;
+     if ((swap_map = kmalloc(sizeof(uint16_t) * max_swap_offset)) == NULL
+          || (swap_bitmap = kmalloc(sizeof(uint32_t) * nr_words)) == NULL
+          || (swap_cache = kmalloc(sizeof(struct Page *) * max_swap_offset)) == NULL) {
+          panic("no memory for the swap map.\n");
+     }
+     memset(swap_map, 0, sizeof(uint16_t) * max_swap_offset);
+     memset(swap_bitmap, 0, sizeof(uint32_t) * nr_words);
+     memset(swap_cache, 0, sizeof(struct Page *) * max_swap_offset);
+     // slot 0 and the bits after the last slot are never free
+     for (offset = max_swap_offset; offset < nr_words * 32; offset ++) {
+          swap_bitmap[offset / 32] |= 1 << (offset % 32);
+     }
+     swap_bitmap[0] |= 1;
+     nr_free_slots = max_swap_offset - 1;
+     swap_hint = 1;
+}
 
 int
 swap_init(void)
@@ -40,14 +120,24 @@ swap_init(void)
      }
      
 
-     sm = &swap_manager_fifo;
+     sm = &swap_manager_clock;     // or &swap_manager_fifo
      int r = sm->init();
      
      if (r == 0)
      {
+          swap_map_init();
           swap_init_ok = 1;
           cprintf("SWAP: manager = %s\n", sm->name);
           // check_swap();
+
+          kswapd_low = (npage / 64 > 32) ? npage / 64 : 32;
+          kswapd_high = kswapd_low * 2;
+          int pid = kernel_thread(kswapd_main, NULL, 0);
+          if (pid <= 0) {
+               panic("create kswapd failed.\n");
+          }
+          kswapd = find_proc(pid);
+          set_proc_name(kswapd, "kswapd");
      }
 
      return r;
@@ -59,6 +149,12 @@ swap_init_mm(struct mm_struct *mm)
      return sm->init_mm(mm);
 }
 
+int
+swap_exit_mm(struct mm_struct *mm)
+{
+     return (sm->exit_mm != NULL) ? sm->exit_mm(mm) : 0;
+}
+
 int
 swap_tick_event(struct mm_struct *mm)
 {
@@ -68,6 +164,7 @@ swap_tick_event(struct mm_struct *mm)
 int
 swap_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int swap_in)
 {
+     page->pra_vaddr = addr;
      return sm->map_swappable(mm, addr, page, swap_in);
 }
 
@@ -79,64 +176,487 @@ swap_set_unswappable(struct mm_struct *mm, uintptr_t addr)
 
 volatile unsigned int swap_out_num=0;
 
+/* *
+ * swap_alloc - take a run of up to n free slots: the first run of n from
+ * swap_hint on, or else the longest one there is. Return the swap entry of
+ * its first slot and the number of slots in *nr_store, 0 if no slot is free.
+ * The caller holds a reference to each slot.
+ * */
+static swap_entry_t
+swap_alloc(size_t n, size_t *nr_store) {
+     size_t offset = swap_hint, scanned = 0, best = 0, best_n = 0, run, i;
+     while (nr_free_slots > 0 && scanned < max_swap_offset) {
+          if (offset >= max_swap_offset) {
+               offset = 1;
+          }
+          if (swap_bitmap[offset / 32] == 0xFFFFFFFF) {
+               run = 32 - offset % 32;
+               offset += run, scanned += run;
+               continue;
+          }
+          if (swap_slot_used(offset)) {
+               offset ++, scanned ++;
+               continue;
+          }
+          for (run = 1; run < n && offset + run < max_swap_offset && !swap_slot_used(offset + run); run ++)
+               /* nothing */ ;
+          if (run > best_n) {
+               best = offset, best_n = run;
+               if (run == n) {
+                    break;
+               }
+          }
+          offset += run, scanned += run;
+     }
+     for (i = 0; i < best_n; i ++) {
+          swap_map[best + i] = 1;
+          swap_bitmap[(best + i) / 32] |= 1 << ((best + i) % 32);
+     }
+     nr_free_slots -= best_n;
+     swap_hint = best + best_n;
+     *nr_store = best_n;
+     return best << 8;
+}
+
+// swap_duplicate - one more pte holds the swap entry
+void
+swap_duplicate(swap_entry_t entry) {
+     size_t offset = swap_offset(entry);
+     assert(swap_map[offset] > 0 && swap_map[offset] < 0xFFFF);
+     swap_map[offset] ++;
+}
+
+// swap_free - drop a reference to the slot of the swap entry, the slot is free with the last one
+void
+swap_free(swap_entry_t entry) {
+     size_t offset = swap_offset(entry);
+     assert(swap_map[offset] > 0);
+     if (-- swap_map[offset] == 0) {
+          assert(swap_cache[offset] == NULL);
+          swap_bitmap[offset / 32] &= ~(1 << (offset % 32));
+          nr_free_slots ++;
+     }
+}
+
+static inline struct Page *
+swap_cache_find(swap_entry_t entry) {
+     return swap_cache[swap_offset(entry)];
+}
+
+static void
+swap_cache_add(struct Page *page, swap_entry_t entry) {
+     size_t offset = swap_offset(entry);
+     assert(swap_cache[offset] == NULL && !PageSwapCache(page));
+     swap_map[offset] ++;
+     swap_cache[offset] = page, page->swap_entry = entry;
+     SetPageSwapCache(page);
+}
+
+// swap_cache_del - take the page out of the swap cache, and drop its reference to the slot
+void
+swap_cache_del(struct Page *page) {
+     assert(PageSwapCache(page));
+     swap_entry_t entry = page->swap_entry;
+     swap_cache[swap_offset(entry)] = NULL;
+     ClearPageSwapCache(page);
+     swap_free(entry);
+}
+
+/* *
+ * swap_cold_page - the page at la of mm if it can join a cluster: it is on the
+ * replacement list, not shared, not being written, and not accessed since the
+ * clock hand cleared PTE_A. Its pte is stored in *ptep_store.
+ * */
+static struct Page *
+swap_cold_page(struct mm_struct *mm, uintptr_t la, pte_t **ptep_store) {
+     pte_t *ptep;
+     if (la < PGSIZE || (ptep = get_pte(mm->pgdir, la, 0)) == NULL || !(*ptep & PTE_P) || (*ptep & PTE_A)) {
+          return NULL;
+     }
+     struct Page *page = pte2page(*ptep);
+     if (!PageSwap(page) || PageWriteback(page) || page_ref(page) != 1 || page->pra_vaddr != la) {
+          return NULL;
+     }
+     *ptep_store = ptep;
+     return page;
+}
+
+/* *
+ * swap_out_cluster - swap out victim and up to max - 1 cold pages around it,
+ * return how many were freed. Clean pages of the swap cache are just dropped,
+ * the others are written to a run of free slots in one disk command.
+ * */
+static int
+swap_out_cluster(struct mm_struct *mm, struct Page *victim, size_t max) {
+     struct Page *pages[SWAP_CLUSTER];
+     pte_t *pteps[SWAP_CLUSTER], ptes[SWAP_CLUSTER], *ptep;
+     uintptr_t v = victim->pra_vaddr, start = v, la;
+     size_t n, nr_write = 0, nr_freed = 0, i;
+
+     if (PageWriteback(victim)) {
+          sm->map_swappable(mm, v, victim, 0);
+          return 0;
+     }
+     // grow the cluster backwards, then forwards
+     while ((v - start) / PGSIZE + 1 < max && swap_cold_page(mm, start - PGSIZE, &ptep) != NULL) {
+          start -= PGSIZE;
+     }
+     for (n = 0, la = start; n < max; n ++, la += PGSIZE) {
+          if (la == v) {
+               pages[n] = victim, pteps[n] = get_pte(mm->pgdir, v, 0);
+               continue;
+          }
+          if ((pages[n] = swap_cold_page(mm, la, &(pteps[n]))) == NULL) {
+               break;
+          }
+          list_del(&(pages[n]->pra_page_link));
+          ClearPageSwap(pages[n]);
+     }
+
+     // the clean pages of the swap cache go now, the others stay in pages[0, nr_write)
+     for (i = 0; i < n; i ++) {
+          struct Page *page = pages[i];
+          assert((*pteps[i] & PTE_P) != 0);
+          if (PageFileCache(page)) {
+               // filemap_fault reads it again, after it goes back to the file if a shared vma wrote it
+               if (*pteps[i] & PTE_D) {
+                    // clean before the write as filemap_sync does, so that a write during it makes
+                    // the page dirty again; PG_writeback keeps an unmap meanwhile from freeing it
+                    *pteps[i] &= ~PTE_D;
+                    tlb_invalidate(mm->pgdir, page->pra_vaddr);
+                    SetPageWriteback(page);
+                    int r = filemap_writepage(page);
+                    ClearPageWriteback(page);
+                    if (!(*pteps[i] & PTE_P) || pte2page(*pteps[i]) != page) {
+                         // unmapped during the write
+                         if (page_ref(page) == 0) {
+                              filemap_del(page);
+                              free_page(page);
+                              nr_freed ++;
+                         }
+                         continue;
+                    }
+                    if (r != 0 || (*pteps[i] & PTE_D)) {
+                         // keep it mapped, and dirty if the write failed, so that no data is lost
+                         if (r != 0) {
+                              *pteps[i] |= PTE_D;
+                              cprintf("swap_out: failed to write a page back to its file\n");
+                         }
+                         if (!PageSwap(page)) {
+                              sm->map_swappable(mm, page->pra_vaddr, page, 0);
+                         }
+                         continue;
+                    }
+               }
+               *pteps[i] = 0;
+               tlb_invalidate(mm->pgdir, page->pra_vaddr);
+               if (page_ref_dec(page) == 0) {
+                    filemap_del(page);
+                    free_page(page);
+                    nr_freed ++;
+               }
+               continue;
+          }
+          if (PageSwapCache(page)) {
+               if (!(*pteps[i] & PTE_D)) {
+                    swap_duplicate(page->swap_entry);
+                    *pteps[i] = page->swap_entry;
+                    tlb_invalidate(mm->pgdir, page->pra_vaddr);
+                    page_ref_dec(page);
+                    swap_cache_del(page);
+                    free_page(page);
+                    nr_freed ++;
+                    continue;
+               }
+               // changed since it was read, the disk copy is stale
+               swap_cache_del(page);
+          }
+          pages[nr_write] = page, pteps[nr_write] = pteps[i], nr_write ++;
+     }
+     if (nr_write == 0) {
+          return nr_freed;
+     }
+
+     size_t nr_slots;
+     swap_entry_t entry = swap_alloc(nr_write, &nr_slots);
+     for (i = nr_slots; i < nr_write; i ++) {
+          sm->map_swappable(mm, pages[i]->pra_vaddr, pages[i], 0);
+     }
+     if ((nr_write = nr_slots) == 0) {
+          cprintf("swap_out: no free swap slot\n");
+          return nr_freed;
+     }
+
+     for (i = 0; i < nr_write; i ++) {
+          struct Page *page = pages[i];
+          swap_cache_add(page, entry + (i << 8));
+          SetPageWriteback(page);
+          ptes[i] = *pteps[i];
+          swap_duplicate(entry + (i << 8));
+          *pteps[i] = entry + (i << 8);
+          tlb_invalidate(mm->pgdir, page->pra_vaddr);
+          page_ref_dec(page);
+     }
+     int r = swapfs_write_cluster(entry, pages, nr_write);
+     for (i = 0; i < nr_write; i ++) {
+          struct Page *page = pages[i];
+          ClearPageWriteback(page);
+          if (page_ref(page) == 0) {
+               if (r != 0 && *pteps[i] == entry + (i << 8)) {
+                    // the write failed, map the page again
+                    *pteps[i] = ptes[i];
+                    tlb_invalidate(mm->pgdir, page->pra_vaddr);
+                    page_ref_inc(page);
+                    swap_free(entry + (i << 8));
+                    if (PageSwapCache(page)) {
+                         swap_cache_del(page);
+                    }
+                    sm->map_swappable(mm, page->pra_vaddr, page, 0);
+               }
+               else {
+                    if (PageSwapCache(page)) {
+                         swap_cache_del(page);
+                    }
+                    free_page(page);
+                    nr_freed ++;
+               }
+          }
+          // else a fault has mapped the page again during the write, it stays
+          swap_free(entry + (i << 8));
+     }
+     if (r != 0) {
+          cprintf("SWAP: failed to save\n");
+     }
+     else {
+          cprintf("swap_out: store %d pages in vaddr 0x%x to disk swap entry %d\n", nr_write, pages[0]->pra_vaddr, entry >> 8);
+     }
+     return nr_freed;
+}
+
 int
 swap_out(struct mm_struct *mm, int n, int in_tick)
 {
-     int i;
-     for (i = 0; i != n; ++ i)
+     int i = 0, r;
+     while (i < n)
      {
-          uintptr_t v;
-          //struct Page **ptr_page=NULL;
           struct Page *page;
-          // cprintf("i %d, SWAP: call swap_out_victim\n",i);
-          int r = sm->swap_out_victim(mm, &page, in_tick);
-          if (r != 0) {
-                    cprintf("i %d, swap_out: call swap_out_victim failed\n",i);
-                  break;
-          }          
-          //assert(!PageReserved(page));
-
-          //cprintf("SWAP: choose victim page 0x%08x\n", page);
-          
-          v=page->pra_vaddr; 
-          pte_t *ptep = get_pte(mm->pgdir, v, 0);
-          assert((*ptep & PTE_P) != 0);
-
-          if (swapfs_write( (page->pra_vaddr/PGSIZE+1)<<8, page) != 0) {
-                    cprintf("SWAP: failed to save\n");
-                    sm->map_swappable(mm, v, page, 0);
-                    continue;
+          if ((r = sm->swap_out_victim(mm, &page, in_tick)) != 0) {
+               cprintf("i %d, swap_out: call swap_out_victim failed\n",i);
+               break;
           }
-          else {
-                    cprintf("swap_out: i %d, store page in vaddr 0x%x to disk swap entry %d\n", i, v, page->pra_vaddr/PGSIZE+1);
-                    *ptep = (page->pra_vaddr/PGSIZE+1)<<8;
-                    free_page(page);
+          if ((r = swap_out_cluster(mm, page, (n - i < SWAP_CLUSTER) ? n - i : SWAP_CLUSTER)) == 0) {
+               break;
           }
-          
-          tlb_invalidate(mm->pgdir, v);
+          i += r;
      }
      return i;
 }
 
+// swap_pick_mm - the mms of the processes, at most KSWAPD_NR_MM with the lowest fault rate, lowest first
+static int
+swap_pick_mm(struct mm_struct *mms[]) {
+     int nr = 0, i;
+     list_entry_t *le = &proc_list;
+     while ((le = list_next(le)) != &proc_list) {
+          struct mm_struct *mm = le2proc(le, list_link)->mm;
+          if (mm == NULL || mm->sm_priv == NULL) {
+               continue;
+          }
+          for (i = 0; i < nr && mms[i] != mm; i ++)
+               /* threads share their mm */ ;
+          if (i < nr) {
+               continue;
+          }
+          uint32_t rate = mm_fault_rate(mm);
+          if (nr == KSWAPD_NR_MM) {
+               if (rate >= mm_fault_rate(mms[nr - 1])) {
+                    continue;
+               }
+               nr --;
+          }
+          for (i = nr; i > 0 && mm_fault_rate(mms[i - 1]) > rate; i --) {
+               mms[i] = mms[i - 1];
+          }
+          mms[i] = mm, nr ++;
+     }
+     return nr;
+}
+
+/* *
+ * try_free_pages - swap out up to n pages, from the least active mms first,
+ * and return how many were freed. A mm locked by a syscall (lock_mm) is left
+ * alone, its pages may be in use by the kernel. swap_out sleeps on the disk,
+ * so the mms are held meanwhile: if the owner exits, the last put_mm here
+ * frees the memory space.
+ * */
+size_t
+try_free_pages(size_t n) {
+     struct mm_struct *mms[KSWAPD_NR_MM];
+     int nr_mm = swap_pick_mm(mms), i, r;
+     size_t freed = 0;
+     for (i = 0; i < nr_mm; i ++) {
+          mm_count_inc(mms[i]);
+     }
+     for (i = 0; i < nr_mm && freed < n; i ++) {
+          struct mm_struct *mm = mms[i];
+          if (!try_down(&(mm->mm_sem))) {
+               continue;
+          }
+          do {
+               // a whole cluster even if fewer pages are asked for, it costs one disk command
+               r = swap_out(mm, KSWAPD_CLUSTER, 0);
+               freed += r;
+          } while (r > 0 && freed < n);
+          up(&(mm->mm_sem));
+     }
+     for (i = 0; i < nr_mm; i ++) {
+          put_mm(mms[i]);
+     }
+     return freed;
+}
+
+// kswapd_wakeup - called by alloc_pages, wake kswapd if the free pages run low
+void
+kswapd_wakeup(void) {
+     if (kswapd != NULL && kswapd->wait_state == WT_KSWAPD && nr_free_pages() < kswapd_low) {
+          wakeup_proc(kswapd);
+          // let it run as soon as the current process leaves the kernel
+          if (current != NULL) {
+               current->need_resched = 1;
+          }
+     }
+}
+
+static int
+kswapd_main(void *arg) {
+     while (1) {
+          size_t nr_free = nr_free_pages();
+          if (nr_free < kswapd_high) {
+               try_free_pages(kswapd_high - nr_free);
+          }
+          bool intr_flag;
+          local_intr_save(intr_flag);
+          {
+               current->state = PROC_SLEEPING;
+               current->wait_state = WT_KSWAPD;
+          }
+          local_intr_restore(intr_flag);
+          schedule();
+     }
+     return 0;
+}
+
+/* *
+ * swap_in - get the page of the swap entry in the pte of addr: from the swap
+ * cache, or else read it, along with the pages after addr in the same vma
+ * whose ptes hold the next swap entries (not when memory is low). Those are
+ * mapped right away, without PTE_A so that the clock hand takes them first
+ * if they are not used. The pages read stay in the swap cache. *ptr_result
+ * is NULL if the pte changed while swap_in slept.
+ * */
 int
 swap_in(struct mm_struct *mm, uintptr_t addr, struct Page **ptr_result)
 {
-     struct Page *result = alloc_page();
-     assert(result!=NULL);
-
+     struct Page *pages[SWAP_CLUSTER], *page;
      pte_t *ptep = get_pte(mm->pgdir, addr, 0);
-     // cprintf("SWAP: load ptep %x swap entry %d to vaddr 0x%08x, page %x, No %d\n", ptep, (*ptep)>>8, addr, result, (result-pages));
-    
+     swap_entry_t entry = *ptep;
+     size_t n = 1, i;
+
+     *ptr_result = NULL;
+     if ((page = swap_cache_find(entry)) != NULL) {
+          *ptr_result = page;
+          return 0;
+     }
+     if ((pages[0] = alloc_page()) == NULL) {
+          return -E_NO_MEM;
+     }
+     // alloc_page may have swapped out pages and slept
+     if (*ptep != entry || (page = swap_cache_find(entry)) != NULL) {
+          free_page(pages[0]);
+          *ptr_result = page;
+          return 0;
+     }
+
+     uint32_t perm = PTE_U;
+     struct vma_struct *vma = find_vma(mm, addr);
+     if (vma != NULL && nr_free_pages() > kswapd_low) {
+          if (vma->vm_flags & VM_WRITE) {
+               perm |= PTE_W;
+          }
+          uintptr_t la = addr + PGSIZE;
+          for (; n < SWAP_CLUSTER && la < vma->vm_end; n ++, la += PGSIZE) {
+               pte_t *nptep = get_pte(mm->pgdir, la, 0);
+               if (nptep == NULL || *nptep != entry + (n << 8) || swap_cache_find(*nptep) != NULL) {
+                    break;
+               }
+               if ((pages[n] = alloc_page()) == NULL) {
+                    break;
+               }
+          }
+     }
+
      int r;
-     if ((r = swapfs_read((*ptep), result)) != 0)
-     {
-        assert(r!=0);
+     if ((r = swapfs_read_cluster(entry, pages, n)) != 0) {
+          for (i = 0; i < n; i ++) {
+               free_page(pages[i]);
+          }
+          return r;
      }
-     cprintf("swap_in: load disk swap entry %d with swap_page in vadr 0x%x\n", (*ptep)>>8, addr);
-     *ptr_result=result;
+     cprintf("swap_in: load disk swap entry %d with %d pages in vadr 0x%x\n", entry >> 8, n, addr);
+     for (i = 0; i < n; i ++) {
+          swap_entry_t e = entry + (i << 8);
+          if (swap_map[swap_offset(e)] == 0) {
+               // every pte holding it is gone
+               free_page(pages[i]), pages[i] = NULL;
+          }
+          else if ((page = swap_cache_find(e)) != NULL) {
+               // read by another fault meanwhile
+               free_page(pages[i]), pages[i] = page;
+          }
+          else {
+               swap_cache_add(pages[i], e);
+          }
+     }
+     for (i = 1; i < n; i ++) {
+          if (pages[i] != NULL) {
+               swap_map_page(mm, addr + i * PGSIZE, pages[i], perm);
+          }
+     }
+     *ptr_result = pages[0];
      return 0;
 }
 
+/* *
+ * swap_map_page - map page, which swap_in got for the swap entry in the pte of
+ * la, at la. If the pte has changed meanwhile, a page nobody maps leaves the
+ * swap cache and is freed.
+ * */
+int
+swap_map_page(struct mm_struct *mm, uintptr_t la, struct Page *page, uint32_t perm) {
+     pte_t *ptep = get_pte(mm->pgdir, la, 0);
+     assert(PageSwapCache(page));
+     if (ptep == NULL || *ptep != page->swap_entry) {
+          if (page_ref(page) == 0 && !PageWriteback(page)) {
+               swap_cache_del(page);
+               free_page(page);
+          }
+          return 0;
+     }
+     // other ptes hold the swap entry (besides this one and the swap cache), or map the page
+     if (swap_map[swap_offset(page->swap_entry)] > 2 || page_ref(page) > 0) {
+          perm &= ~PTE_W;
+     }
+     int ret;
+     if ((ret = page_insert(mm->pgdir, page, la, perm)) == 0) {
+          swap_map_swappable(mm, la, page, 1);
+     }
+     else if (page_ref(page) == 0 && !PageWriteback(page)) {
+          swap_cache_del(page);
+          free_page(page);
+     }
+     return ret;
+}
+
 
 
 static inline void
@@ -189,6 +709,7 @@ check_swap(void)
      }
      assert(total == nr_free_pages());
      cprintf("BEGIN check_swap: count %d, total %d\n",count,total);
+     size_t nr_free_slots_store = nr_free_slots;
      
      //now we set the phy pages env     
      struct mm_struct *mm = mm_create();
@@ -256,6 +777,22 @@ check_swap(void)
      ret=check_content_access();
      assert(ret==0);
      
+     //give back the swap slots and the swap cache
+     uintptr_t la;
+     for (la = BEING_CHECK_VALID_VADDR; la < CHECK_VALID_VADDR; la += PGSIZE) {
+         pte_t *ptep = get_pte(pgdir, la, 0);
+         if (*ptep & PTE_P) {
+             if (PageSwapCache(pte2page(*ptep))) {
+                 swap_cache_del(pte2page(*ptep));
+             }
+         }
+         else if (*ptep != 0) {
+             swap_free(*ptep);
+         }
+         *ptep = 0;
+     }
+     assert(nr_free_slots == nr_free_slots_store);
+
      //restore kernel mem env
      for (i=0;i<CHECK_VALID_PHY_PAGE_NUM;i++) {
          free_pages(check_rp[i],1);
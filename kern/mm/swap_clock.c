@@ -0,0 +1,266 @@
+#include <defs.h>
+#include <x86.h>
+#include <stdio.h>
+#include <string.h>
+#include <error.h>
+#include <swap.h>
+#include <swap_clock.h>
+#include <list.h>
+#include <kmalloc.h>
+
+/* The Extended CLOCK (enhanced second chance) PRA ranks the resident pages of
+ * a mm by the accessed (PTE_A) and dirty (PTE_D) bits of their ptes:
+ *      (A=0, D=0)  not used lately, clean      -- the best victim
+ *      (A=0, D=1)  not used lately, dirty
+ *      (A=1, D=0)  used lately, clean
+ *      (A=1, D=1)  used lately, dirty          -- the worst victim
+ * The swappable pages of a mm sit on a circular list (pra_page_link), and the
+ * clock hand is at its head: moving the hand past a page moves the page to
+ * the tail. To find a victim the hand goes round at most four times:
+ *  (1) looking for (0,0), changing nothing;
+ *  (2) looking for (0,1), clearing A of every page it passes;
+ *  (3) and (4) like (1) and (2) again, now that all A bits are clear.
+ * So a page in use keeps a second chance, and a clean page goes before a
+ * dirty one of the same use.
+ *
+ * On the timer tick the running mm is aged every CLOCK_AGE_TICKS ticks: every
+ * page with A set gets it cleared and moves behind the hand, so the pages not
+ * touched since the last aging collect in front of the hand.
+ *
+ * A page is on the list while PG_swap is set. A page freed when its last
+ * mapping goes away leaves the list in page_remove_pte; one that a mm no longer
+ * maps (its copy-on-write copy replaced it) is dropped when the hand finds it,
+ * and a page shared by several mms is passed over, since it cannot be swapped
+ * out from one of them.
+ */
+
+#define CLOCK_AGE_TICKS             100     // age the running mm every 100 ticks
+
+struct clock_mm {
+    list_entry_t pra_list;                  // swappable pages, the hand is at the head
+    int age_ticks;                          // ticks until the next aging
+};
+
+#define clock_head(mm)              (&(((struct clock_mm *)((mm)->sm_priv))->pra_list))
+
+// clock_pte - the pte of page in mm, NULL if mm does not map the page any more
+static pte_t *
+clock_pte(struct mm_struct *mm, struct Page *page) {
+    pte_t *ptep = get_pte(mm->pgdir, page->pra_vaddr, 0);
+    if (ptep != NULL && (*ptep & PTE_P) && pte2page(*ptep) == page) {
+        return ptep;
+    }
+    return NULL;
+}
+
+static inline void
+clock_unlink(struct Page *page) {
+    list_del(&(page->pra_page_link));
+    ClearPageSwap(page);
+}
+
+// clock_pass - move the hand past page
+static inline void
+clock_pass(list_entry_t *head, struct Page *page) {
+    list_del(&(page->pra_page_link));
+    list_add_before(head, &(page->pra_page_link));
+}
+
+static inline size_t
+clock_nr_pages(list_entry_t *head) {
+    size_t n = 0;
+    list_entry_t *le = head;
+    while ((le = list_next(le)) != head) {
+        n ++;
+    }
+    return n;
+}
+
+static int
+_clock_init(void)
+{
+    return 0;
+}
+
+static int
+_clock_init_mm(struct mm_struct *mm)
+{
+    struct clock_mm *cm;
+    if ((cm = kmalloc(sizeof(struct clock_mm))) == NULL) {
+        mm->sm_priv = NULL;
+        return -E_NO_MEM;
+    }
+    list_init(&(cm->pra_list));
+    cm->age_ticks = CLOCK_AGE_TICKS;
+    mm->sm_priv = cm;
+    return 0;
+}
+
+static int
+_clock_exit_mm(struct mm_struct *mm)
+{
+    list_entry_t *head = clock_head(mm), *le;
+    while ((le = list_next(head)) != head) {
+        clock_unlink(le2page(le, pra_page_link));
+    }
+    kfree(mm->sm_priv);
+    mm->sm_priv = NULL;
+    return 0;
+}
+
+/*
+ * _clock_tick_event: clear the accessed bits of the running mm, the pages that
+ *                    had it set go behind the hand.
+ */
+static int
+_clock_tick_event(struct mm_struct *mm)
+{
+    struct clock_mm *cm = mm->sm_priv;
+    if (cm == NULL || -- cm->age_ticks > 0) {
+        return 0;
+    }
+    cm->age_ticks = CLOCK_AGE_TICKS;
+
+    list_entry_t *head = &(cm->pra_list), *le = list_next(head);
+    size_t n = clock_nr_pages(head);
+    for (; n > 0; n --) {
+        struct Page *page = le2page(le, pra_page_link);
+        pte_t *ptep = clock_pte(mm, page);
+        le = list_next(le);
+        if (ptep == NULL) {
+            clock_unlink(page);
+        }
+        else if (*ptep & PTE_A) {
+            *ptep &= ~PTE_A;
+            tlb_invalidate(mm->pgdir, page->pra_vaddr);
+            clock_pass(head, page);
+        }
+    }
+    return 0;
+}
+
+/*
+ * _clock_map_swappable: a newly mapped page goes right behind the hand, i.e.
+ *                       it is the last the hand will reach.
+ */
+static int
+_clock_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int swap_in)
+{
+    if (mm->sm_priv == NULL) {
+        return -E_NO_MEM;
+    }
+    if (PageSwap(page)) {
+        list_del(&(page->pra_page_link));
+    }
+    list_add_before(clock_head(mm), &(page->pra_page_link));
+    SetPageSwap(page);
+    return 0;
+}
+
+static int
+_clock_set_unswappable(struct mm_struct *mm, uintptr_t addr)
+{
+    return 0;
+}
+
+/*
+ * _clock_swap_out_victim: go round the clock at most four times, see above.
+ */
+static int
+_clock_swap_out_victim(struct mm_struct *mm, struct Page ** ptr_page, int in_tick)
+{
+    if (mm->sm_priv == NULL) {
+        return -E_NO_MEM;
+    }
+    list_entry_t *head = clock_head(mm);
+    int round;
+    for (round = 0; round < 4; round ++) {
+        bool take_dirty = (round % 2 == 1);
+        list_entry_t *le = list_next(head);
+        size_t n = clock_nr_pages(head);
+        for (; n > 0; n --) {
+            struct Page *page = le2page(le, pra_page_link);
+            pte_t *ptep = clock_pte(mm, page);
+            le = list_next(le);
+            if (ptep == NULL) {
+                clock_unlink(page);
+                continue;
+            }
+            if (page_ref(page) == 1 && !PageWriteback(page) && !(*ptep & PTE_A) && (take_dirty || !(*ptep & PTE_D))) {
+                clock_unlink(page);
+                *ptr_page = page;
+                return 0;
+            }
+            if (take_dirty && (*ptep & PTE_A)) {
+                *ptep &= ~PTE_A;
+                tlb_invalidate(mm->pgdir, page->pra_vaddr);
+            }
+            clock_pass(head, page);
+        }
+    }
+    return -E_NO_MEM;
+}
+
+/*
+ * Expects the layout of check_swap in swap.c: virtual pages a~e at 0x1000~0x5000
+ * over 4 physical pages, a~d written in this order before.
+ */
+static int
+_clock_check_swap(void) {
+    cprintf("write Virt Page c in clock_check_swap\n");
+    *(unsigned char *)0x3000 = 0x0c;
+    assert(pgfault_num==4);
+    cprintf("write Virt Page a in clock_check_swap\n");
+    *(unsigned char *)0x1000 = 0x0a;
+    assert(pgfault_num==4);
+    cprintf("write Virt Page d in clock_check_swap\n");
+    *(unsigned char *)0x4000 = 0x0d;
+    assert(pgfault_num==4);
+    cprintf("write Virt Page b in clock_check_swap\n");
+    *(unsigned char *)0x2000 = 0x0b;
+    assert(pgfault_num==4);
+    // all used and dirty: the A bits are cleared in round 2, a is taken in round 4
+    cprintf("write Virt Page e in clock_check_swap\n");
+    *(unsigned char *)0x5000 = 0x0e;
+    assert(pgfault_num==5);
+    cprintf("write Virt Page b in clock_check_swap\n");
+    *(unsigned char *)0x2000 = 0x0b;
+    assert(pgfault_num==5);
+    // b has been used again since, c has not: c is taken
+    cprintf("write Virt Page a in clock_check_swap\n");
+    assert(*(unsigned char *)0x1000 == 0x0a);
+    *(unsigned char *)0x1000 = 0x0a;
+    assert(pgfault_num==6);
+    cprintf("write Virt Page b in clock_check_swap\n");
+    *(unsigned char *)0x2000 = 0x0b;
+    assert(pgfault_num==6);
+    cprintf("write Virt Page c in clock_check_swap\n");
+    *(unsigned char *)0x3000 = 0x0c;
+    assert(pgfault_num==7);
+    cprintf("write Virt Page d in clock_check_swap\n");
+    *(unsigned char *)0x4000 = 0x0d;
+    assert(pgfault_num==8);
+    cprintf("write Virt Page e in clock_check_swap\n");
+    *(unsigned char *)0x5000 = 0x0e;
+    assert(pgfault_num==9);
+    // a was brought back last but one, b is older
+    cprintf("write Virt Page a in clock_check_swap\n");
+    assert(*(unsigned char *)0x1000 == 0x0a);
+    *(unsigned char *)0x1000 = 0x0a;
+    assert(pgfault_num==9);
+    return 0;
+}
+
+
+struct swap_manager swap_manager_clock =
+{
+     .name            = "extended clock swap manager",
+     .init            = &_clock_init,
+     .init_mm         = &_clock_init_mm,
+     .exit_mm         = &_clock_exit_mm,
+     .tick_event      = &_clock_tick_event,
+     .map_swappable   = &_clock_map_swappable,
+     .set_unswappable = &_clock_set_unswappable,
+     .swap_out_victim = &_clock_swap_out_victim,
+     .check_swap      = &_clock_check_swap,
+};
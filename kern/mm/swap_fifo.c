@@ -51,7 +51,11 @@ _fifo_map_swappable(struct mm_struct *mm, uintptr_t addr, struct Page *page, int
     //record the page access situlation
     /*LAB3 EXERCISE 2: YOUR CODE*/ 
     //(1)link the most recent arrival page at the back of the pra_list_head qeueue.
+    if (PageSwap(page)) {
+        list_del(entry);
+    }
     list_add(head, entry);
+    SetPageSwap(page);
     return 0;
 }
 /*
@@ -73,6 +77,7 @@ _fifo_swap_out_victim(struct mm_struct *mm, struct Page ** ptr_page, int in_tick
      assert(head!=le);
      struct Page *p = le2page(le, pra_page_link);
      list_del(le);
+     ClearPageSwap(p);
      assert(p !=NULL);
      *ptr_page = p;
      return 0;
@@ -8,12 +8,18 @@
 #include <x86.h>
 #include <swap.h>
 #include <kmalloc.h>
+#include <clock.h>
+#include <inode.h>
+#include <filemap.h>
 
 /* 
   vmm design include two parts: mm_struct (mm) & vma_struct (vma)
   mm is the memory manager for the set of continuous virtual memory  
   area which have the same PDT. vma is a continuous virtual memory area.
   There a linear link list for vma & a redblack link list for vma in mm.
+  The list keeps the vmas in address order for walking all of them, the
+  tree (mm->mmap_tree, also sorted by vm_start) is used for lookups, so
+  find_vma and insert_vma_struct are O(log n) in the number of vmas.
 ---------------
   mm related functions:
    golbal functions
@@ -35,20 +41,42 @@
      void check_pgfault(void);
 */
 
+// the slab caches mm_structs and vma_structs come from
+static struct kmem_cache *mm_cachep, *vma_cachep;
+
 static void check_vmm(void);
 static void check_vma_struct(void);
 static void check_pgfault(void);
 
+// vma_compare - order of vmas in mm->mmap_tree
+static int
+vma_compare(rb_node *node1, rb_node *node2) {
+    uintptr_t start1 = rbn2vma(node1, rb_link)->vm_start;
+    uintptr_t start2 = rbn2vma(node2, rb_link)->vm_start;
+    return (start1 < start2) ? -1 : (start1 > start2) ? 1 : 0;
+}
+
+// vma_compare_addr - where addr is against the vma of node, 0 if vm_start <= addr < vm_end
+static int
+vma_compare_addr(rb_node *node, void *key) {
+    struct vma_struct *vma = rbn2vma(node, rb_link);
+    uintptr_t addr = (uintptr_t)key;
+    return (addr < vma->vm_start) ? -1 : (addr >= vma->vm_end) ? 1 : 0;
+}
+
 // mm_create -  alloc a mm_struct & initialize it.
 struct mm_struct *
 mm_create(void) {
-    struct mm_struct *mm = kmalloc(sizeof(struct mm_struct));
+    struct mm_struct *mm = kmem_cache_alloc(mm_cachep);
 
     if (mm != NULL) {
         list_init(&(mm->mmap_list));
+        rb_tree_init(&(mm->mmap_tree), vma_compare);
         mm->mmap_cache = NULL;
         mm->pgdir = NULL;
         mm->map_count = 0;
+        mm->fault_rate = 0;
+        mm->fault_stamp = ticks;
 
         if (swap_init_ok) swap_init_mm(mm);
         else mm->sm_priv = NULL;
@@ -62,16 +90,35 @@ mm_create(void) {
 // vma_create - alloc a vma_struct & initialize it. (addr range: vm_start~vm_end)
 struct vma_struct *
 vma_create(uintptr_t vm_start, uintptr_t vm_end, uint32_t vm_flags) {
-    struct vma_struct *vma = kmalloc(sizeof(struct vma_struct));
+    struct vma_struct *vma = kmem_cache_alloc(vma_cachep);
 
     if (vma != NULL) {
         vma->vm_start = vm_start;
         vma->vm_end = vm_end;
         vma->vm_flags = vm_flags;
+        vma->vm_file = NULL;
     }
     return vma;
 }
 
+// vma_destroy - free a vma, and its reference to the file it maps
+static void
+vma_destroy(struct vma_struct *vma) {
+    if (vma->vm_file != NULL) {
+        vop_ref_dec(vma->vm_file);
+    }
+    kmem_cache_free(vma_cachep, vma);
+}
+
+// vma_set_file - make [start, end) of vma map node from offset on
+static void
+vma_set_file(struct vma_struct *vma, struct inode *node, off_t offset, uintptr_t start, uintptr_t end) {
+    vop_ref_inc(node);
+    vma->vm_file = node;
+    vma->vm_file_off = offset;
+    vma->vm_file_start = start, vma->vm_file_end = end;
+}
+
 
 // find_vma - find a vma  (vma->vm_start <= addr <= vma_vm_end)
 struct vma_struct *
@@ -80,18 +127,8 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
     if (mm != NULL) {
         vma = mm->mmap_cache;
         if (!(vma != NULL && vma->vm_start <= addr && vma->vm_end > addr)) {
-                bool found = 0;
-                list_entry_t *list = &(mm->mmap_list), *le = list;
-                while ((le = list_next(le)) != list) {
-                    vma = le2vma(le, list_link);
-                    if (vma->vm_start<=addr && addr < vma->vm_end) {
-                        found = 1;
-                        break;
-                    }
-                }
-                if (!found) {
-                    vma = NULL;
-                }
+            rb_node *node = rb_search(&(mm->mmap_tree), vma_compare_addr, (void *)addr);
+            vma = (node != NULL) ? rbn2vma(node, rb_link) : NULL;
         }
         if (vma != NULL) {
             mm->mmap_cache = vma;
@@ -101,6 +138,25 @@ find_vma(struct mm_struct *mm, uintptr_t addr) {
 }
 
 
+// find_vma_intersection - find the vma with the lowest address that overlaps [start, end)
+struct vma_struct *
+find_vma_intersection(struct mm_struct *mm, uintptr_t start, uintptr_t end) {
+    struct vma_struct *vma = NULL;
+    rb_tree *tree = &(mm->mmap_tree);
+    rb_node *node = tree->root;
+    // the lowest vma that ends above start
+    while (node != &(tree->nil)) {
+        struct vma_struct *tmp = rbn2vma(node, rb_link);
+        if (tmp->vm_end > start) {
+            vma = tmp, node = node->left;
+        }
+        else {
+            node = node->right;
+        }
+    }
+    return (vma != NULL && vma->vm_start < end) ? vma : NULL;
+}
+
 // check_vma_overlap - check if vma1 overlaps vma2 ?
 static inline void
 check_vma_overlap(struct vma_struct *prev, struct vma_struct *next) {
@@ -110,21 +166,19 @@ check_vma_overlap(struct vma_struct *prev, struct vma_struct *next) {
 }
 
 
-// insert_vma_struct -insert vma in mm's list link
+// insert_vma_struct -insert vma in mm's list link and rb tree
 void
 insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
     assert(vma->vm_start < vma->vm_end);
     list_entry_t *list = &(mm->mmap_list);
     list_entry_t *le_prev = list, *le_next;
 
-        list_entry_t *le = list;
-        while ((le = list_next(le)) != list) {
-            struct vma_struct *mmap_prev = le2vma(le, list_link);
-            if (mmap_prev->vm_start > vma->vm_start) {
-                break;
-            }
-            le_prev = le;
-        }
+    // the tree finds the predecessor, the list link goes right after it
+    rb_insert(&(mm->mmap_tree), &(vma->rb_link));
+    rb_node *node_prev = rb_node_prev(&(mm->mmap_tree), &(vma->rb_link));
+    if (node_prev != NULL) {
+        le_prev = &(rbn2vma(node_prev, rb_link)->list_link);
+    }
 
     le_next = list_next(le_prev);
 
@@ -142,6 +196,18 @@ insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
     mm->map_count ++;
 }
 
+// remove_vma_struct - take vma out of mm's list link and rb tree, and free it
+static void
+remove_vma_struct(struct mm_struct *mm, struct vma_struct *vma) {
+    list_del(&(vma->list_link));
+    rb_delete(&(mm->mmap_tree), &(vma->rb_link));
+    if (mm->mmap_cache == vma) {
+        mm->mmap_cache = NULL;
+    }
+    mm->map_count --;
+    vma_destroy(vma);
+}
+
 // mm_destroy - free mm and mm internal fields
 void
 mm_destroy(struct mm_struct *mm) {
@@ -150,9 +216,12 @@ mm_destroy(struct mm_struct *mm) {
     list_entry_t *list = &(mm->mmap_list), *le;
     while ((le = list_next(list)) != list) {
         list_del(le);
-        kfree(le2vma(le, list_link));  //kfree vma        
+        vma_destroy(le2vma(le, list_link));  //kfree vma
+    }
+    if (mm->sm_priv != NULL) {
+        swap_exit_mm(mm);
     }
-    kfree(mm); //kfree mm
+    kmem_cache_free(mm_cachep, mm); //kfree mm
     mm=NULL;
 }
 
@@ -169,7 +238,7 @@ mm_map(struct mm_struct *mm, uintptr_t addr, size_t len, uint32_t vm_flags,
     int ret = -E_INVAL;
 
     struct vma_struct *vma;
-    if ((vma = find_vma(mm, start)) != NULL && end > vma->vm_start) {
+    if (find_vma_intersection(mm, start, end) != NULL) {
         goto out;
     }
     ret = -E_NO_MEM;
@@ -187,6 +256,95 @@ out:
     return ret;
 }
 
+/* *
+ * mm_map_file - like mm_map, with the filesz bytes from addr on read from node
+ * at offset when they are first touched, and the rest of the vma zeros.
+ * */
+int
+mm_map_file(struct mm_struct *mm, uintptr_t addr, size_t len, uint32_t vm_flags,
+            struct inode *node, off_t offset, size_t filesz) {
+    struct vma_struct *vma;
+    int ret;
+    assert(filesz <= len);
+    if ((ret = mm_map(mm, addr, len, vm_flags, &vma)) == 0) {
+        vma_set_file(vma, node, offset, addr, addr + filesz);
+    }
+    return ret;
+}
+
+/* *
+ * mm_unmap - unmap [addr, addr + len) of mm: the vmas in it go, the ones
+ * across its ends are cut, and one across both is split in two. The written
+ * pages of shared file vmas go back to the file first.
+ * */
+int
+mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len) {
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    if (!USER_ACCESS(start, end)) {
+        return -E_INVAL;
+    }
+
+    assert(mm != NULL);
+
+    struct vma_struct *vma, *nvma = NULL;
+    while ((vma = find_vma_intersection(mm, start, end)) != NULL) {
+        uintptr_t un_start = (vma->vm_start > start) ? vma->vm_start : start;
+        uintptr_t un_end = (vma->vm_end < end) ? vma->vm_end : end;
+        if (vma->vm_start < start && vma->vm_end > end) {
+            if ((nvma = vma_create(end, vma->vm_end, vma->vm_flags)) == NULL) {
+                return -E_NO_MEM;
+            }
+            if (vma->vm_file != NULL) {
+                vma_set_file(nvma, vma->vm_file, vma->vm_file_off, vma->vm_file_start, vma->vm_file_end);
+            }
+        }
+        if (vma->vm_file != NULL && (vma->vm_flags & VM_SHARED)) {
+            filemap_sync(mm, vma, un_start, un_end);
+        }
+        unmap_range(mm->pgdir, un_start, un_end);
+
+        if (vma->vm_start >= start && vma->vm_end <= end) {
+            remove_vma_struct(mm, vma);
+            continue;
+        }
+        // the order of the vmas stays the same, so the tree needs no change for vm_start
+        if (vma->vm_start < start) {
+            vma->vm_end = start;
+        }
+        else {
+            vma->vm_start = end;
+        }
+        if (nvma != NULL) {
+            insert_vma_struct(mm, nvma);
+            break;
+        }
+    }
+    return 0;
+}
+
+/* *
+ * get_unmapped_area - the highest free range of len bytes below the vmas
+ * of mm that are above USERBASE, 0 if there is none. The user stack is at
+ * the top, so mappings go right below it, and further down one by one.
+ * */
+uintptr_t
+get_unmapped_area(struct mm_struct *mm, size_t len) {
+    uintptr_t end = USERTOP;
+    if (len == 0 || len > USERTOP - USERBASE) {
+        return 0;
+    }
+    len = ROUNDUP(len, PGSIZE);
+    list_entry_t *list = &(mm->mmap_list), *le = list;
+    while ((le = list_prev(le)) != list) {
+        struct vma_struct *vma = le2vma(le, list_link);
+        if (end >= vma->vm_end + len) {
+            return end - len;
+        }
+        end = vma->vm_start;
+    }
+    return (end >= USERBASE + len) ? end - len : 0;
+}
+
 int
 dup_mmap(struct mm_struct *to, struct mm_struct *from) {
     assert(to != NULL && from != NULL);
@@ -200,8 +358,12 @@ dup_mmap(struct mm_struct *to, struct mm_struct *from) {
         }
 
         insert_vma_struct(to, nvma);
+        if (vma->vm_file != NULL) {
+            vma_set_file(nvma, vma->vm_file, vma->vm_file_off, vma->vm_file_start, vma->vm_file_end);
+        }
 
-        bool share = 0;
+        // share the pages copy-on-write, do_pgfault copies them on the first write
+        bool share = 1;
         if (copy_range(to->pgdir, from->pgdir, vma->vm_start, vma->vm_end, share) != 0) {
             return -E_NO_MEM;
         }
@@ -216,6 +378,9 @@ exit_mmap(struct mm_struct *mm) {
     list_entry_t *list = &(mm->mmap_list), *le = list;
     while ((le = list_next(le)) != list) {
         struct vma_struct *vma = le2vma(le, list_link);
+        if (vma->vm_file != NULL && (vma->vm_flags & VM_SHARED)) {
+            filemap_sync(mm, vma, vma->vm_start, vma->vm_end);
+        }
         unmap_range(pgdir, vma->vm_start, vma->vm_end);
     }
     while ((le = list_next(le)) != list) {
@@ -242,10 +407,56 @@ copy_to_user(struct mm_struct *mm, void *dst, const void *src, size_t len) {
     return 1;
 }
 
+/* *
+ * get_user_pages - make the pages of [addr, addr + len) of mm present, and
+ * writable if write (the kernel is going to write them), and take a reference
+ * to each, so that they stay in place while the kernel works on them by their
+ * kernel addresses and maybe sleeps. The first n at most go to pages[]; return
+ * how many, or an error if the range is not the user's to access. put_page
+ * drops the references.
+ * */
+int
+get_user_pages(struct mm_struct *mm, uintptr_t addr, size_t len, bool write, struct Page *pages[], size_t n) {
+    if (!user_mem_check(mm, addr, len, write)) {
+        return -E_INVAL;
+    }
+    uintptr_t la = ROUNDDOWN(addr, PGSIZE), end = addr + len;
+    int nr = 0, ret;
+    for (; la < end && nr < n; la += PGSIZE) {
+        pte_t *ptep;
+        // a fault may return with the pte still empty, if it changed while the fault slept
+        while ((ptep = get_pte(mm->pgdir, la, 0)) == NULL || !(*ptep & PTE_P) || (write && !(*ptep & PTE_W))) {
+            uint32_t error_code = (write ? 2 : 0) | ((ptep != NULL && (*ptep & PTE_P)) ? 1 : 0);
+            if ((ret = do_pgfault(mm, error_code, la)) != 0) {
+                goto failed;
+            }
+        }
+        if (write) {
+            // the kernel does not set PTE_D, and swap_out drops clean pages of the swap cache
+            *ptep |= PTE_D;
+        }
+        pages[nr] = pte2page(*ptep);
+        page_ref_inc(pages[nr ++]);
+    }
+    return nr;
+
+failed:
+    while (nr > 0) {
+        put_page(pages[-- nr]);
+    }
+    return ret;
+}
+
 // vmm_init - initialize virtual memory management
 //          - now just call check_vmm to check correctness of vmm
 void
 vmm_init(void) {
+    check_rb_tree();
+    filemap_init();
+    if ((mm_cachep = kmem_cache_create("mm_struct", sizeof(struct mm_struct), NULL)) == NULL
+            || (vma_cachep = kmem_cache_create("vma_struct", sizeof(struct vma_struct), NULL)) == NULL) {
+        panic("cannot create mm/vma caches.\n");
+    }
     check_vmm();
 }
 
@@ -309,6 +520,20 @@ check_vma_struct(void) {
         assert(vma2->vm_start == i  && vma2->vm_end == i  + 2);
     }
 
+    // the tree holds the same vmas as the list, in the same order
+    rb_node *node = rb_node_left(&(mm->mmap_tree));
+    for (le = list_next(&(mm->mmap_list)); le != &(mm->mmap_list); le = list_next(le)) {
+        assert(node != NULL && rbn2vma(node, rb_link) == le2vma(le, list_link));
+        node = rb_node_next(&(mm->mmap_tree), node);
+    }
+    assert(node == NULL);
+
+    for (i = 5; i <= 5 * step2; i += 5) {
+        struct vma_struct *vma = find_vma_intersection(mm, i - 3, i + 1);
+        assert(vma != NULL && vma->vm_start == i);
+        assert(find_vma_intersection(mm, i + 2, i + 5) == NULL);
+    }
+
     for (i =4; i>=0; i--) {
         struct vma_struct *vma_below_5= find_vma(mm,i);
         if (vma_below_5 != NULL ) {
@@ -368,9 +593,43 @@ check_pgfault(void) {
 
     cprintf("check_pgfault() succeeded!\n");
 }
+
+// mm_alloc_page - like pgdir_alloc_page, and put the page on the replacement list of mm
+struct Page *
+mm_alloc_page(struct mm_struct *mm, uintptr_t la, uint32_t perm) {
+    struct Page *page = pgdir_alloc_page(mm->pgdir, la, perm);
+    if (page != NULL && swap_init_ok) {
+        swap_map_swappable(mm, la, page, 0);
+    }
+    return page;
+}
+
 //page fault number
 volatile unsigned int pgfault_num=0;
 
+/* *
+ * The fault rate of a mm counts its page faults with an exponential decay: it
+ * is halved every FAULT_RATE_PERIOD ticks, so a mm whose working set fits in
+ * its resident pages soon drops to 0. kswapd reclaims from the mms with the
+ * lowest rate first. The decay is applied lazily, when the rate is looked at.
+ * */
+#define FAULT_RATE_PERIOD           10
+
+static void
+mm_fault_decay(struct mm_struct *mm) {
+    size_t periods = (ticks - mm->fault_stamp) / FAULT_RATE_PERIOD;
+    if (periods != 0) {
+        mm->fault_rate = (periods < 32) ? (mm->fault_rate >> periods) : 0;
+        mm->fault_stamp += periods * FAULT_RATE_PERIOD;
+    }
+}
+
+uint32_t
+mm_fault_rate(struct mm_struct *mm) {
+    mm_fault_decay(mm);
+    return mm->fault_rate;
+}
+
 /* do_pgfault - interrupt handler to process the page fault execption
  * @mm         : the control struct for a set of vma using the same PDT
  * @error_code : the error code recorded in trapframe->tf_err which is setted by x86 hardware
@@ -399,6 +658,8 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     struct vma_struct *vma = find_vma(mm, addr);
 
     pgfault_num++;
+    mm_fault_decay(mm);
+    mm->fault_rate ++;
     //If the addr is in the range of a mm's vma?
     if (vma == NULL || vma->vm_start > addr) {
         cprintf("not valid addr %x, and  can not find it in vma\n", addr);
@@ -505,38 +766,78 @@ do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr) {
     }
     
     if (*ptep == 0) { // if the phy addr isn't exist, then alloc a page & map the phy addr with logical addr
-        if (pgdir_alloc_page(mm->pgdir, addr, perm) == NULL) {
+        if (vma->vm_file != NULL) {
+            if ((ret = filemap_fault(mm, vma, addr, (error_code & 2) != 0)) != 0) {
+                cprintf("filemap_fault in do_pgfault failed %e\n", ret);
+                goto failed;
+            }
+        }
+        else if (mm_alloc_page(mm, addr, perm) == NULL) {
             cprintf("pgdir_alloc_page in do_pgfault failed\n");
             goto failed;
         }
     }
+    else if (*ptep & PTE_P) {
+        //if process write to this existed readonly page (PTE_P means existed), then should be here now.
+        //the page is shared copy-on-write since fork (dup_mmap): if we are the last user
+        //just make it writable again, otherwise copy it to a private page.
+        assert((error_code & 2) && (perm & PTE_W));
+        struct Page *page = pte2page(*ptep);
+        if (vma->vm_flags & VM_SHARED) {
+            // write-protected by fork, the page stays shared
+            *ptep |= PTE_W;
+            tlb_invalidate(mm->pgdir, addr);
+        }
+        else if (page_ref(page) == 1) {
+            // the disk copy in the swap cache goes stale, and the page no longer holds the file
+            if (PageSwapCache(page)) {
+                swap_cache_del(page);
+            }
+            if (PageFileCache(page)) {
+                filemap_del(page);
+            }
+            *ptep |= PTE_W;
+            tlb_invalidate(mm->pgdir, addr);
+            // the page may still be on the replacement list of the mm that shared it with us
+            if (swap_init_ok) {
+                swap_map_swappable(mm, addr, page, 0);
+            }
+        }
+        else {
+            struct Page *npage;
+            if ((npage = alloc_page()) == NULL) {
+                cprintf("alloc_page for copy on write in do_pgfault failed\n");
+                goto failed;
+            }
+            memcpy(page2kva(npage), page2kva(page), PGSIZE);
+            if (page_insert(mm->pgdir, npage, addr, perm) != 0) {
+                free_page(npage);
+                goto failed;
+            }
+            if (swap_init_ok) {
+                swap_map_swappable(mm, addr, npage, 0);
+            }
+        }
+    }
     else {
         struct Page *page=NULL;
         cprintf("do pgfault: ptep %x, pte %x\n",ptep, *ptep);
-        if (*ptep & PTE_P) {
-            //if process write to this existed readonly page (PTE_P means existed), then should be here now.
-            //we can implement the delayed memory space copy for fork child process (AKA copy on write, COW).
-            //we didn't implement now, we will do it in future.
-            panic("error write a non-writable pte");
-            //page = pte2page(*ptep);
-        } else{
-           // if this pte is a swap entry, then load data from disk to a page with phy addr
-           // and call page_insert to map the phy addr with logical addr
-           if(swap_init_ok) {               
-               if ((ret = swap_in(mm, addr, &page)) != 0) {
-                   cprintf("swap_in in do_pgfault failed\n");
-                   goto failed;
-               }    
-
-           }  
-           else {
+        // if this pte is a swap entry, then load data from disk to a page with phy addr
+        // and call page_insert to map the phy addr with logical addr
+        if(swap_init_ok) {               
+            if ((ret = swap_in(mm, addr, &page)) != 0) {
+                cprintf("swap_in in do_pgfault failed\n");
+                goto failed;
+            }    
+        }  
+        else {
             cprintf("no swap_init_ok but ptep is %x, failed\n",*ptep);
             goto failed;
-           }
-       } 
-       page_insert(mm->pgdir, page, addr, perm);
-       swap_map_swappable(mm, addr, page, 1);
-       page->pra_vaddr = addr;
+        }
+        // page is NULL if the pte changed while swap_in slept, the access is just retried
+        if (page != NULL && (ret = swap_map_page(mm, addr, page, perm)) != 0) {
+            goto failed;
+        }
    }
    ret = 0;
 failed:
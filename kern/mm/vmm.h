@@ -7,9 +7,11 @@
 #include <sync.h>
 #include <proc.h>
 #include <sem.h>
+#include <rb_tree.h>
 
 //pre define
 struct mm_struct;
+struct inode;
 
 // the virtual continuous memory area(vma)
 struct vma_struct {
@@ -18,19 +20,29 @@ struct vma_struct {
     uintptr_t vm_end;        // end addr of vma
     uint32_t vm_flags;       // flags of vma
     list_entry_t list_link;  // linear list link which sorted by start addr of vma
+    rb_node rb_link;         // redblack tree link which sorted by start addr of vma
+    struct inode *vm_file;   // the file the vma maps, NULL for anonymous memory, see filemap.c
+    off_t vm_file_off;       // the file offset at vm_file_start
+    uintptr_t vm_file_start; // [vm_file_start, vm_file_end) is from the file, the rest is zeros
+    uintptr_t vm_file_end;
 };
 
 #define le2vma(le, member)                  \
     to_struct((le), struct vma_struct, member)
 
+#define rbn2vma(node, member)               \
+    rbn2struct((node), struct vma_struct, member)
+
 #define VM_READ                 0x00000001
 #define VM_WRITE                0x00000002
 #define VM_EXEC                 0x00000004
 #define VM_STACK                0x00000008
+#define VM_SHARED               0x00000010  // the pages are shared with the file and across fork, see mmap
 
 // the control struct for a set of vma using the same PDT
 struct mm_struct {
     list_entry_t mmap_list;        // linear list link which sorted by start addr of vma
+    rb_tree mmap_tree;             // redblack tree of the same vma, for O(log n) lookup
     struct vma_struct *mmap_cache; // current accessed vma, used for speed purpose
     pde_t *pgdir;                  // the PDT of these vma
     int map_count;                 // the count of these vma
@@ -38,10 +50,13 @@ struct mm_struct {
     int mm_count;                  // the number ofprocess which shared the mm
     semaphore_t mm_sem;            // mutex for using dup_mmap fun to duplicat the mm 
     int locked_by;                 // the lock owner process's pid
+    uint32_t fault_rate;           // page faults lately, halved every FAULT_RATE_PERIOD ticks
+    size_t fault_stamp;            // ticks when fault_rate was halved last
 
 };
 
 struct vma_struct *find_vma(struct mm_struct *mm, uintptr_t addr);
+struct vma_struct *find_vma_intersection(struct mm_struct *mm, uintptr_t start, uintptr_t end);
 struct vma_struct *vma_create(uintptr_t vm_start, uintptr_t vm_end, uint32_t vm_flags);
 void insert_vma_struct(struct mm_struct *mm, struct vma_struct *vma);
 
@@ -51,7 +66,11 @@ void mm_destroy(struct mm_struct *mm);
 void vmm_init(void);
 int mm_map(struct mm_struct *mm, uintptr_t addr, size_t len, uint32_t vm_flags,
            struct vma_struct **vma_store);
+int mm_map_file(struct mm_struct *mm, uintptr_t addr, size_t len, uint32_t vm_flags,
+                struct inode *node, off_t offset, size_t filesz);
 int do_pgfault(struct mm_struct *mm, uint32_t error_code, uintptr_t addr);
+struct Page *mm_alloc_page(struct mm_struct *mm, uintptr_t la, uint32_t perm);
+uint32_t mm_fault_rate(struct mm_struct *mm);
 
 int mm_unmap(struct mm_struct *mm, uintptr_t addr, size_t len);
 int dup_mmap(struct mm_struct *to, struct mm_struct *from);
@@ -66,6 +85,7 @@ bool user_mem_check(struct mm_struct *mm, uintptr_t start, size_t len, bool writ
 bool copy_from_user(struct mm_struct *mm, void *dst, const void *src, size_t len, bool writable);
 bool copy_to_user(struct mm_struct *mm, void *dst, const void *src, size_t len);
 bool copy_string(struct mm_struct *mm, char *dst, const char *src, size_t maxn);
+int get_user_pages(struct mm_struct *mm, uintptr_t addr, size_t len, bool write, struct Page *pages[], size_t n);
 
 static inline int
 mm_count(struct mm_struct *mm) {
@@ -7,6 +7,7 @@
 #include <sched.h>
 #include <elf.h>
 #include <vmm.h>
+#include <swap.h>
 #include <trap.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,7 +15,10 @@
 #include <unistd.h>
 #include <fs.h>
 #include <vfs.h>
+#include <inode.h>
 #include <sysfile.h>
+#include <file.h>
+#include <filemap.h>
 
 /* ------------- process/thread mechanism design&implementation -------------
 (an simplified Linux process/thread mechanism )
@@ -81,6 +85,9 @@ struct proc_struct *current = NULL;
 
 static int nr_process = 0;
 
+// proc_cachep - the slab cache proc_structs come from
+static struct kmem_cache *proc_cachep;
+
 void kernel_thread_entry(void);
 void forkrets(struct trapframe *tf);
 void switch_to(struct context *from, struct context *to);
@@ -88,7 +95,7 @@ void switch_to(struct context *from, struct context *to);
 // alloc_proc - alloc a proc_struct and init all fields of proc_struct
 static struct proc_struct *
 alloc_proc(void) {
-    struct proc_struct *proc = kmalloc(sizeof(struct proc_struct));
+    struct proc_struct *proc = kmem_cache_alloc(proc_cachep);
     if (proc != NULL) {
     //LAB4:EXERCISE1 YOUR CODE
     /*
@@ -321,6 +328,16 @@ put_pgdir(struct mm_struct *mm) {
     free_page(kva2page(mm->pgdir));
 }
 
+// put_mm - drop a reference to mm, and free the whole memory space with the last one
+void
+put_mm(struct mm_struct *mm) {
+    if (mm_count_dec(mm) == 0) {
+        exit_mmap(mm);
+        put_pgdir(mm);
+        mm_destroy(mm);
+    }
+}
+
 // copy_mm - process "proc" duplicate OR share process "current"'s mm according clone_flags
 //         - if clone_flags & CLONE_VM, then "share" ; else "duplicate"
 static int
@@ -509,7 +526,7 @@ bad_fork_cleanup_fs:  //for LAB8
 bad_fork_cleanup_kstack:
     put_kstack(proc);
 bad_fork_cleanup_proc:
-    kfree(proc);
+    kmem_cache_free(proc_cachep, proc);
     goto fork_out;
 }
 
@@ -529,11 +546,7 @@ do_exit(int error_code) {
     struct mm_struct *mm = current->mm;
     if (mm != NULL) {
         lcr3(boot_cr3);
-        if (mm_count_dec(mm) == 0) {
-            exit_mmap(mm);
-            put_pgdir(mm);
-            mm_destroy(mm);
-        }
+        put_mm(mm);
         current->mm = NULL;
     }
     put_fs(current); //for LAB8
@@ -627,7 +640,10 @@ load_icode(int fd, int argc, char **kargv) {
         goto bad_pgdir_cleanup_mm;
     }
 
-    struct Page *page;
+    struct inode *node;
+    if ((ret = file_node(fd, &node)) != 0) {
+        goto bad_elf_cleanup_pgdir;
+    }
 
     struct elfhdr __elf, *elf = &__elf;
     if ((ret = load_icode_read(fd, elf, sizeof(struct elfhdr), 0)) != 0) {
@@ -640,7 +656,7 @@ load_icode(int fd, int argc, char **kargv) {
     }
 
     struct proghdr __ph, *ph = &__ph;
-    uint32_t vm_flags, perm, phnum;
+    uint32_t vm_flags, phnum;
     for (phnum = 0; phnum < elf->e_phnum; phnum ++) {
         off_t phoff = elf->e_phoff + sizeof(struct proghdr) * phnum;
         if ((ret = load_icode_read(fd, ph, sizeof(struct proghdr), phoff)) != 0) {
@@ -656,61 +672,20 @@ load_icode(int fd, int argc, char **kargv) {
         if (ph->p_filesz == 0) {
             continue ;
         }
-        vm_flags = 0, perm = PTE_U;
+        vm_flags = 0;
         if (ph->p_flags & ELF_PF_X) vm_flags |= VM_EXEC;
         if (ph->p_flags & ELF_PF_W) vm_flags |= VM_WRITE;
         if (ph->p_flags & ELF_PF_R) vm_flags |= VM_READ;
-        if (vm_flags & VM_WRITE) perm |= PTE_W;
-        if ((ret = mm_map(mm, ph->p_va, ph->p_memsz, vm_flags, NULL)) != 0) {
-            goto bad_cleanup_mmap;
-        }
+        // the pages are read from the file when they are first touched, see filemap.c;
+        // if the segment is aligned in the file, its first page comes whole from the file too
+        uintptr_t start = ph->p_va;
         off_t offset = ph->p_offset;
-        size_t off, size;
-        uintptr_t start = ph->p_va, end, la = ROUNDDOWN(start, PGSIZE);
-
-        ret = -E_NO_MEM;
-
-        end = ph->p_va + ph->p_filesz;
-        while (start < end) {
-            if ((page = pgdir_alloc_page(mm->pgdir, la, perm)) == NULL) {
-                ret = -E_NO_MEM;
-                goto bad_cleanup_mmap;
-            }
-            off = start - la, size = PGSIZE - off, la += PGSIZE;
-            if (end < la) {
-                size -= la - end;
-            }
-            if ((ret = load_icode_read(fd, page2kva(page) + off, size, offset)) != 0) {
-                goto bad_cleanup_mmap;
-            }
-            start += size, offset += size;
+        if (offset % PGSIZE == start % PGSIZE) {
+            offset -= start % PGSIZE, start = ROUNDDOWN(start, PGSIZE);
         }
-        end = ph->p_va + ph->p_memsz;
-
-        if (start < la) {
-            /* ph->p_memsz == ph->p_filesz */
-            if (start == end) {
-                continue ;
-            }
-            off = start + PGSIZE - la, size = PGSIZE - off;
-            if (end < la) {
-                size -= la - end;
-            }
-            memset(page2kva(page) + off, 0, size);
-            start += size;
-            assert((end < la && start == end) || (end >= la && start == la));
-        }
-        while (start < end) {
-            if ((page = pgdir_alloc_page(mm->pgdir, la, perm)) == NULL) {
-                ret = -E_NO_MEM;
-                goto bad_cleanup_mmap;
-            }
-            off = start - la, size = PGSIZE - off, la += PGSIZE;
-            if (end < la) {
-                size -= la - end;
-            }
-            memset(page2kva(page) + off, 0, size);
-            start += size;
+        if ((ret = mm_map_file(mm, start, ph->p_va + ph->p_memsz - start, vm_flags,
+                               node, offset, ph->p_va + ph->p_filesz - start)) != 0) {
+            goto bad_cleanup_mmap;
         }
     }
     sysfile_close(fd);
@@ -719,10 +694,10 @@ load_icode(int fd, int argc, char **kargv) {
     if ((ret = mm_map(mm, USTACKTOP - USTACKSIZE, USTACKSIZE, vm_flags, NULL)) != 0) {
         goto bad_cleanup_mmap;
     }
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-PGSIZE , PTE_USER) != NULL);
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-2*PGSIZE , PTE_USER) != NULL);
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-3*PGSIZE , PTE_USER) != NULL);
-    assert(pgdir_alloc_page(mm->pgdir, USTACKTOP-4*PGSIZE , PTE_USER) != NULL);
+    assert(mm_alloc_page(mm, USTACKTOP-PGSIZE , PTE_USER) != NULL);
+    assert(mm_alloc_page(mm, USTACKTOP-2*PGSIZE , PTE_USER) != NULL);
+    assert(mm_alloc_page(mm, USTACKTOP-3*PGSIZE , PTE_USER) != NULL);
+    assert(mm_alloc_page(mm, USTACKTOP-4*PGSIZE , PTE_USER) != NULL);
     
     mm_count_inc(mm);
     current->mm = mm;
@@ -851,11 +826,7 @@ do_execve(const char *name, int argc, const char **argv) {
     // }
     if (mm != NULL) {
         lcr3(boot_cr3);
-        if (mm_count_dec(mm) == 0) {
-            exit_mmap(mm);
-            put_pgdir(mm);
-            mm_destroy(mm);
-        }
+        put_mm(mm);
         current->mm = NULL;
     }
     ret= -E_NO_MEM;;
@@ -944,7 +915,7 @@ found:
     }
     local_intr_restore(intr_flag);
     put_kstack(proc);
-    kfree(proc);
+    kmem_cache_free(proc_cachep, proc);
     return 0;
 }
 
@@ -1018,6 +989,8 @@ init_main(void *arg) {
         panic("set boot fs failed: %e.\n", ret);
     }
     
+    // free slabs the caches hold on to are not in use, leave them out of the check
+    kmem_cache_reap();
     size_t nr_free_pages_store = nr_free_pages();
     size_t kernel_allocated_store = kallocated();
 
@@ -1036,9 +1009,14 @@ init_main(void *arg) {
         
     cprintf("all user-mode processes have quit.\n");
     assert(initproc->cptr == NULL && initproc->yptr == NULL && initproc->optr == NULL);
-    assert(nr_process == 2);
-    assert(list_next(&proc_list) == &(initproc->list_link));
-    assert(list_prev(&proc_list) == &(initproc->list_link));
+    // kswapd and kflushd, the children of idle, never exit
+    assert(nr_process == 2 + (kswapd != NULL) + (kflushd != NULL));
+    list_entry_t *le = &proc_list;
+    while ((le = list_next(le)) != &proc_list) {
+        struct proc_struct *proc = le2proc(le, list_link);
+        assert(proc == initproc || proc == kswapd || proc == kflushd);
+    }
+    kmem_cache_reap();
     assert(nr_free_pages_store == nr_free_pages());
     assert(kernel_allocated_store == kallocated());
     cprintf("init check memory pass.\n");
@@ -1051,6 +1029,10 @@ void
 proc_init(void) {
     int i;
 
+    if ((proc_cachep = kmem_cache_create("proc_struct", sizeof(struct proc_struct), NULL)) == NULL) {
+        panic("cannot create proc_struct cache.\n");
+    }
+
     list_init(&proc_list);
     for (i = 0; i < HASH_LIST_SIZE; i ++) {
         list_init(hash_list + i);
@@ -1126,3 +1108,139 @@ do_sleep(unsigned int time) {
     del_timer(timer);
     return 0;
 }
+
+/* *
+ * do_mmap - map len bytes at *addr_store, anywhere (stored back in *addr_store)
+ *         - if it is 0. They map the file fd from offset on, or zeros if fd is
+ *         - NO_FD. A private mapping gets its own copy of a page on the first
+ *         - write, a shared one writes to the file (see filemap.c) or, for
+ *         - zeros, shares the pages with the children forked later.
+ * */
+int
+do_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags, int fd, off_t offset) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call mmap!!.\n");
+    }
+    if (addr_store == NULL || len == 0) {
+        return -E_INVAL;
+    }
+
+    int ret = -E_INVAL;
+
+    uintptr_t addr;
+    lock_mm(mm);
+    if (!copy_from_user(mm, &addr, addr_store, sizeof(uintptr_t), 1)) {
+        goto out_unlock;
+    }
+
+    uint32_t vm_flags = VM_READ;
+    if (mmap_flags & MMAP_WRITE) vm_flags |= VM_WRITE;
+    if (mmap_flags & MMAP_SHARED) vm_flags |= VM_SHARED;
+
+    struct inode *node = NULL;
+    if (fd != NO_FD) {
+        bool writable = (vm_flags & VM_WRITE) && (vm_flags & VM_SHARED);
+        if (offset < 0 || offset % PGSIZE != 0 || addr % PGSIZE != 0 || !file_testfd(fd, 1, writable)) {
+            goto out_unlock;
+        }
+        if ((ret = file_node(fd, &node)) != 0) {
+            goto out_unlock;
+        }
+        // only a regular file reads the same on every fault
+        uint32_t type;
+        if ((ret = vop_gettype(node, &type)) != 0 || !S_ISREG(type)) {
+            ret = -E_INVAL;
+            goto out_unlock;
+        }
+    }
+
+    len += addr - ROUNDDOWN(addr, PGSIZE), addr = ROUNDDOWN(addr, PGSIZE);
+    len = ROUNDUP(len, PGSIZE);
+    ret = -E_NO_MEM;
+    if (addr == 0 && (addr = get_unmapped_area(mm, len)) == 0) {
+        goto out_unlock;
+    }
+    if (node != NULL) {
+        ret = mm_map_file(mm, addr, len, vm_flags, node, offset, len);
+    }
+    else {
+        ret = mm_map(mm, addr, len, vm_flags, NULL);
+    }
+    if (ret != 0) {
+        goto out_unlock;
+    }
+
+    if (node == NULL && (vm_flags & VM_SHARED)) {
+        // shared zeros are there from the start, so that a fork shares every page;
+        // they are not swappable, since a swapped out page would no longer be shared
+        uintptr_t la;
+        uint32_t perm = PTE_U | ((vm_flags & VM_WRITE) ? PTE_W : 0);
+        for (la = addr; la < addr + len; la += PGSIZE) {
+            struct Page *page;
+            if ((page = pgdir_alloc_page(mm->pgdir, la, perm)) == NULL) {
+                ret = -E_NO_MEM;
+                goto out_unmap;
+            }
+            memset(page2kva(page), 0, PGSIZE);
+        }
+    }
+
+    ret = -E_INVAL;
+    if (copy_to_user(mm, addr_store, &addr, sizeof(uintptr_t))) {
+        ret = 0;
+        goto out_unlock;
+    }
+out_unmap:
+    mm_unmap(mm, addr, len);
+out_unlock:
+    unlock_mm(mm);
+    return ret;
+}
+
+// do_munmap - unmap [addr, addr + len), see mm_unmap
+int
+do_munmap(uintptr_t addr, size_t len) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call munmap!!.\n");
+    }
+    if (len == 0) {
+        return -E_INVAL;
+    }
+    int ret;
+    lock_mm(mm);
+    {
+        ret = mm_unmap(mm, addr, len);
+    }
+    unlock_mm(mm);
+    return ret;
+}
+
+// do_msync - write what the shared file mappings in [addr, addr + len) have written back to the files
+int
+do_msync(uintptr_t addr, size_t len) {
+    struct mm_struct *mm = current->mm;
+    if (mm == NULL) {
+        panic("kernel thread call msync!!.\n");
+    }
+    uintptr_t start = ROUNDDOWN(addr, PGSIZE), end = ROUNDUP(addr + len, PGSIZE);
+    if (!USER_ACCESS(start, end)) {
+        return -E_INVAL;
+    }
+    int ret = 0;
+    lock_mm(mm);
+    {
+        struct vma_struct *vma = find_vma_intersection(mm, start, end);
+        while (ret == 0 && vma != NULL && vma->vm_start < end) {
+            if (vma->vm_file != NULL && (vma->vm_flags & VM_SHARED)) {
+                ret = filemap_sync(mm, vma, (vma->vm_start > start) ? vma->vm_start : start,
+                                   (vma->vm_end < end) ? vma->vm_end : end);
+            }
+            list_entry_t *le = list_next(&(vma->list_link));
+            vma = (le != &(mm->mmap_list)) ? le2vma(le, list_link) : NULL;
+        }
+    }
+    unlock_mm(mm);
+    return ret;
+}
@@ -76,6 +76,11 @@ struct proc_struct {
 #define WT_KSEM                      0x00000100                    // wait kernel semaphore
 #define WT_TIMER                    (0x00000002 | WT_INTERRUPTED)  // wait timer
 #define WT_KBD                      (0x00000004 | WT_INTERRUPTED)  // wait the input of keyboard
+#define WT_IDE                       0x00000200                    // wait ide request to complete
+#define WT_KSWAPD                    0x00000400                    // kswapd waits for free pages to run low
+#define WT_BCACHE                    0x00000800                    // wait a block cache buffer under I/O
+#define WT_PIPE                     (0x00000008 | WT_INTERRUPTED)  // wait data or room of a pipe
+#define WT_WRITEBACK                (0x00000010 | WT_INTERRUPTED)  // kflushd waits for its timer or too many dirty blocks
 
 #define le2proc(le, member)         \
     to_struct((le), struct proc_struct, member)
@@ -92,6 +97,7 @@ void cpu_idle(void) __attribute__((noreturn));
 
 struct proc_struct *find_proc(int pid);
 int do_fork(uint32_t clone_flags, uintptr_t stack, struct trapframe *tf);
+void put_mm(struct mm_struct *mm);
 int do_exit(int error_code);
 int do_yield(void);
 int do_execve(const char *name, int argc, const char **argv);
@@ -100,5 +106,8 @@ int do_kill(int pid);
 //FOR LAB6, set the process's priority (bigger value will get more CPU time)
 void lab6_set_priority(uint32_t priority);
 int do_sleep(unsigned int time);
+int do_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags, int fd, off_t offset);
+int do_munmap(uintptr_t addr, size_t len);
+int do_msync(uintptr_t addr, size_t len);
 #endif /* !__KERN_PROCESS_PROC_H__ */
 
@@ -9,6 +9,7 @@
 #include <clock.h>
 #include <stat.h>
 #include <dirent.h>
+#include <uio.h>
 #include <sysfile.h>
 
 static int
@@ -55,6 +56,30 @@ sys_getpid(uint32_t arg[]) {
     return current->pid;
 }
 
+static int
+sys_mmap(uint32_t arg[]) {
+    uintptr_t *addr_store = (uintptr_t *)arg[0];
+    size_t len = (size_t)arg[1];
+    uint32_t mmap_flags = (uint32_t)arg[2];
+    int fd = (int)arg[3];
+    off_t offset = (off_t)arg[4];
+    return do_mmap(addr_store, len, mmap_flags, fd, offset);
+}
+
+static int
+sys_munmap(uint32_t arg[]) {
+    uintptr_t addr = (uintptr_t)arg[0];
+    size_t len = (size_t)arg[1];
+    return do_munmap(addr, len);
+}
+
+static int
+sys_msync(uint32_t arg[]) {
+    uintptr_t addr = (uintptr_t)arg[0];
+    size_t len = (size_t)arg[1];
+    return do_msync(addr, len);
+}
+
 static int
 sys_putc(uint32_t arg[]) {
     int c = (int)arg[0];
@@ -115,6 +140,40 @@ sys_write(uint32_t arg[]) {
     return sysfile_write(fd, base, len);
 }
 
+static int
+sys_readv(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    const struct iovec *iov = (const struct iovec *)arg[1];
+    int iovcnt = (int)arg[2];
+    return sysfile_readv(fd, iov, iovcnt);
+}
+
+static int
+sys_writev(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    const struct iovec *iov = (const struct iovec *)arg[1];
+    int iovcnt = (int)arg[2];
+    return sysfile_writev(fd, iov, iovcnt);
+}
+
+static int
+sys_pread(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    void *base = (void *)arg[1];
+    size_t len = (size_t)arg[2];
+    off_t offset = (off_t)arg[3];
+    return sysfile_pread(fd, base, len, offset);
+}
+
+static int
+sys_pwrite(uint32_t arg[]) {
+    int fd = (int)arg[0];
+    void *base = (void *)arg[1];
+    size_t len = (size_t)arg[2];
+    off_t offset = (off_t)arg[3];
+    return sysfile_pwrite(fd, base, len, offset);
+}
+
 static int
 sys_seek(uint32_t arg[]) {
     int fd = (int)arg[0];
@@ -182,6 +241,12 @@ sys_dup(uint32_t arg[]) {
     return sysfile_dup(fd1, fd2);
 }
 
+static int
+sys_pipe(uint32_t arg[]) {
+    int *fd_store = (int *)arg[0];
+    return sysfile_pipe(fd_store);
+}
+
 static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_exit]              sys_exit,
     [SYS_fork]              sys_fork,
@@ -190,6 +255,9 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_yield]             sys_yield,
     [SYS_kill]              sys_kill,
     [SYS_getpid]            sys_getpid,
+    [SYS_mmap]              sys_mmap,
+    [SYS_munmap]            sys_munmap,
+    [SYS_msync]             sys_msync,
     [SYS_putc]              sys_putc,
     [SYS_pgdir]             sys_pgdir,
     [SYS_gettime]           sys_gettime,
@@ -200,6 +268,10 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_read]              sys_read,
     [SYS_write]             sys_write,
     [SYS_seek]              sys_seek,
+    [SYS_readv]             sys_readv,
+    [SYS_writev]            sys_writev,
+    [SYS_pread]             sys_pread,
+    [SYS_pwrite]            sys_pwrite,
     [SYS_fstat]             sys_fstat,
     [SYS_fsync]             sys_fsync,
     [SYS_getcwd]            sys_getcwd,
@@ -208,6 +280,7 @@ static int (*syscalls[])(uint32_t arg[]) = {
     [SYS_unlink]            sys_unlink,
     [SYS_getdirentry]       sys_getdirentry,
     [SYS_dup]               sys_dup,
+    [SYS_pipe]              sys_pipe,
 };
 
 #define NUM_SYSCALLS        ((sizeof(syscalls)) / (sizeof(syscalls[0])))
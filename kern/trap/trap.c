@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <console.h>
+#include <ide.h>
 #include <vmm.h>
 #include <swap.h>
 #include <kdebug.h>
@@ -242,6 +243,11 @@ trap_dispatch(struct trapframe *tf) {
         ticks ++;
         assert(current != NULL);
         run_timer_list();
+        // age the pages of the running process, only if user mode was interrupted so that
+        // the kernel can never be in the middle of changing the replacement list of its mm
+        if (swap_init_ok && !trap_in_kernel(tf) && current->mm != NULL) {
+            swap_tick_event(current->mm);
+        }
         break;
     case IRQ_OFFSET + IRQ_COM1:
         //c = cons_getc();
@@ -261,8 +267,10 @@ trap_dispatch(struct trapframe *tf) {
         panic("T_SWITCH_** ??\n");
         break;
     case IRQ_OFFSET + IRQ_IDE1:
+        ide_intr(0);
+        break;
     case IRQ_OFFSET + IRQ_IDE2:
-        /* do nothing */
+        ide_intr(1);
         break;
     default:
         print_trapframe(tf);
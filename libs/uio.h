@@ -0,0 +1,15 @@
+#ifndef __LIBS_UIO_H__
+#define __LIBS_UIO_H__
+
+#include <defs.h>
+
+/* one of the buffers of readv/writev */
+struct iovec {
+    void *iov_base;                     // start of the buffer
+    size_t iov_len;                     // length of the buffer (bytes)
+};
+
+#define UIO_MAXIOV          16          // max number of buffers of a readv/writev
+
+#endif /* !__LIBS_UIO_H__ */
+
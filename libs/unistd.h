@@ -17,6 +17,7 @@
 #define SYS_mmap            20
 #define SYS_munmap          21
 #define SYS_shmem           22
+#define SYS_msync           23
 #define SYS_putc            30
 #define SYS_pgdir           31
 #define SYS_open            100
@@ -24,6 +25,11 @@
 #define SYS_read            102
 #define SYS_write           103
 #define SYS_seek            104
+#define SYS_readv           105
+#define SYS_writev          106
+#define SYS_pread           107
+#define SYS_pwrite          108
+#define SYS_pipe            109
 #define SYS_fstat           110
 #define SYS_fsync           111
 #define SYS_getcwd          121
@@ -43,6 +49,10 @@
 #define CLONE_THREAD        0x00000200  // thread group
 #define CLONE_FS            0x00000800  // set if shared between processes
 
+/* SYS_mmap flags */
+#define MMAP_WRITE          0x00000100  // the mapping is writable
+#define MMAP_SHARED         0x00000400  // writes go to the file, and are shared with the children
+
 /* VFS flags */
 // flags for open: choose one of these
 #define O_RDONLY            0           // open for reading only
@@ -58,6 +68,8 @@
 
 #define NO_FD               -0x9527     // invalid fd
 
+#define PIPE_BUF            512         // a write to a pipe up to this many bytes is not split
+
 /* lseek codes */
 #define LSEEK_SET           0           // seek relative to beginning of file
 #define LSEEK_CUR           1           // seek relative to current position in file
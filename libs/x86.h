@@ -43,6 +43,7 @@ static inline void cli(void) __attribute__((always_inline));
 static inline void ltr(uint16_t sel) __attribute__((always_inline));
 static inline uint32_t read_eflags(void) __attribute__((always_inline));
 static inline void write_eflags(uint32_t eflags) __attribute__((always_inline));
+static inline uint64_t rdtsc(void) __attribute__((always_inline));
 static inline void lcr0(uintptr_t cr0) __attribute__((always_inline));
 static inline void lcr3(uintptr_t cr3) __attribute__((always_inline));
 static inline uintptr_t rcr0(void) __attribute__((always_inline));
@@ -165,6 +166,14 @@ write_eflags(uint32_t eflags) {
     asm volatile ("pushl %0; popfl" :: "r" (eflags));
 }
 
+/* rdtsc - read the time stamp counter (cpu cycles since reset) */
+static inline uint64_t
+rdtsc(void) {
+    uint64_t tsc;
+    asm volatile ("rdtsc" : "=A" (tsc));
+    return tsc;
+}
+
 static inline void
 lcr0(uintptr_t cr0) {
     asm volatile ("mov %0, %%cr0" :: "r" (cr0) : "memory");
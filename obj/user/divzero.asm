@@ -0,0 +1,3762 @@
+
+obj/__user_divzero.out:     file format elf32-i386
+
+
+Disassembly of section .text:
+
+00800020 <opendir>:
+#include <error.h>
+#include <unistd.h>
+
+DIR dir, *dirp=&dir;
+DIR *
+opendir(const char *path) {
+  800020:	55                   	push   %ebp
+  800021:	89 e5                	mov    %esp,%ebp
+  800023:	53                   	push   %ebx
+  800024:	83 ec 24             	sub    $0x24,%esp
+
+    if ((dirp->fd = open(path, O_RDONLY)) < 0) {
+  800027:	8b 1d 00 20 80 00    	mov    0x802000,%ebx
+  80002d:	83 ec 08             	sub    $0x8,%esp
+  800030:	6a 00                	push   $0x0
+  800032:	ff 75 08             	push   0x8(%ebp)
+  800035:	e8 06 01 00 00       	call   800140 <open>
+  80003a:	83 c4 10             	add    $0x10,%esp
+  80003d:	89 03                	mov    %eax,(%ebx)
+  80003f:	8b 03                	mov    (%ebx),%eax
+  800041:	85 c0                	test   %eax,%eax
+  800043:	78 44                	js     800089 <opendir+0x69>
+        goto failed;
+    }
+    struct stat __stat, *stat = &__stat;
+  800045:	8d 45 e4             	lea    -0x1c(%ebp),%eax
+  800048:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (fstat(dirp->fd, stat) != 0 || !S_ISDIR(stat->st_mode)) {
+  80004b:	a1 00 20 80 00       	mov    0x802000,%eax
+  800050:	8b 00                	mov    (%eax),%eax
+  800052:	83 ec 08             	sub    $0x8,%esp
+  800055:	ff 75 f4             	push   -0xc(%ebp)
+  800058:	50                   	push   %eax
+  800059:	e8 d5 01 00 00       	call   800233 <fstat>
+  80005e:	83 c4 10             	add    $0x10,%esp
+  800061:	85 c0                	test   %eax,%eax
+  800063:	75 27                	jne    80008c <opendir+0x6c>
+  800065:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800068:	8b 00                	mov    (%eax),%eax
+  80006a:	25 00 70 00 00       	and    $0x7000,%eax
+  80006f:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  800074:	75 16                	jne    80008c <opendir+0x6c>
+        goto failed;
+    }
+    dirp->dirent.offset = 0;
+  800076:	a1 00 20 80 00       	mov    0x802000,%eax
+  80007b:	c7 40 04 00 00 00 00 	movl   $0x0,0x4(%eax)
+    return dirp;
+  800082:	a1 00 20 80 00       	mov    0x802000,%eax
+  800087:	eb 09                	jmp    800092 <opendir+0x72>
+        goto failed;
+  800089:	90                   	nop
+  80008a:	eb 01                	jmp    80008d <opendir+0x6d>
+        goto failed;
+  80008c:	90                   	nop
+
+failed:
+    return NULL;
+  80008d:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  800092:	8b 5d fc             	mov    -0x4(%ebp),%ebx
+  800095:	c9                   	leave
+  800096:	c3                   	ret
+
+00800097 <readdir>:
+
+struct dirent *
+readdir(DIR *dirp) {
+  800097:	55                   	push   %ebp
+  800098:	89 e5                	mov    %esp,%ebp
+  80009a:	83 ec 08             	sub    $0x8,%esp
+    if (sys_getdirentry(dirp->fd, &(dirp->dirent)) == 0) {
+  80009d:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000a0:	8d 50 04             	lea    0x4(%eax),%edx
+  8000a3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000a6:	8b 00                	mov    (%eax),%eax
+  8000a8:	83 ec 08             	sub    $0x8,%esp
+  8000ab:	52                   	push   %edx
+  8000ac:	50                   	push   %eax
+  8000ad:	e8 b9 07 00 00       	call   80086b <sys_getdirentry>
+  8000b2:	83 c4 10             	add    $0x10,%esp
+  8000b5:	85 c0                	test   %eax,%eax
+  8000b7:	75 08                	jne    8000c1 <readdir+0x2a>
+        return &(dirp->dirent);
+  8000b9:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000bc:	83 c0 04             	add    $0x4,%eax
+  8000bf:	eb 05                	jmp    8000c6 <readdir+0x2f>
+    }
+    return NULL;
+  8000c1:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  8000c6:	c9                   	leave
+  8000c7:	c3                   	ret
+
+008000c8 <closedir>:
+
+void
+closedir(DIR *dirp) {
+  8000c8:	55                   	push   %ebp
+  8000c9:	89 e5                	mov    %esp,%ebp
+  8000cb:	83 ec 08             	sub    $0x8,%esp
+    close(dirp->fd);
+  8000ce:	8b 45 08             	mov    0x8(%ebp),%eax
+  8000d1:	8b 00                	mov    (%eax),%eax
+  8000d3:	83 ec 0c             	sub    $0xc,%esp
+  8000d6:	50                   	push   %eax
+  8000d7:	e8 7d 00 00 00       	call   800159 <close>
+  8000dc:	83 c4 10             	add    $0x10,%esp
+}
+  8000df:	90                   	nop
+  8000e0:	c9                   	leave
+  8000e1:	c3                   	ret
+
+008000e2 <getcwd>:
+
+int
+getcwd(char *buffer, size_t len) {
+  8000e2:	55                   	push   %ebp
+  8000e3:	89 e5                	mov    %esp,%ebp
+  8000e5:	83 ec 08             	sub    $0x8,%esp
+    return sys_getcwd(buffer, len);
+  8000e8:	83 ec 08             	sub    $0x8,%esp
+  8000eb:	ff 75 0c             	push   0xc(%ebp)
+  8000ee:	ff 75 08             	push   0x8(%ebp)
+  8000f1:	e8 12 07 00 00       	call   800808 <sys_getcwd>
+  8000f6:	83 c4 10             	add    $0x10,%esp
+}
+  8000f9:	c9                   	leave
+  8000fa:	c3                   	ret
+
+008000fb <mkdir>:
+
+int mkdir(const char* path)
+{
+  8000fb:	55                   	push   %ebp
+  8000fc:	89 e5                	mov    %esp,%ebp
+  8000fe:	83 ec 08             	sub    $0x8,%esp
+    return sys_mkdir(path);
+  800101:	83 ec 0c             	sub    $0xc,%esp
+  800104:	ff 75 08             	push   0x8(%ebp)
+  800107:	e8 11 07 00 00       	call   80081d <sys_mkdir>
+  80010c:	83 c4 10             	add    $0x10,%esp
+}
+  80010f:	c9                   	leave
+  800110:	c3                   	ret
+
+00800111 <link>:
+
+int link(const char *old_path, const char *new_path) 
+{
+  800111:	55                   	push   %ebp
+  800112:	89 e5                	mov    %esp,%ebp
+  800114:	83 ec 08             	sub    $0x8,%esp
+    return sys_link(old_path, new_path);
+  800117:	83 ec 08             	sub    $0x8,%esp
+  80011a:	ff 75 0c             	push   0xc(%ebp)
+  80011d:	ff 75 08             	push   0x8(%ebp)
+  800120:	e8 0a 07 00 00       	call   80082f <sys_link>
+  800125:	83 c4 10             	add    $0x10,%esp
+}
+  800128:	c9                   	leave
+  800129:	c3                   	ret
+
+0080012a <unlink>:
+
+int unlink(const char *path)
+{
+  80012a:	55                   	push   %ebp
+  80012b:	89 e5                	mov    %esp,%ebp
+  80012d:	83 ec 08             	sub    $0x8,%esp
+    return sys_unlink(path);
+  800130:	83 ec 0c             	sub    $0xc,%esp
+  800133:	ff 75 08             	push   0x8(%ebp)
+  800136:	e8 1e 07 00 00       	call   800859 <sys_unlink>
+  80013b:	83 c4 10             	add    $0x10,%esp
+  80013e:	c9                   	leave
+  80013f:	c3                   	ret
+
+00800140 <open>:
+#include <stat.h>
+#include <error.h>
+#include <unistd.h>
+
+int
+open(const char *path, uint32_t open_flags) {
+  800140:	55                   	push   %ebp
+  800141:	89 e5                	mov    %esp,%ebp
+  800143:	83 ec 08             	sub    $0x8,%esp
+    return sys_open(path, open_flags);
+  800146:	83 ec 08             	sub    $0x8,%esp
+  800149:	ff 75 0c             	push   0xc(%ebp)
+  80014c:	ff 75 08             	push   0x8(%ebp)
+  80014f:	e8 b8 05 00 00       	call   80070c <sys_open>
+  800154:	83 c4 10             	add    $0x10,%esp
+}
+  800157:	c9                   	leave
+  800158:	c3                   	ret
+
+00800159 <close>:
+
+int
+close(int fd) {
+  800159:	55                   	push   %ebp
+  80015a:	89 e5                	mov    %esp,%ebp
+  80015c:	83 ec 08             	sub    $0x8,%esp
+    return sys_close(fd);
+  80015f:	83 ec 0c             	sub    $0xc,%esp
+  800162:	ff 75 08             	push   0x8(%ebp)
+  800165:	e8 b7 05 00 00       	call   800721 <sys_close>
+  80016a:	83 c4 10             	add    $0x10,%esp
+}
+  80016d:	c9                   	leave
+  80016e:	c3                   	ret
+
+0080016f <read>:
+
+int
+read(int fd, void *base, size_t len) {
+  80016f:	55                   	push   %ebp
+  800170:	89 e5                	mov    %esp,%ebp
+  800172:	83 ec 08             	sub    $0x8,%esp
+    return sys_read(fd, base, len);
+  800175:	83 ec 04             	sub    $0x4,%esp
+  800178:	ff 75 10             	push   0x10(%ebp)
+  80017b:	ff 75 0c             	push   0xc(%ebp)
+  80017e:	ff 75 08             	push   0x8(%ebp)
+  800181:	e8 ad 05 00 00       	call   800733 <sys_read>
+  800186:	83 c4 10             	add    $0x10,%esp
+}
+  800189:	c9                   	leave
+  80018a:	c3                   	ret
+
+0080018b <write>:
+
+int
+write(int fd, void *base, size_t len) {
+  80018b:	55                   	push   %ebp
+  80018c:	89 e5                	mov    %esp,%ebp
+  80018e:	83 ec 08             	sub    $0x8,%esp
+    return sys_write(fd, base, len);
+  800191:	83 ec 04             	sub    $0x4,%esp
+  800194:	ff 75 10             	push   0x10(%ebp)
+  800197:	ff 75 0c             	push   0xc(%ebp)
+  80019a:	ff 75 08             	push   0x8(%ebp)
+  80019d:	e8 a9 05 00 00       	call   80074b <sys_write>
+  8001a2:	83 c4 10             	add    $0x10,%esp
+}
+  8001a5:	c9                   	leave
+  8001a6:	c3                   	ret
+
+008001a7 <readv>:
+
+int
+readv(int fd, const struct iovec *iov, int iovcnt) {
+  8001a7:	55                   	push   %ebp
+  8001a8:	89 e5                	mov    %esp,%ebp
+  8001aa:	83 ec 08             	sub    $0x8,%esp
+    return sys_readv(fd, iov, iovcnt);
+  8001ad:	83 ec 04             	sub    $0x4,%esp
+  8001b0:	ff 75 10             	push   0x10(%ebp)
+  8001b3:	ff 75 0c             	push   0xc(%ebp)
+  8001b6:	ff 75 08             	push   0x8(%ebp)
+  8001b9:	e8 a5 05 00 00       	call   800763 <sys_readv>
+  8001be:	83 c4 10             	add    $0x10,%esp
+}
+  8001c1:	c9                   	leave
+  8001c2:	c3                   	ret
+
+008001c3 <writev>:
+
+int
+writev(int fd, const struct iovec *iov, int iovcnt) {
+  8001c3:	55                   	push   %ebp
+  8001c4:	89 e5                	mov    %esp,%ebp
+  8001c6:	83 ec 08             	sub    $0x8,%esp
+    return sys_writev(fd, iov, iovcnt);
+  8001c9:	83 ec 04             	sub    $0x4,%esp
+  8001cc:	ff 75 10             	push   0x10(%ebp)
+  8001cf:	ff 75 0c             	push   0xc(%ebp)
+  8001d2:	ff 75 08             	push   0x8(%ebp)
+  8001d5:	e8 a1 05 00 00       	call   80077b <sys_writev>
+  8001da:	83 c4 10             	add    $0x10,%esp
+}
+  8001dd:	c9                   	leave
+  8001de:	c3                   	ret
+
+008001df <pread>:
+
+int
+pread(int fd, void *base, size_t len, off_t offset) {
+  8001df:	55                   	push   %ebp
+  8001e0:	89 e5                	mov    %esp,%ebp
+  8001e2:	83 ec 08             	sub    $0x8,%esp
+    return sys_pread(fd, base, len, offset);
+  8001e5:	ff 75 14             	push   0x14(%ebp)
+  8001e8:	ff 75 10             	push   0x10(%ebp)
+  8001eb:	ff 75 0c             	push   0xc(%ebp)
+  8001ee:	ff 75 08             	push   0x8(%ebp)
+  8001f1:	e8 9d 05 00 00       	call   800793 <sys_pread>
+  8001f6:	83 c4 10             	add    $0x10,%esp
+}
+  8001f9:	c9                   	leave
+  8001fa:	c3                   	ret
+
+008001fb <pwrite>:
+
+int
+pwrite(int fd, void *base, size_t len, off_t offset) {
+  8001fb:	55                   	push   %ebp
+  8001fc:	89 e5                	mov    %esp,%ebp
+  8001fe:	83 ec 08             	sub    $0x8,%esp
+    return sys_pwrite(fd, base, len, offset);
+  800201:	ff 75 14             	push   0x14(%ebp)
+  800204:	ff 75 10             	push   0x10(%ebp)
+  800207:	ff 75 0c             	push   0xc(%ebp)
+  80020a:	ff 75 08             	push   0x8(%ebp)
+  80020d:	e8 9c 05 00 00       	call   8007ae <sys_pwrite>
+  800212:	83 c4 10             	add    $0x10,%esp
+}
+  800215:	c9                   	leave
+  800216:	c3                   	ret
+
+00800217 <seek>:
+
+int
+seek(int fd, off_t pos, int whence) {
+  800217:	55                   	push   %ebp
+  800218:	89 e5                	mov    %esp,%ebp
+  80021a:	83 ec 08             	sub    $0x8,%esp
+    return sys_seek(fd, pos, whence);
+  80021d:	83 ec 04             	sub    $0x4,%esp
+  800220:	ff 75 10             	push   0x10(%ebp)
+  800223:	ff 75 0c             	push   0xc(%ebp)
+  800226:	ff 75 08             	push   0x8(%ebp)
+  800229:	e8 9b 05 00 00       	call   8007c9 <sys_seek>
+  80022e:	83 c4 10             	add    $0x10,%esp
+}
+  800231:	c9                   	leave
+  800232:	c3                   	ret
+
+00800233 <fstat>:
+
+int
+fstat(int fd, struct stat *stat) {
+  800233:	55                   	push   %ebp
+  800234:	89 e5                	mov    %esp,%ebp
+  800236:	83 ec 08             	sub    $0x8,%esp
+    return sys_fstat(fd, stat);
+  800239:	83 ec 08             	sub    $0x8,%esp
+  80023c:	ff 75 0c             	push   0xc(%ebp)
+  80023f:	ff 75 08             	push   0x8(%ebp)
+  800242:	e8 9a 05 00 00       	call   8007e1 <sys_fstat>
+  800247:	83 c4 10             	add    $0x10,%esp
+}
+  80024a:	c9                   	leave
+  80024b:	c3                   	ret
+
+0080024c <fsync>:
+
+int
+fsync(int fd) {
+  80024c:	55                   	push   %ebp
+  80024d:	89 e5                	mov    %esp,%ebp
+  80024f:	83 ec 08             	sub    $0x8,%esp
+    return sys_fsync(fd);
+  800252:	83 ec 0c             	sub    $0xc,%esp
+  800255:	ff 75 08             	push   0x8(%ebp)
+  800258:	e8 99 05 00 00       	call   8007f6 <sys_fsync>
+  80025d:	83 c4 10             	add    $0x10,%esp
+}
+  800260:	c9                   	leave
+  800261:	c3                   	ret
+
+00800262 <dup2>:
+
+int
+dup2(int fd1, int fd2) {
+  800262:	55                   	push   %ebp
+  800263:	89 e5                	mov    %esp,%ebp
+  800265:	83 ec 08             	sub    $0x8,%esp
+    return sys_dup(fd1, fd2);
+  800268:	83 ec 08             	sub    $0x8,%esp
+  80026b:	ff 75 0c             	push   0xc(%ebp)
+  80026e:	ff 75 08             	push   0x8(%ebp)
+  800271:	e8 0d 06 00 00       	call   800883 <sys_dup>
+  800276:	83 c4 10             	add    $0x10,%esp
+}
+  800279:	c9                   	leave
+  80027a:	c3                   	ret
+
+0080027b <pipe>:
+
+int
+pipe(int *fd_store) {
+  80027b:	55                   	push   %ebp
+  80027c:	89 e5                	mov    %esp,%ebp
+  80027e:	83 ec 08             	sub    $0x8,%esp
+    return sys_pipe(fd_store);
+  800281:	83 ec 0c             	sub    $0xc,%esp
+  800284:	ff 75 08             	push   0x8(%ebp)
+  800287:	e8 0f 06 00 00       	call   80089b <sys_pipe>
+  80028c:	83 c4 10             	add    $0x10,%esp
+}
+  80028f:	c9                   	leave
+  800290:	c3                   	ret
+
+00800291 <transmode>:
+
+static char
+transmode(struct stat *stat) {
+  800291:	55                   	push   %ebp
+  800292:	89 e5                	mov    %esp,%ebp
+  800294:	83 ec 10             	sub    $0x10,%esp
+    uint32_t mode = stat->st_mode;
+  800297:	8b 45 08             	mov    0x8(%ebp),%eax
+  80029a:	8b 00                	mov    (%eax),%eax
+  80029c:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    if (S_ISREG(mode)) return 'r';
+  80029f:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002a2:	25 00 70 00 00       	and    $0x7000,%eax
+  8002a7:	3d 00 10 00 00       	cmp    $0x1000,%eax
+  8002ac:	75 07                	jne    8002b5 <transmode+0x24>
+  8002ae:	b8 72 00 00 00       	mov    $0x72,%eax
+  8002b3:	eb 5d                	jmp    800312 <transmode+0x81>
+    if (S_ISDIR(mode)) return 'd';
+  8002b5:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002b8:	25 00 70 00 00       	and    $0x7000,%eax
+  8002bd:	3d 00 20 00 00       	cmp    $0x2000,%eax
+  8002c2:	75 07                	jne    8002cb <transmode+0x3a>
+  8002c4:	b8 64 00 00 00       	mov    $0x64,%eax
+  8002c9:	eb 47                	jmp    800312 <transmode+0x81>
+    if (S_ISLNK(mode)) return 'l';
+  8002cb:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002ce:	25 00 70 00 00       	and    $0x7000,%eax
+  8002d3:	3d 00 30 00 00       	cmp    $0x3000,%eax
+  8002d8:	75 07                	jne    8002e1 <transmode+0x50>
+  8002da:	b8 6c 00 00 00       	mov    $0x6c,%eax
+  8002df:	eb 31                	jmp    800312 <transmode+0x81>
+    if (S_ISCHR(mode)) return 'c';
+  8002e1:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002e4:	25 00 70 00 00       	and    $0x7000,%eax
+  8002e9:	3d 00 40 00 00       	cmp    $0x4000,%eax
+  8002ee:	75 07                	jne    8002f7 <transmode+0x66>
+  8002f0:	b8 63 00 00 00       	mov    $0x63,%eax
+  8002f5:	eb 1b                	jmp    800312 <transmode+0x81>
+    if (S_ISBLK(mode)) return 'b';
+  8002f7:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8002fa:	25 00 70 00 00       	and    $0x7000,%eax
+  8002ff:	3d 00 50 00 00       	cmp    $0x5000,%eax
+  800304:	75 07                	jne    80030d <transmode+0x7c>
+  800306:	b8 62 00 00 00       	mov    $0x62,%eax
+  80030b:	eb 05                	jmp    800312 <transmode+0x81>
+    return '-';
+  80030d:	b8 2d 00 00 00       	mov    $0x2d,%eax
+}
+  800312:	c9                   	leave
+  800313:	c3                   	ret
+
+00800314 <print_stat>:
+
+void
+print_stat(const char *name, int fd, struct stat *stat) {
+  800314:	55                   	push   %ebp
+  800315:	89 e5                	mov    %esp,%ebp
+  800317:	83 ec 08             	sub    $0x8,%esp
+    cprintf("[%03d] %s\n", fd, name);
+  80031a:	83 ec 04             	sub    $0x4,%esp
+  80031d:	ff 75 08             	push   0x8(%ebp)
+  800320:	ff 75 0c             	push   0xc(%ebp)
+  800323:	68 80 18 80 00       	push   $0x801880
+  800328:	e8 6f 01 00 00       	call   80049c <cprintf>
+  80032d:	83 c4 10             	add    $0x10,%esp
+    cprintf("    mode    : %c\n", transmode(stat));
+  800330:	83 ec 0c             	sub    $0xc,%esp
+  800333:	ff 75 10             	push   0x10(%ebp)
+  800336:	e8 56 ff ff ff       	call   800291 <transmode>
+  80033b:	83 c4 10             	add    $0x10,%esp
+  80033e:	0f be c0             	movsbl %al,%eax
+  800341:	83 ec 08             	sub    $0x8,%esp
+  800344:	50                   	push   %eax
+  800345:	68 8b 18 80 00       	push   $0x80188b
+  80034a:	e8 4d 01 00 00       	call   80049c <cprintf>
+  80034f:	83 c4 10             	add    $0x10,%esp
+    cprintf("    links   : %lu\n", stat->st_nlinks);
+  800352:	8b 45 10             	mov    0x10(%ebp),%eax
+  800355:	8b 40 04             	mov    0x4(%eax),%eax
+  800358:	83 ec 08             	sub    $0x8,%esp
+  80035b:	50                   	push   %eax
+  80035c:	68 9d 18 80 00       	push   $0x80189d
+  800361:	e8 36 01 00 00       	call   80049c <cprintf>
+  800366:	83 c4 10             	add    $0x10,%esp
+    cprintf("    blocks  : %lu\n", stat->st_blocks);
+  800369:	8b 45 10             	mov    0x10(%ebp),%eax
+  80036c:	8b 40 08             	mov    0x8(%eax),%eax
+  80036f:	83 ec 08             	sub    $0x8,%esp
+  800372:	50                   	push   %eax
+  800373:	68 b0 18 80 00       	push   $0x8018b0
+  800378:	e8 1f 01 00 00       	call   80049c <cprintf>
+  80037d:	83 c4 10             	add    $0x10,%esp
+    cprintf("    size    : %lu\n", stat->st_size);
+  800380:	8b 45 10             	mov    0x10(%ebp),%eax
+  800383:	8b 40 0c             	mov    0xc(%eax),%eax
+  800386:	83 ec 08             	sub    $0x8,%esp
+  800389:	50                   	push   %eax
+  80038a:	68 c3 18 80 00       	push   $0x8018c3
+  80038f:	e8 08 01 00 00       	call   80049c <cprintf>
+  800394:	83 c4 10             	add    $0x10,%esp
+}
+  800397:	90                   	nop
+  800398:	c9                   	leave
+  800399:	c3                   	ret
+
+0080039a <_start>:
+.text
+.globl _start
+_start:
+    # set ebp for backtrace
+    movl $0x0, %ebp
+  80039a:	bd 00 00 00 00       	mov    $0x0,%ebp
+
+    # load argc and argv
+    movl (%esp), %ebx
+  80039f:	8b 1c 24             	mov    (%esp),%ebx
+    lea 0x4(%esp), %ecx
+  8003a2:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+
+
+    # move down the esp register
+    # since it may cause page fault in backtrace
+    subl $0x20, %esp
+  8003a6:	83 ec 20             	sub    $0x20,%esp
+
+    # save argc and argv on stack
+    pushl %ecx
+  8003a9:	51                   	push   %ecx
+    pushl %ebx
+  8003aa:	53                   	push   %ebx
+
+    # call user-program function
+    call umain
+  8003ab:	e8 ba 07 00 00       	call   800b6a <umain>
+1:  jmp 1b
+  8003b0:	eb fe                	jmp    8003b0 <_start+0x16>
+
+008003b2 <__panic>:
+#include <stdio.h>
+#include <ulib.h>
+#include <error.h>
+
+void
+__panic(const char *file, int line, const char *fmt, ...) {
+  8003b2:	55                   	push   %ebp
+  8003b3:	89 e5                	mov    %esp,%ebp
+  8003b5:	83 ec 18             	sub    $0x18,%esp
+    // print the 'message'
+    va_list ap;
+    va_start(ap, fmt);
+  8003b8:	8d 45 14             	lea    0x14(%ebp),%eax
+  8003bb:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user panic at %s:%d:\n    ", file, line);
+  8003be:	83 ec 04             	sub    $0x4,%esp
+  8003c1:	ff 75 0c             	push   0xc(%ebp)
+  8003c4:	ff 75 08             	push   0x8(%ebp)
+  8003c7:	68 d6 18 80 00       	push   $0x8018d6
+  8003cc:	e8 cb 00 00 00       	call   80049c <cprintf>
+  8003d1:	83 c4 10             	add    $0x10,%esp
+    vcprintf(fmt, ap);
+  8003d4:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8003d7:	83 ec 08             	sub    $0x8,%esp
+  8003da:	50                   	push   %eax
+  8003db:	ff 75 10             	push   0x10(%ebp)
+  8003de:	e8 88 00 00 00       	call   80046b <vcprintf>
+  8003e3:	83 c4 10             	add    $0x10,%esp
+    cprintf("\n");
+  8003e6:	83 ec 0c             	sub    $0xc,%esp
+  8003e9:	68 f0 18 80 00       	push   $0x8018f0
+  8003ee:	e8 a9 00 00 00       	call   80049c <cprintf>
+  8003f3:	83 c4 10             	add    $0x10,%esp
+    va_end(ap);
+    exit(-E_PANIC);
+  8003f6:	83 ec 0c             	sub    $0xc,%esp
+  8003f9:	6a f6                	push   $0xfffffff6
+  8003fb:	e8 82 05 00 00       	call   800982 <exit>
+
+00800400 <__warn>:
+}
+
+void
+__warn(const char *file, int line, const char *fmt, ...) {
+  800400:	55                   	push   %ebp
+  800401:	89 e5                	mov    %esp,%ebp
+  800403:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+    va_start(ap, fmt);
+  800406:	8d 45 14             	lea    0x14(%ebp),%eax
+  800409:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    cprintf("user warning at %s:%d:\n    ", file, line);
+  80040c:	83 ec 04             	sub    $0x4,%esp
+  80040f:	ff 75 0c             	push   0xc(%ebp)
+  800412:	ff 75 08             	push   0x8(%ebp)
+  800415:	68 f2 18 80 00       	push   $0x8018f2
+  80041a:	e8 7d 00 00 00       	call   80049c <cprintf>
+  80041f:	83 c4 10             	add    $0x10,%esp
+    vcprintf(fmt, ap);
+  800422:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800425:	83 ec 08             	sub    $0x8,%esp
+  800428:	50                   	push   %eax
+  800429:	ff 75 10             	push   0x10(%ebp)
+  80042c:	e8 3a 00 00 00       	call   80046b <vcprintf>
+  800431:	83 c4 10             	add    $0x10,%esp
+    cprintf("\n");
+  800434:	83 ec 0c             	sub    $0xc,%esp
+  800437:	68 f0 18 80 00       	push   $0x8018f0
+  80043c:	e8 5b 00 00 00       	call   80049c <cprintf>
+  800441:	83 c4 10             	add    $0x10,%esp
+    va_end(ap);
+}
+  800444:	90                   	nop
+  800445:	c9                   	leave
+  800446:	c3                   	ret
+
+00800447 <cputch>:
+/* *
+ * cputch - writes a single character @c to stdout, and it will
+ * increace the value of counter pointed by @cnt.
+ * */
+static void
+cputch(int c, int *cnt) {
+  800447:	55                   	push   %ebp
+  800448:	89 e5                	mov    %esp,%ebp
+  80044a:	83 ec 08             	sub    $0x8,%esp
+    sys_putc(c);
+  80044d:	83 ec 0c             	sub    $0xc,%esp
+  800450:	ff 75 08             	push   0x8(%ebp)
+  800453:	e8 44 02 00 00       	call   80069c <sys_putc>
+  800458:	83 c4 10             	add    $0x10,%esp
+    (*cnt) ++;
+  80045b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80045e:	8b 00                	mov    (%eax),%eax
+  800460:	8d 50 01             	lea    0x1(%eax),%edx
+  800463:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800466:	89 10                	mov    %edx,(%eax)
+}
+  800468:	90                   	nop
+  800469:	c9                   	leave
+  80046a:	c3                   	ret
+
+0080046b <vcprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want cprintf() instead.
+ * */
+int
+vcprintf(const char *fmt, va_list ap) {
+  80046b:	55                   	push   %ebp
+  80046c:	89 e5                	mov    %esp,%ebp
+  80046e:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800471:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)cputch, NO_FD, &cnt, fmt, ap);
+  800478:	83 ec 0c             	sub    $0xc,%esp
+  80047b:	ff 75 0c             	push   0xc(%ebp)
+  80047e:	ff 75 08             	push   0x8(%ebp)
+  800481:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800484:	50                   	push   %eax
+  800485:	68 d9 6a ff ff       	push   $0xffff6ad9
+  80048a:	68 47 04 80 00       	push   $0x800447
+  80048f:	e8 3a 09 00 00       	call   800dce <vprintfmt>
+  800494:	83 c4 20             	add    $0x20,%esp
+    return cnt;
+  800497:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  80049a:	c9                   	leave
+  80049b:	c3                   	ret
+
+0080049c <cprintf>:
+ *
+ * The return value is the number of characters which would be
+ * written to stdout.
+ * */
+int
+cprintf(const char *fmt, ...) {
+  80049c:	55                   	push   %ebp
+  80049d:	89 e5                	mov    %esp,%ebp
+  80049f:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  8004a2:	8d 45 0c             	lea    0xc(%ebp),%eax
+  8004a5:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vcprintf(fmt, ap);
+  8004a8:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8004ab:	83 ec 08             	sub    $0x8,%esp
+  8004ae:	50                   	push   %eax
+  8004af:	ff 75 08             	push   0x8(%ebp)
+  8004b2:	e8 b4 ff ff ff       	call   80046b <vcprintf>
+  8004b7:	83 c4 10             	add    $0x10,%esp
+  8004ba:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  8004bd:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  8004c0:	c9                   	leave
+  8004c1:	c3                   	ret
+
+008004c2 <cputs>:
+/* *
+ * cputs- writes the string pointed by @str to stdout and
+ * appends a newline character.
+ * */
+int
+cputs(const char *str) {
+  8004c2:	55                   	push   %ebp
+  8004c3:	89 e5                	mov    %esp,%ebp
+  8004c5:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  8004c8:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+    char c;
+    while ((c = *str ++) != '\0') {
+  8004cf:	eb 14                	jmp    8004e5 <cputs+0x23>
+        cputch(c, &cnt);
+  8004d1:	0f be 45 f7          	movsbl -0x9(%ebp),%eax
+  8004d5:	83 ec 08             	sub    $0x8,%esp
+  8004d8:	8d 55 f0             	lea    -0x10(%ebp),%edx
+  8004db:	52                   	push   %edx
+  8004dc:	50                   	push   %eax
+  8004dd:	e8 65 ff ff ff       	call   800447 <cputch>
+  8004e2:	83 c4 10             	add    $0x10,%esp
+    while ((c = *str ++) != '\0') {
+  8004e5:	8b 45 08             	mov    0x8(%ebp),%eax
+  8004e8:	8d 50 01             	lea    0x1(%eax),%edx
+  8004eb:	89 55 08             	mov    %edx,0x8(%ebp)
+  8004ee:	0f b6 00             	movzbl (%eax),%eax
+  8004f1:	88 45 f7             	mov    %al,-0x9(%ebp)
+  8004f4:	80 7d f7 00          	cmpb   $0x0,-0x9(%ebp)
+  8004f8:	75 d7                	jne    8004d1 <cputs+0xf>
+    }
+    cputch('\n', &cnt);
+  8004fa:	83 ec 08             	sub    $0x8,%esp
+  8004fd:	8d 45 f0             	lea    -0x10(%ebp),%eax
+  800500:	50                   	push   %eax
+  800501:	6a 0a                	push   $0xa
+  800503:	e8 3f ff ff ff       	call   800447 <cputch>
+  800508:	83 c4 10             	add    $0x10,%esp
+    return cnt;
+  80050b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+}
+  80050e:	c9                   	leave
+  80050f:	c3                   	ret
+
+00800510 <fputch>:
+
+
+static void
+fputch(char c, int *cnt, int fd) {
+  800510:	55                   	push   %ebp
+  800511:	89 e5                	mov    %esp,%ebp
+  800513:	83 ec 18             	sub    $0x18,%esp
+  800516:	8b 45 08             	mov    0x8(%ebp),%eax
+  800519:	88 45 f4             	mov    %al,-0xc(%ebp)
+    write(fd, &c, sizeof(char));
+  80051c:	83 ec 04             	sub    $0x4,%esp
+  80051f:	6a 01                	push   $0x1
+  800521:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800524:	50                   	push   %eax
+  800525:	ff 75 10             	push   0x10(%ebp)
+  800528:	e8 5e fc ff ff       	call   80018b <write>
+  80052d:	83 c4 10             	add    $0x10,%esp
+    (*cnt) ++;
+  800530:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800533:	8b 00                	mov    (%eax),%eax
+  800535:	8d 50 01             	lea    0x1(%eax),%edx
+  800538:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80053b:	89 10                	mov    %edx,(%eax)
+}
+  80053d:	90                   	nop
+  80053e:	c9                   	leave
+  80053f:	c3                   	ret
+
+00800540 <vfprintf>:
+
+int
+vfprintf(int fd, const char *fmt, va_list ap) {
+  800540:	55                   	push   %ebp
+  800541:	89 e5                	mov    %esp,%ebp
+  800543:	83 ec 18             	sub    $0x18,%esp
+    int cnt = 0;
+  800546:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    vprintfmt((void*)fputch, fd, &cnt, fmt, ap);
+  80054d:	83 ec 0c             	sub    $0xc,%esp
+  800550:	ff 75 10             	push   0x10(%ebp)
+  800553:	ff 75 0c             	push   0xc(%ebp)
+  800556:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800559:	50                   	push   %eax
+  80055a:	ff 75 08             	push   0x8(%ebp)
+  80055d:	68 10 05 80 00       	push   $0x800510
+  800562:	e8 67 08 00 00       	call   800dce <vprintfmt>
+  800567:	83 c4 20             	add    $0x20,%esp
+    return cnt;
+  80056a:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  80056d:	c9                   	leave
+  80056e:	c3                   	ret
+
+0080056f <fprintf>:
+
+int
+fprintf(int fd, const char *fmt, ...) {
+  80056f:	55                   	push   %ebp
+  800570:	89 e5                	mov    %esp,%ebp
+  800572:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800575:	8d 45 10             	lea    0x10(%ebp),%eax
+  800578:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    int cnt = vfprintf(fd, fmt, ap);
+  80057b:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80057e:	83 ec 04             	sub    $0x4,%esp
+  800581:	50                   	push   %eax
+  800582:	ff 75 0c             	push   0xc(%ebp)
+  800585:	ff 75 08             	push   0x8(%ebp)
+  800588:	e8 b3 ff ff ff       	call   800540 <vfprintf>
+  80058d:	83 c4 10             	add    $0x10,%esp
+  800590:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+
+    return cnt;
+  800593:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800596:	c9                   	leave
+  800597:	c3                   	ret
+
+00800598 <syscall>:
+
+
+#define MAX_ARGS            5
+
+static inline int
+syscall(int num, ...) {
+  800598:	55                   	push   %ebp
+  800599:	89 e5                	mov    %esp,%ebp
+  80059b:	57                   	push   %edi
+  80059c:	56                   	push   %esi
+  80059d:	53                   	push   %ebx
+  80059e:	83 ec 20             	sub    $0x20,%esp
+    va_list ap;
+    va_start(ap, num);
+  8005a1:	8d 45 0c             	lea    0xc(%ebp),%eax
+  8005a4:	89 45 e8             	mov    %eax,-0x18(%ebp)
+    uint32_t a[MAX_ARGS];
+    int i, ret;
+    for (i = 0; i < MAX_ARGS; i ++) {
+  8005a7:	c7 45 f0 00 00 00 00 	movl   $0x0,-0x10(%ebp)
+  8005ae:	eb 16                	jmp    8005c6 <syscall+0x2e>
+        a[i] = va_arg(ap, uint32_t);
+  8005b0:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8005b3:	8d 50 04             	lea    0x4(%eax),%edx
+  8005b6:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  8005b9:	8b 10                	mov    (%eax),%edx
+  8005bb:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8005be:	89 54 85 d4          	mov    %edx,-0x2c(%ebp,%eax,4)
+    for (i = 0; i < MAX_ARGS; i ++) {
+  8005c2:	83 45 f0 01          	addl   $0x1,-0x10(%ebp)
+  8005c6:	83 7d f0 04          	cmpl   $0x4,-0x10(%ebp)
+  8005ca:	7e e4                	jle    8005b0 <syscall+0x18>
+    asm volatile (
+        "int %1;"
+        : "=a" (ret)
+        : "i" (T_SYSCALL),
+          "a" (num),
+          "d" (a[0]),
+  8005cc:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+          "c" (a[1]),
+  8005cf:	8b 4d d8             	mov    -0x28(%ebp),%ecx
+          "b" (a[2]),
+  8005d2:	8b 5d dc             	mov    -0x24(%ebp),%ebx
+          "D" (a[3]),
+  8005d5:	8b 7d e0             	mov    -0x20(%ebp),%edi
+          "S" (a[4])
+  8005d8:	8b 75 e4             	mov    -0x1c(%ebp),%esi
+    asm volatile (
+  8005db:	8b 45 08             	mov    0x8(%ebp),%eax
+  8005de:	cd 80                	int    $0x80
+  8005e0:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "cc", "memory");
+    return ret;
+  8005e3:	8b 45 ec             	mov    -0x14(%ebp),%eax
+}
+  8005e6:	83 c4 20             	add    $0x20,%esp
+  8005e9:	5b                   	pop    %ebx
+  8005ea:	5e                   	pop    %esi
+  8005eb:	5f                   	pop    %edi
+  8005ec:	5d                   	pop    %ebp
+  8005ed:	c3                   	ret
+
+008005ee <sys_exit>:
+
+int
+sys_exit(int error_code) {
+  8005ee:	55                   	push   %ebp
+  8005ef:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_exit, error_code);
+  8005f1:	ff 75 08             	push   0x8(%ebp)
+  8005f4:	6a 01                	push   $0x1
+  8005f6:	e8 9d ff ff ff       	call   800598 <syscall>
+  8005fb:	83 c4 08             	add    $0x8,%esp
+}
+  8005fe:	c9                   	leave
+  8005ff:	c3                   	ret
+
+00800600 <sys_fork>:
+
+int
+sys_fork(void) {
+  800600:	55                   	push   %ebp
+  800601:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fork);
+  800603:	6a 02                	push   $0x2
+  800605:	e8 8e ff ff ff       	call   800598 <syscall>
+  80060a:	83 c4 04             	add    $0x4,%esp
+}
+  80060d:	c9                   	leave
+  80060e:	c3                   	ret
+
+0080060f <sys_wait>:
+
+int
+sys_wait(int pid, int *store) {
+  80060f:	55                   	push   %ebp
+  800610:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_wait, pid, store);
+  800612:	ff 75 0c             	push   0xc(%ebp)
+  800615:	ff 75 08             	push   0x8(%ebp)
+  800618:	6a 03                	push   $0x3
+  80061a:	e8 79 ff ff ff       	call   800598 <syscall>
+  80061f:	83 c4 0c             	add    $0xc,%esp
+}
+  800622:	c9                   	leave
+  800623:	c3                   	ret
+
+00800624 <sys_yield>:
+
+int
+sys_yield(void) {
+  800624:	55                   	push   %ebp
+  800625:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_yield);
+  800627:	6a 0a                	push   $0xa
+  800629:	e8 6a ff ff ff       	call   800598 <syscall>
+  80062e:	83 c4 04             	add    $0x4,%esp
+}
+  800631:	c9                   	leave
+  800632:	c3                   	ret
+
+00800633 <sys_kill>:
+
+int
+sys_kill(int pid) {
+  800633:	55                   	push   %ebp
+  800634:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_kill, pid);
+  800636:	ff 75 08             	push   0x8(%ebp)
+  800639:	6a 0c                	push   $0xc
+  80063b:	e8 58 ff ff ff       	call   800598 <syscall>
+  800640:	83 c4 08             	add    $0x8,%esp
+}
+  800643:	c9                   	leave
+  800644:	c3                   	ret
+
+00800645 <sys_getpid>:
+
+int
+sys_getpid(void) {
+  800645:	55                   	push   %ebp
+  800646:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_getpid);
+  800648:	6a 12                	push   $0x12
+  80064a:	e8 49 ff ff ff       	call   800598 <syscall>
+  80064f:	83 c4 04             	add    $0x4,%esp
+}
+  800652:	c9                   	leave
+  800653:	c3                   	ret
+
+00800654 <sys_mmap>:
+
+int
+sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags, int fd, off_t offset) {
+  800654:	55                   	push   %ebp
+  800655:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_mmap, addr_store, len, mmap_flags, fd, offset);
+  800657:	ff 75 18             	push   0x18(%ebp)
+  80065a:	ff 75 14             	push   0x14(%ebp)
+  80065d:	ff 75 10             	push   0x10(%ebp)
+  800660:	ff 75 0c             	push   0xc(%ebp)
+  800663:	ff 75 08             	push   0x8(%ebp)
+  800666:	6a 14                	push   $0x14
+  800668:	e8 2b ff ff ff       	call   800598 <syscall>
+  80066d:	83 c4 18             	add    $0x18,%esp
+}
+  800670:	c9                   	leave
+  800671:	c3                   	ret
+
+00800672 <sys_munmap>:
+
+int
+sys_munmap(uintptr_t addr, size_t len) {
+  800672:	55                   	push   %ebp
+  800673:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_munmap, addr, len);
+  800675:	ff 75 0c             	push   0xc(%ebp)
+  800678:	ff 75 08             	push   0x8(%ebp)
+  80067b:	6a 15                	push   $0x15
+  80067d:	e8 16 ff ff ff       	call   800598 <syscall>
+  800682:	83 c4 0c             	add    $0xc,%esp
+}
+  800685:	c9                   	leave
+  800686:	c3                   	ret
+
+00800687 <sys_msync>:
+
+int
+sys_msync(uintptr_t addr, size_t len) {
+  800687:	55                   	push   %ebp
+  800688:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_msync, addr, len);
+  80068a:	ff 75 0c             	push   0xc(%ebp)
+  80068d:	ff 75 08             	push   0x8(%ebp)
+  800690:	6a 17                	push   $0x17
+  800692:	e8 01 ff ff ff       	call   800598 <syscall>
+  800697:	83 c4 0c             	add    $0xc,%esp
+}
+  80069a:	c9                   	leave
+  80069b:	c3                   	ret
+
+0080069c <sys_putc>:
+
+int
+sys_putc(int c) {
+  80069c:	55                   	push   %ebp
+  80069d:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_putc, c);
+  80069f:	ff 75 08             	push   0x8(%ebp)
+  8006a2:	6a 1e                	push   $0x1e
+  8006a4:	e8 ef fe ff ff       	call   800598 <syscall>
+  8006a9:	83 c4 08             	add    $0x8,%esp
+}
+  8006ac:	c9                   	leave
+  8006ad:	c3                   	ret
+
+008006ae <sys_pgdir>:
+
+int
+sys_pgdir(void) {
+  8006ae:	55                   	push   %ebp
+  8006af:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pgdir);
+  8006b1:	6a 1f                	push   $0x1f
+  8006b3:	e8 e0 fe ff ff       	call   800598 <syscall>
+  8006b8:	83 c4 04             	add    $0x4,%esp
+}
+  8006bb:	c9                   	leave
+  8006bc:	c3                   	ret
+
+008006bd <sys_lab6_set_priority>:
+
+void
+sys_lab6_set_priority(uint32_t priority)
+{
+  8006bd:	55                   	push   %ebp
+  8006be:	89 e5                	mov    %esp,%ebp
+    syscall(SYS_lab6_set_priority, priority);
+  8006c0:	ff 75 08             	push   0x8(%ebp)
+  8006c3:	68 ff 00 00 00       	push   $0xff
+  8006c8:	e8 cb fe ff ff       	call   800598 <syscall>
+  8006cd:	83 c4 08             	add    $0x8,%esp
+}
+  8006d0:	90                   	nop
+  8006d1:	c9                   	leave
+  8006d2:	c3                   	ret
+
+008006d3 <sys_sleep>:
+
+int
+sys_sleep(unsigned int time) {
+  8006d3:	55                   	push   %ebp
+  8006d4:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_sleep, time);
+  8006d6:	ff 75 08             	push   0x8(%ebp)
+  8006d9:	6a 0b                	push   $0xb
+  8006db:	e8 b8 fe ff ff       	call   800598 <syscall>
+  8006e0:	83 c4 08             	add    $0x8,%esp
+}
+  8006e3:	c9                   	leave
+  8006e4:	c3                   	ret
+
+008006e5 <sys_gettime>:
+
+size_t
+sys_gettime(void) {
+  8006e5:	55                   	push   %ebp
+  8006e6:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_gettime);
+  8006e8:	6a 11                	push   $0x11
+  8006ea:	e8 a9 fe ff ff       	call   800598 <syscall>
+  8006ef:	83 c4 04             	add    $0x4,%esp
+}
+  8006f2:	c9                   	leave
+  8006f3:	c3                   	ret
+
+008006f4 <sys_exec>:
+
+int
+sys_exec(const char *name, int argc, const char **argv) {
+  8006f4:	55                   	push   %ebp
+  8006f5:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_exec, name, argc, argv);
+  8006f7:	ff 75 10             	push   0x10(%ebp)
+  8006fa:	ff 75 0c             	push   0xc(%ebp)
+  8006fd:	ff 75 08             	push   0x8(%ebp)
+  800700:	6a 04                	push   $0x4
+  800702:	e8 91 fe ff ff       	call   800598 <syscall>
+  800707:	83 c4 10             	add    $0x10,%esp
+}
+  80070a:	c9                   	leave
+  80070b:	c3                   	ret
+
+0080070c <sys_open>:
+
+int
+sys_open(const char *path, uint32_t open_flags) {
+  80070c:	55                   	push   %ebp
+  80070d:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_open, path, open_flags);
+  80070f:	ff 75 0c             	push   0xc(%ebp)
+  800712:	ff 75 08             	push   0x8(%ebp)
+  800715:	6a 64                	push   $0x64
+  800717:	e8 7c fe ff ff       	call   800598 <syscall>
+  80071c:	83 c4 0c             	add    $0xc,%esp
+}
+  80071f:	c9                   	leave
+  800720:	c3                   	ret
+
+00800721 <sys_close>:
+
+int
+sys_close(int fd) {
+  800721:	55                   	push   %ebp
+  800722:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_close, fd);
+  800724:	ff 75 08             	push   0x8(%ebp)
+  800727:	6a 65                	push   $0x65
+  800729:	e8 6a fe ff ff       	call   800598 <syscall>
+  80072e:	83 c4 08             	add    $0x8,%esp
+}
+  800731:	c9                   	leave
+  800732:	c3                   	ret
+
+00800733 <sys_read>:
+
+int
+sys_read(int fd, void *base, size_t len) {
+  800733:	55                   	push   %ebp
+  800734:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_read, fd, base, len);
+  800736:	ff 75 10             	push   0x10(%ebp)
+  800739:	ff 75 0c             	push   0xc(%ebp)
+  80073c:	ff 75 08             	push   0x8(%ebp)
+  80073f:	6a 66                	push   $0x66
+  800741:	e8 52 fe ff ff       	call   800598 <syscall>
+  800746:	83 c4 10             	add    $0x10,%esp
+}
+  800749:	c9                   	leave
+  80074a:	c3                   	ret
+
+0080074b <sys_write>:
+
+int
+sys_write(int fd, void *base, size_t len) {
+  80074b:	55                   	push   %ebp
+  80074c:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_write, fd, base, len);
+  80074e:	ff 75 10             	push   0x10(%ebp)
+  800751:	ff 75 0c             	push   0xc(%ebp)
+  800754:	ff 75 08             	push   0x8(%ebp)
+  800757:	6a 67                	push   $0x67
+  800759:	e8 3a fe ff ff       	call   800598 <syscall>
+  80075e:	83 c4 10             	add    $0x10,%esp
+}
+  800761:	c9                   	leave
+  800762:	c3                   	ret
+
+00800763 <sys_readv>:
+
+int
+sys_readv(int fd, const struct iovec *iov, int iovcnt) {
+  800763:	55                   	push   %ebp
+  800764:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_readv, fd, iov, iovcnt);
+  800766:	ff 75 10             	push   0x10(%ebp)
+  800769:	ff 75 0c             	push   0xc(%ebp)
+  80076c:	ff 75 08             	push   0x8(%ebp)
+  80076f:	6a 69                	push   $0x69
+  800771:	e8 22 fe ff ff       	call   800598 <syscall>
+  800776:	83 c4 10             	add    $0x10,%esp
+}
+  800779:	c9                   	leave
+  80077a:	c3                   	ret
+
+0080077b <sys_writev>:
+
+int
+sys_writev(int fd, const struct iovec *iov, int iovcnt) {
+  80077b:	55                   	push   %ebp
+  80077c:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_writev, fd, iov, iovcnt);
+  80077e:	ff 75 10             	push   0x10(%ebp)
+  800781:	ff 75 0c             	push   0xc(%ebp)
+  800784:	ff 75 08             	push   0x8(%ebp)
+  800787:	6a 6a                	push   $0x6a
+  800789:	e8 0a fe ff ff       	call   800598 <syscall>
+  80078e:	83 c4 10             	add    $0x10,%esp
+}
+  800791:	c9                   	leave
+  800792:	c3                   	ret
+
+00800793 <sys_pread>:
+
+int
+sys_pread(int fd, void *base, size_t len, off_t offset) {
+  800793:	55                   	push   %ebp
+  800794:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pread, fd, base, len, offset);
+  800796:	ff 75 14             	push   0x14(%ebp)
+  800799:	ff 75 10             	push   0x10(%ebp)
+  80079c:	ff 75 0c             	push   0xc(%ebp)
+  80079f:	ff 75 08             	push   0x8(%ebp)
+  8007a2:	6a 6b                	push   $0x6b
+  8007a4:	e8 ef fd ff ff       	call   800598 <syscall>
+  8007a9:	83 c4 14             	add    $0x14,%esp
+}
+  8007ac:	c9                   	leave
+  8007ad:	c3                   	ret
+
+008007ae <sys_pwrite>:
+
+int
+sys_pwrite(int fd, void *base, size_t len, off_t offset) {
+  8007ae:	55                   	push   %ebp
+  8007af:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pwrite, fd, base, len, offset);
+  8007b1:	ff 75 14             	push   0x14(%ebp)
+  8007b4:	ff 75 10             	push   0x10(%ebp)
+  8007b7:	ff 75 0c             	push   0xc(%ebp)
+  8007ba:	ff 75 08             	push   0x8(%ebp)
+  8007bd:	6a 6c                	push   $0x6c
+  8007bf:	e8 d4 fd ff ff       	call   800598 <syscall>
+  8007c4:	83 c4 14             	add    $0x14,%esp
+}
+  8007c7:	c9                   	leave
+  8007c8:	c3                   	ret
+
+008007c9 <sys_seek>:
+
+int
+sys_seek(int fd, off_t pos, int whence) {
+  8007c9:	55                   	push   %ebp
+  8007ca:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_seek, fd, pos, whence);
+  8007cc:	ff 75 10             	push   0x10(%ebp)
+  8007cf:	ff 75 0c             	push   0xc(%ebp)
+  8007d2:	ff 75 08             	push   0x8(%ebp)
+  8007d5:	6a 68                	push   $0x68
+  8007d7:	e8 bc fd ff ff       	call   800598 <syscall>
+  8007dc:	83 c4 10             	add    $0x10,%esp
+}
+  8007df:	c9                   	leave
+  8007e0:	c3                   	ret
+
+008007e1 <sys_fstat>:
+
+int
+sys_fstat(int fd, struct stat *stat) {
+  8007e1:	55                   	push   %ebp
+  8007e2:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fstat, fd, stat);
+  8007e4:	ff 75 0c             	push   0xc(%ebp)
+  8007e7:	ff 75 08             	push   0x8(%ebp)
+  8007ea:	6a 6e                	push   $0x6e
+  8007ec:	e8 a7 fd ff ff       	call   800598 <syscall>
+  8007f1:	83 c4 0c             	add    $0xc,%esp
+}
+  8007f4:	c9                   	leave
+  8007f5:	c3                   	ret
+
+008007f6 <sys_fsync>:
+
+int
+sys_fsync(int fd) {
+  8007f6:	55                   	push   %ebp
+  8007f7:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_fsync, fd);
+  8007f9:	ff 75 08             	push   0x8(%ebp)
+  8007fc:	6a 6f                	push   $0x6f
+  8007fe:	e8 95 fd ff ff       	call   800598 <syscall>
+  800803:	83 c4 08             	add    $0x8,%esp
+}
+  800806:	c9                   	leave
+  800807:	c3                   	ret
+
+00800808 <sys_getcwd>:
+
+int
+sys_getcwd(char *buffer, size_t len) {
+  800808:	55                   	push   %ebp
+  800809:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_getcwd, buffer, len);
+  80080b:	ff 75 0c             	push   0xc(%ebp)
+  80080e:	ff 75 08             	push   0x8(%ebp)
+  800811:	6a 79                	push   $0x79
+  800813:	e8 80 fd ff ff       	call   800598 <syscall>
+  800818:	83 c4 0c             	add    $0xc,%esp
+}
+  80081b:	c9                   	leave
+  80081c:	c3                   	ret
+
+0080081d <sys_mkdir>:
+
+int sys_mkdir(const char *path) 
+{
+  80081d:	55                   	push   %ebp
+  80081e:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_mkdir, path);
+  800820:	ff 75 08             	push   0x8(%ebp)
+  800823:	6a 7a                	push   $0x7a
+  800825:	e8 6e fd ff ff       	call   800598 <syscall>
+  80082a:	83 c4 08             	add    $0x8,%esp
+}
+  80082d:	c9                   	leave
+  80082e:	c3                   	ret
+
+0080082f <sys_link>:
+
+int sys_link(const char *old_path, const char *new_path) 
+{
+  80082f:	55                   	push   %ebp
+  800830:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_link, old_path, new_path);
+  800832:	ff 75 0c             	push   0xc(%ebp)
+  800835:	ff 75 08             	push   0x8(%ebp)
+  800838:	6a 7b                	push   $0x7b
+  80083a:	e8 59 fd ff ff       	call   800598 <syscall>
+  80083f:	83 c4 0c             	add    $0xc,%esp
+}
+  800842:	c9                   	leave
+  800843:	c3                   	ret
+
+00800844 <sys_rename>:
+
+int sys_rename(const char *old_path, const char *new_path)
+{
+  800844:	55                   	push   %ebp
+  800845:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_rename, old_path, new_path);
+  800847:	ff 75 0c             	push   0xc(%ebp)
+  80084a:	ff 75 08             	push   0x8(%ebp)
+  80084d:	6a 7c                	push   $0x7c
+  80084f:	e8 44 fd ff ff       	call   800598 <syscall>
+  800854:	83 c4 0c             	add    $0xc,%esp
+}
+  800857:	c9                   	leave
+  800858:	c3                   	ret
+
+00800859 <sys_unlink>:
+
+int sys_unlink(const char *path)
+{
+  800859:	55                   	push   %ebp
+  80085a:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_unlink, path);
+  80085c:	ff 75 08             	push   0x8(%ebp)
+  80085f:	6a 7f                	push   $0x7f
+  800861:	e8 32 fd ff ff       	call   800598 <syscall>
+  800866:	83 c4 08             	add    $0x8,%esp
+}
+  800869:	c9                   	leave
+  80086a:	c3                   	ret
+
+0080086b <sys_getdirentry>:
+
+int
+sys_getdirentry(int fd, struct dirent *dirent) {
+  80086b:	55                   	push   %ebp
+  80086c:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_getdirentry, fd, dirent);
+  80086e:	ff 75 0c             	push   0xc(%ebp)
+  800871:	ff 75 08             	push   0x8(%ebp)
+  800874:	68 80 00 00 00       	push   $0x80
+  800879:	e8 1a fd ff ff       	call   800598 <syscall>
+  80087e:	83 c4 0c             	add    $0xc,%esp
+}
+  800881:	c9                   	leave
+  800882:	c3                   	ret
+
+00800883 <sys_dup>:
+
+int
+sys_dup(int fd1, int fd2) {
+  800883:	55                   	push   %ebp
+  800884:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_dup, fd1, fd2);
+  800886:	ff 75 0c             	push   0xc(%ebp)
+  800889:	ff 75 08             	push   0x8(%ebp)
+  80088c:	68 82 00 00 00       	push   $0x82
+  800891:	e8 02 fd ff ff       	call   800598 <syscall>
+  800896:	83 c4 0c             	add    $0xc,%esp
+}
+  800899:	c9                   	leave
+  80089a:	c3                   	ret
+
+0080089b <sys_pipe>:
+
+int
+sys_pipe(int *fd_store) {
+  80089b:	55                   	push   %ebp
+  80089c:	89 e5                	mov    %esp,%ebp
+    return syscall(SYS_pipe, fd_store);
+  80089e:	ff 75 08             	push   0x8(%ebp)
+  8008a1:	6a 6d                	push   $0x6d
+  8008a3:	e8 f0 fc ff ff       	call   800598 <syscall>
+  8008a8:	83 c4 08             	add    $0x8,%esp
+}
+  8008ab:	c9                   	leave
+  8008ac:	c3                   	ret
+
+008008ad <try_lock>:
+lock_init(lock_t *l) {
+    *l = 0;
+}
+
+static inline bool
+try_lock(lock_t *l) {
+  8008ad:	55                   	push   %ebp
+  8008ae:	89 e5                	mov    %esp,%ebp
+  8008b0:	83 ec 10             	sub    $0x10,%esp
+  8008b3:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  8008ba:	8b 45 08             	mov    0x8(%ebp),%eax
+  8008bd:	89 45 f8             	mov    %eax,-0x8(%ebp)
+ * @addr:   the address to count from
+ * */
+static inline bool
+test_and_set_bit(int nr, volatile void *addr) {
+    int oldbit;
+    asm volatile ("btsl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  8008c0:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  8008c3:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8008c6:	0f ab 02             	bts    %eax,(%edx)
+  8008c9:	19 c0                	sbb    %eax,%eax
+  8008cb:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return oldbit != 0;
+  8008ce:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  8008d2:	0f 95 c0             	setne  %al
+  8008d5:	0f b6 c0             	movzbl %al,%eax
+    return test_and_set_bit(0, l);
+}
+  8008d8:	c9                   	leave
+  8008d9:	c3                   	ret
+
+008008da <lock>:
+
+static inline void
+lock(lock_t *l) {
+  8008da:	55                   	push   %ebp
+  8008db:	89 e5                	mov    %esp,%ebp
+  8008dd:	83 ec 18             	sub    $0x18,%esp
+    if (try_lock(l)) {
+  8008e0:	ff 75 08             	push   0x8(%ebp)
+  8008e3:	e8 c5 ff ff ff       	call   8008ad <try_lock>
+  8008e8:	83 c4 04             	add    $0x4,%esp
+  8008eb:	85 c0                	test   %eax,%eax
+  8008ed:	74 3c                	je     80092b <lock+0x51>
+        int step = 0;
+  8008ef:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+        do {
+            yield();
+  8008f6:	e8 eb 00 00 00       	call   8009e6 <yield>
+            if (++ step == 100) {
+  8008fb:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+  8008ff:	83 7d f4 64          	cmpl   $0x64,-0xc(%ebp)
+  800903:	75 14                	jne    800919 <lock+0x3f>
+                step = 0;
+  800905:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+                sleep(10);
+  80090c:	83 ec 0c             	sub    $0xc,%esp
+  80090f:	6a 0a                	push   $0xa
+  800911:	e8 91 01 00 00       	call   800aa7 <sleep>
+  800916:	83 c4 10             	add    $0x10,%esp
+            }
+        } while (try_lock(l));
+  800919:	83 ec 0c             	sub    $0xc,%esp
+  80091c:	ff 75 08             	push   0x8(%ebp)
+  80091f:	e8 89 ff ff ff       	call   8008ad <try_lock>
+  800924:	83 c4 10             	add    $0x10,%esp
+  800927:	85 c0                	test   %eax,%eax
+  800929:	75 cb                	jne    8008f6 <lock+0x1c>
+    }
+}
+  80092b:	90                   	nop
+  80092c:	c9                   	leave
+  80092d:	c3                   	ret
+
+0080092e <unlock>:
+
+static inline void
+unlock(lock_t *l) {
+  80092e:	55                   	push   %ebp
+  80092f:	89 e5                	mov    %esp,%ebp
+  800931:	83 ec 10             	sub    $0x10,%esp
+  800934:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+  80093b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80093e:	89 45 f8             	mov    %eax,-0x8(%ebp)
+ * @addr:   the address to count from
+ * */
+static inline bool
+test_and_clear_bit(int nr, volatile void *addr) {
+    int oldbit;
+    asm volatile ("btrl %2, %1; sbbl %0, %0" : "=r" (oldbit), "=m" (*(volatile long *)addr) : "Ir" (nr) : "memory");
+  800941:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  800944:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  800947:	0f b3 02             	btr    %eax,(%edx)
+  80094a:	19 c0                	sbb    %eax,%eax
+  80094c:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    return oldbit != 0;
+  80094f:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+    test_and_clear_bit(0, l);
+}
+  800953:	90                   	nop
+  800954:	c9                   	leave
+  800955:	c3                   	ret
+
+00800956 <lock_fork>:
+#include <lock.h>
+
+static lock_t fork_lock = INIT_LOCK;
+
+void
+lock_fork(void) {
+  800956:	55                   	push   %ebp
+  800957:	89 e5                	mov    %esp,%ebp
+  800959:	83 ec 08             	sub    $0x8,%esp
+    lock(&fork_lock);
+  80095c:	83 ec 0c             	sub    $0xc,%esp
+  80095f:	68 28 21 80 00       	push   $0x802128
+  800964:	e8 71 ff ff ff       	call   8008da <lock>
+  800969:	83 c4 10             	add    $0x10,%esp
+}
+  80096c:	90                   	nop
+  80096d:	c9                   	leave
+  80096e:	c3                   	ret
+
+0080096f <unlock_fork>:
+
+void
+unlock_fork(void) {
+  80096f:	55                   	push   %ebp
+  800970:	89 e5                	mov    %esp,%ebp
+    unlock(&fork_lock);
+  800972:	68 28 21 80 00       	push   $0x802128
+  800977:	e8 b2 ff ff ff       	call   80092e <unlock>
+  80097c:	83 c4 04             	add    $0x4,%esp
+}
+  80097f:	90                   	nop
+  800980:	c9                   	leave
+  800981:	c3                   	ret
+
+00800982 <exit>:
+
+void
+exit(int error_code) {
+  800982:	55                   	push   %ebp
+  800983:	89 e5                	mov    %esp,%ebp
+  800985:	83 ec 08             	sub    $0x8,%esp
+    sys_exit(error_code);
+  800988:	83 ec 0c             	sub    $0xc,%esp
+  80098b:	ff 75 08             	push   0x8(%ebp)
+  80098e:	e8 5b fc ff ff       	call   8005ee <sys_exit>
+  800993:	83 c4 10             	add    $0x10,%esp
+    cprintf("BUG: exit failed.\n");
+  800996:	83 ec 0c             	sub    $0xc,%esp
+  800999:	68 0e 19 80 00       	push   $0x80190e
+  80099e:	e8 f9 fa ff ff       	call   80049c <cprintf>
+  8009a3:	83 c4 10             	add    $0x10,%esp
+    while (1);
+  8009a6:	90                   	nop
+  8009a7:	eb fd                	jmp    8009a6 <exit+0x24>
+
+008009a9 <fork>:
+}
+
+int
+fork(void) {
+  8009a9:	55                   	push   %ebp
+  8009aa:	89 e5                	mov    %esp,%ebp
+  8009ac:	83 ec 08             	sub    $0x8,%esp
+    return sys_fork();
+  8009af:	e8 4c fc ff ff       	call   800600 <sys_fork>
+}
+  8009b4:	c9                   	leave
+  8009b5:	c3                   	ret
+
+008009b6 <wait>:
+
+int
+wait(void) {
+  8009b6:	55                   	push   %ebp
+  8009b7:	89 e5                	mov    %esp,%ebp
+  8009b9:	83 ec 08             	sub    $0x8,%esp
+    return sys_wait(0, NULL);
+  8009bc:	83 ec 08             	sub    $0x8,%esp
+  8009bf:	6a 00                	push   $0x0
+  8009c1:	6a 00                	push   $0x0
+  8009c3:	e8 47 fc ff ff       	call   80060f <sys_wait>
+  8009c8:	83 c4 10             	add    $0x10,%esp
+}
+  8009cb:	c9                   	leave
+  8009cc:	c3                   	ret
+
+008009cd <waitpid>:
+
+int
+waitpid(int pid, int *store) {
+  8009cd:	55                   	push   %ebp
+  8009ce:	89 e5                	mov    %esp,%ebp
+  8009d0:	83 ec 08             	sub    $0x8,%esp
+    return sys_wait(pid, store);
+  8009d3:	83 ec 08             	sub    $0x8,%esp
+  8009d6:	ff 75 0c             	push   0xc(%ebp)
+  8009d9:	ff 75 08             	push   0x8(%ebp)
+  8009dc:	e8 2e fc ff ff       	call   80060f <sys_wait>
+  8009e1:	83 c4 10             	add    $0x10,%esp
+}
+  8009e4:	c9                   	leave
+  8009e5:	c3                   	ret
+
+008009e6 <yield>:
+
+void
+yield(void) {
+  8009e6:	55                   	push   %ebp
+  8009e7:	89 e5                	mov    %esp,%ebp
+  8009e9:	83 ec 08             	sub    $0x8,%esp
+    sys_yield();
+  8009ec:	e8 33 fc ff ff       	call   800624 <sys_yield>
+}
+  8009f1:	90                   	nop
+  8009f2:	c9                   	leave
+  8009f3:	c3                   	ret
+
+008009f4 <kill>:
+
+int
+kill(int pid) {
+  8009f4:	55                   	push   %ebp
+  8009f5:	89 e5                	mov    %esp,%ebp
+  8009f7:	83 ec 08             	sub    $0x8,%esp
+    return sys_kill(pid);
+  8009fa:	83 ec 0c             	sub    $0xc,%esp
+  8009fd:	ff 75 08             	push   0x8(%ebp)
+  800a00:	e8 2e fc ff ff       	call   800633 <sys_kill>
+  800a05:	83 c4 10             	add    $0x10,%esp
+}
+  800a08:	c9                   	leave
+  800a09:	c3                   	ret
+
+00800a0a <getpid>:
+
+int
+getpid(void) {
+  800a0a:	55                   	push   %ebp
+  800a0b:	89 e5                	mov    %esp,%ebp
+  800a0d:	83 ec 08             	sub    $0x8,%esp
+    return sys_getpid();
+  800a10:	e8 30 fc ff ff       	call   800645 <sys_getpid>
+}
+  800a15:	c9                   	leave
+  800a16:	c3                   	ret
+
+00800a17 <mmap>:
+
+// mmap - map len bytes of the file fd from offset on (fd is NO_FD for zeros), return NULL if it fails
+void *
+mmap(void *addr, size_t len, uint32_t mmap_flags, int fd, off_t offset) {
+  800a17:	55                   	push   %ebp
+  800a18:	89 e5                	mov    %esp,%ebp
+  800a1a:	83 ec 18             	sub    $0x18,%esp
+    uintptr_t addr_store = (uintptr_t)addr;
+  800a1d:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a20:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    if (sys_mmap(&addr_store, len, mmap_flags, fd, offset) != 0) {
+  800a23:	83 ec 0c             	sub    $0xc,%esp
+  800a26:	ff 75 18             	push   0x18(%ebp)
+  800a29:	ff 75 14             	push   0x14(%ebp)
+  800a2c:	ff 75 10             	push   0x10(%ebp)
+  800a2f:	ff 75 0c             	push   0xc(%ebp)
+  800a32:	8d 45 f4             	lea    -0xc(%ebp),%eax
+  800a35:	50                   	push   %eax
+  800a36:	e8 19 fc ff ff       	call   800654 <sys_mmap>
+  800a3b:	83 c4 20             	add    $0x20,%esp
+  800a3e:	85 c0                	test   %eax,%eax
+  800a40:	74 07                	je     800a49 <mmap+0x32>
+        return NULL;
+  800a42:	b8 00 00 00 00       	mov    $0x0,%eax
+  800a47:	eb 03                	jmp    800a4c <mmap+0x35>
+    }
+    return (void *)addr_store;
+  800a49:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800a4c:	c9                   	leave
+  800a4d:	c3                   	ret
+
+00800a4e <munmap>:
+
+int
+munmap(void *addr, size_t len) {
+  800a4e:	55                   	push   %ebp
+  800a4f:	89 e5                	mov    %esp,%ebp
+  800a51:	83 ec 08             	sub    $0x8,%esp
+    return sys_munmap((uintptr_t)addr, len);
+  800a54:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a57:	83 ec 08             	sub    $0x8,%esp
+  800a5a:	ff 75 0c             	push   0xc(%ebp)
+  800a5d:	50                   	push   %eax
+  800a5e:	e8 0f fc ff ff       	call   800672 <sys_munmap>
+  800a63:	83 c4 10             	add    $0x10,%esp
+}
+  800a66:	c9                   	leave
+  800a67:	c3                   	ret
+
+00800a68 <msync>:
+
+int
+msync(void *addr, size_t len) {
+  800a68:	55                   	push   %ebp
+  800a69:	89 e5                	mov    %esp,%ebp
+  800a6b:	83 ec 08             	sub    $0x8,%esp
+    return sys_msync((uintptr_t)addr, len);
+  800a6e:	8b 45 08             	mov    0x8(%ebp),%eax
+  800a71:	83 ec 08             	sub    $0x8,%esp
+  800a74:	ff 75 0c             	push   0xc(%ebp)
+  800a77:	50                   	push   %eax
+  800a78:	e8 0a fc ff ff       	call   800687 <sys_msync>
+  800a7d:	83 c4 10             	add    $0x10,%esp
+}
+  800a80:	c9                   	leave
+  800a81:	c3                   	ret
+
+00800a82 <print_pgdir>:
+
+//print_pgdir - print the PDT&PT
+void
+print_pgdir(void) {
+  800a82:	55                   	push   %ebp
+  800a83:	89 e5                	mov    %esp,%ebp
+  800a85:	83 ec 08             	sub    $0x8,%esp
+    sys_pgdir();
+  800a88:	e8 21 fc ff ff       	call   8006ae <sys_pgdir>
+}
+  800a8d:	90                   	nop
+  800a8e:	c9                   	leave
+  800a8f:	c3                   	ret
+
+00800a90 <lab6_set_priority>:
+
+void
+lab6_set_priority(uint32_t priority)
+{
+  800a90:	55                   	push   %ebp
+  800a91:	89 e5                	mov    %esp,%ebp
+  800a93:	83 ec 08             	sub    $0x8,%esp
+    sys_lab6_set_priority(priority);
+  800a96:	83 ec 0c             	sub    $0xc,%esp
+  800a99:	ff 75 08             	push   0x8(%ebp)
+  800a9c:	e8 1c fc ff ff       	call   8006bd <sys_lab6_set_priority>
+  800aa1:	83 c4 10             	add    $0x10,%esp
+}
+  800aa4:	90                   	nop
+  800aa5:	c9                   	leave
+  800aa6:	c3                   	ret
+
+00800aa7 <sleep>:
+
+int
+sleep(unsigned int time) {
+  800aa7:	55                   	push   %ebp
+  800aa8:	89 e5                	mov    %esp,%ebp
+  800aaa:	83 ec 08             	sub    $0x8,%esp
+    return sys_sleep(time);
+  800aad:	83 ec 0c             	sub    $0xc,%esp
+  800ab0:	ff 75 08             	push   0x8(%ebp)
+  800ab3:	e8 1b fc ff ff       	call   8006d3 <sys_sleep>
+  800ab8:	83 c4 10             	add    $0x10,%esp
+}
+  800abb:	c9                   	leave
+  800abc:	c3                   	ret
+
+00800abd <gettime_msec>:
+
+unsigned int
+gettime_msec(void) {
+  800abd:	55                   	push   %ebp
+  800abe:	89 e5                	mov    %esp,%ebp
+  800ac0:	83 ec 08             	sub    $0x8,%esp
+    return (unsigned int)sys_gettime();
+  800ac3:	e8 1d fc ff ff       	call   8006e5 <sys_gettime>
+}
+  800ac8:	c9                   	leave
+  800ac9:	c3                   	ret
+
+00800aca <__exec>:
+
+int
+__exec(const char *name, const char **argv) {
+  800aca:	55                   	push   %ebp
+  800acb:	89 e5                	mov    %esp,%ebp
+  800acd:	83 ec 18             	sub    $0x18,%esp
+    int argc = 0;
+  800ad0:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  800ad7:	eb 04                	jmp    800add <__exec+0x13>
+        argc ++;
+  800ad9:	83 45 f4 01          	addl   $0x1,-0xc(%ebp)
+    while (argv[argc] != NULL) {
+  800add:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800ae0:	8d 14 85 00 00 00 00 	lea    0x0(,%eax,4),%edx
+  800ae7:	8b 45 0c             	mov    0xc(%ebp),%eax
+  800aea:	01 d0                	add    %edx,%eax
+  800aec:	8b 00                	mov    (%eax),%eax
+  800aee:	85 c0                	test   %eax,%eax
+  800af0:	75 e7                	jne    800ad9 <__exec+0xf>
+    }
+    return sys_exec(name, argc, argv);
+  800af2:	83 ec 04             	sub    $0x4,%esp
+  800af5:	ff 75 0c             	push   0xc(%ebp)
+  800af8:	ff 75 f4             	push   -0xc(%ebp)
+  800afb:	ff 75 08             	push   0x8(%ebp)
+  800afe:	e8 f1 fb ff ff       	call   8006f4 <sys_exec>
+  800b03:	83 c4 10             	add    $0x10,%esp
+}
+  800b06:	c9                   	leave
+  800b07:	c3                   	ret
+
+00800b08 <initfd>:
+#include <stat.h>
+
+int main(int argc, char *argv[]);
+
+static int
+initfd(int fd2, const char *path, uint32_t open_flags) {
+  800b08:	55                   	push   %ebp
+  800b09:	89 e5                	mov    %esp,%ebp
+  800b0b:	83 ec 18             	sub    $0x18,%esp
+    int fd1, ret;
+    if ((fd1 = open(path, open_flags)) < 0) {
+  800b0e:	83 ec 08             	sub    $0x8,%esp
+  800b11:	ff 75 10             	push   0x10(%ebp)
+  800b14:	ff 75 0c             	push   0xc(%ebp)
+  800b17:	e8 24 f6 ff ff       	call   800140 <open>
+  800b1c:	83 c4 10             	add    $0x10,%esp
+  800b1f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800b22:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800b26:	79 05                	jns    800b2d <initfd+0x25>
+        return fd1;
+  800b28:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800b2b:	eb 3b                	jmp    800b68 <initfd+0x60>
+    }
+    if (fd1 != fd2) {
+  800b2d:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800b30:	3b 45 08             	cmp    0x8(%ebp),%eax
+  800b33:	74 30                	je     800b65 <initfd+0x5d>
+        close(fd2);
+  800b35:	83 ec 0c             	sub    $0xc,%esp
+  800b38:	ff 75 08             	push   0x8(%ebp)
+  800b3b:	e8 19 f6 ff ff       	call   800159 <close>
+  800b40:	83 c4 10             	add    $0x10,%esp
+        ret = dup2(fd1, fd2);
+  800b43:	83 ec 08             	sub    $0x8,%esp
+  800b46:	ff 75 08             	push   0x8(%ebp)
+  800b49:	ff 75 f0             	push   -0x10(%ebp)
+  800b4c:	e8 11 f7 ff ff       	call   800262 <dup2>
+  800b51:	83 c4 10             	add    $0x10,%esp
+  800b54:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        close(fd1);
+  800b57:	83 ec 0c             	sub    $0xc,%esp
+  800b5a:	ff 75 f0             	push   -0x10(%ebp)
+  800b5d:	e8 f7 f5 ff ff       	call   800159 <close>
+  800b62:	83 c4 10             	add    $0x10,%esp
+    }
+    return ret;
+  800b65:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  800b68:	c9                   	leave
+  800b69:	c3                   	ret
+
+00800b6a <umain>:
+
+void
+umain(int argc, char *argv[]) {
+  800b6a:	55                   	push   %ebp
+  800b6b:	89 e5                	mov    %esp,%ebp
+  800b6d:	83 ec 18             	sub    $0x18,%esp
+    int fd;
+    if ((fd = initfd(0, "stdin:", O_RDONLY)) < 0) {
+  800b70:	83 ec 04             	sub    $0x4,%esp
+  800b73:	6a 00                	push   $0x0
+  800b75:	68 21 19 80 00       	push   $0x801921
+  800b7a:	6a 00                	push   $0x0
+  800b7c:	e8 87 ff ff ff       	call   800b08 <initfd>
+  800b81:	83 c4 10             	add    $0x10,%esp
+  800b84:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800b87:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800b8b:	79 17                	jns    800ba4 <umain+0x3a>
+        warn("open <stdin> failed: %e.\n", fd);
+  800b8d:	ff 75 f4             	push   -0xc(%ebp)
+  800b90:	68 28 19 80 00       	push   $0x801928
+  800b95:	6a 1a                	push   $0x1a
+  800b97:	68 42 19 80 00       	push   $0x801942
+  800b9c:	e8 5f f8 ff ff       	call   800400 <__warn>
+  800ba1:	83 c4 10             	add    $0x10,%esp
+    }
+    if ((fd = initfd(1, "stdout:", O_WRONLY)) < 0) {
+  800ba4:	83 ec 04             	sub    $0x4,%esp
+  800ba7:	6a 01                	push   $0x1
+  800ba9:	68 54 19 80 00       	push   $0x801954
+  800bae:	6a 01                	push   $0x1
+  800bb0:	e8 53 ff ff ff       	call   800b08 <initfd>
+  800bb5:	83 c4 10             	add    $0x10,%esp
+  800bb8:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800bbb:	83 7d f4 00          	cmpl   $0x0,-0xc(%ebp)
+  800bbf:	79 17                	jns    800bd8 <umain+0x6e>
+        warn("open <stdout> failed: %e.\n", fd);
+  800bc1:	ff 75 f4             	push   -0xc(%ebp)
+  800bc4:	68 5c 19 80 00       	push   $0x80195c
+  800bc9:	6a 1d                	push   $0x1d
+  800bcb:	68 42 19 80 00       	push   $0x801942
+  800bd0:	e8 2b f8 ff ff       	call   800400 <__warn>
+  800bd5:	83 c4 10             	add    $0x10,%esp
+    }
+    int ret = main(argc, argv);
+  800bd8:	83 ec 08             	sub    $0x8,%esp
+  800bdb:	ff 75 0c             	push   0xc(%ebp)
+  800bde:	ff 75 08             	push   0x8(%ebp)
+  800be1:	e8 36 0c 00 00       	call   80181c <main>
+  800be6:	83 c4 10             	add    $0x10,%esp
+  800be9:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    exit(ret);
+  800bec:	83 ec 0c             	sub    $0xc,%esp
+  800bef:	ff 75 f0             	push   -0x10(%ebp)
+  800bf2:	e8 8b fd ff ff       	call   800982 <exit>
+
+00800bf7 <hash32>:
+ * @bits:   the number of bits in a return value
+ *
+ * High bits are more random, so we use them.
+ * */
+uint32_t
+hash32(uint32_t val, unsigned int bits) {
+  800bf7:	55                   	push   %ebp
+  800bf8:	89 e5                	mov    %esp,%ebp
+  800bfa:	83 ec 10             	sub    $0x10,%esp
+    uint32_t hash = val * GOLDEN_RATIO_PRIME_32;
+  800bfd:	8b 45 08             	mov    0x8(%ebp),%eax
+  800c00:	69 c0 01 00 37 9e    	imul   $0x9e370001,%eax,%eax
+  800c06:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    return (hash >> (32 - bits));
+  800c09:	b8 20 00 00 00       	mov    $0x20,%eax
+  800c0e:	2b 45 0c             	sub    0xc(%ebp),%eax
+  800c11:	8b 55 fc             	mov    -0x4(%ebp),%edx
+  800c14:	89 c1                	mov    %eax,%ecx
+  800c16:	d3 ea                	shr    %cl,%edx
+  800c18:	89 d0                	mov    %edx,%eax
+}
+  800c1a:	c9                   	leave
+  800c1b:	c3                   	ret
+
+00800c1c <printnum>:
+ * @width:      maximum number of digits, if the actual width is less than @width, use @padc instead
+ * @padc:       character that padded on the left if the actual width is less than @width
+ * */
+static void
+printnum(void (*putch)(int, void*, int), int fd, void *putdat,
+        unsigned long long num, unsigned base, int width, int padc) {
+  800c1c:	55                   	push   %ebp
+  800c1d:	89 e5                	mov    %esp,%ebp
+  800c1f:	83 ec 38             	sub    $0x38,%esp
+  800c22:	8b 45 14             	mov    0x14(%ebp),%eax
+  800c25:	89 45 d0             	mov    %eax,-0x30(%ebp)
+  800c28:	8b 45 18             	mov    0x18(%ebp),%eax
+  800c2b:	89 45 d4             	mov    %eax,-0x2c(%ebp)
+    unsigned long long result = num;
+  800c2e:	8b 45 d0             	mov    -0x30(%ebp),%eax
+  800c31:	8b 55 d4             	mov    -0x2c(%ebp),%edx
+  800c34:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  800c37:	89 55 ec             	mov    %edx,-0x14(%ebp)
+    unsigned mod = do_div(result, base);
+  800c3a:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  800c3d:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  800c40:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  800c43:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  800c46:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  800c49:	89 55 f0             	mov    %edx,-0x10(%ebp)
+  800c4c:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800c4f:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  800c52:	83 7d f0 00          	cmpl   $0x0,-0x10(%ebp)
+  800c56:	74 1c                	je     800c74 <printnum+0x58>
+  800c58:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800c5b:	ba 00 00 00 00       	mov    $0x0,%edx
+  800c60:	f7 75 e4             	divl   -0x1c(%ebp)
+  800c63:	89 55 f4             	mov    %edx,-0xc(%ebp)
+  800c66:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  800c69:	ba 00 00 00 00       	mov    $0x0,%edx
+  800c6e:	f7 75 e4             	divl   -0x1c(%ebp)
+  800c71:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  800c74:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800c77:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  800c7a:	f7 75 e4             	divl   -0x1c(%ebp)
+  800c7d:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  800c80:	89 55 dc             	mov    %edx,-0x24(%ebp)
+  800c83:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  800c86:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  800c89:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  800c8c:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  800c8f:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800c92:	89 45 d8             	mov    %eax,-0x28(%ebp)
+
+    // first recursively print all preceding (more significant) digits
+    if (num >= base) {
+  800c95:	8b 45 1c             	mov    0x1c(%ebp),%eax
+  800c98:	ba 00 00 00 00       	mov    $0x0,%edx
+  800c9d:	8b 4d d4             	mov    -0x2c(%ebp),%ecx
+  800ca0:	39 45 d0             	cmp    %eax,-0x30(%ebp)
+  800ca3:	19 d1                	sbb    %edx,%ecx
+  800ca5:	72 3a                	jb     800ce1 <printnum+0xc5>
+        printnum(putch, fd, putdat, result, base, width - 1, padc);
+  800ca7:	8b 45 20             	mov    0x20(%ebp),%eax
+  800caa:	83 e8 01             	sub    $0x1,%eax
+  800cad:	ff 75 24             	push   0x24(%ebp)
+  800cb0:	50                   	push   %eax
+  800cb1:	ff 75 1c             	push   0x1c(%ebp)
+  800cb4:	ff 75 ec             	push   -0x14(%ebp)
+  800cb7:	ff 75 e8             	push   -0x18(%ebp)
+  800cba:	ff 75 10             	push   0x10(%ebp)
+  800cbd:	ff 75 0c             	push   0xc(%ebp)
+  800cc0:	ff 75 08             	push   0x8(%ebp)
+  800cc3:	e8 54 ff ff ff       	call   800c1c <printnum>
+  800cc8:	83 c4 20             	add    $0x20,%esp
+  800ccb:	eb 1e                	jmp    800ceb <printnum+0xcf>
+    } else {
+        // print any needed pad characters before first digit
+        while (-- width > 0)
+            putch(padc, putdat, fd);
+  800ccd:	83 ec 04             	sub    $0x4,%esp
+  800cd0:	ff 75 0c             	push   0xc(%ebp)
+  800cd3:	ff 75 10             	push   0x10(%ebp)
+  800cd6:	ff 75 24             	push   0x24(%ebp)
+  800cd9:	8b 45 08             	mov    0x8(%ebp),%eax
+  800cdc:	ff d0                	call   *%eax
+  800cde:	83 c4 10             	add    $0x10,%esp
+        while (-- width > 0)
+  800ce1:	83 6d 20 01          	subl   $0x1,0x20(%ebp)
+  800ce5:	83 7d 20 00          	cmpl   $0x0,0x20(%ebp)
+  800ce9:	7f e2                	jg     800ccd <printnum+0xb1>
+    }
+    // then print this (the least significant) digit
+    putch("0123456789abcdef"[mod], putdat, fd);
+  800ceb:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  800cee:	05 88 1b 80 00       	add    $0x801b88,%eax
+  800cf3:	0f b6 00             	movzbl (%eax),%eax
+  800cf6:	0f be c0             	movsbl %al,%eax
+  800cf9:	83 ec 04             	sub    $0x4,%esp
+  800cfc:	ff 75 0c             	push   0xc(%ebp)
+  800cff:	ff 75 10             	push   0x10(%ebp)
+  800d02:	50                   	push   %eax
+  800d03:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d06:	ff d0                	call   *%eax
+  800d08:	83 c4 10             	add    $0x10,%esp
+}
+  800d0b:	90                   	nop
+  800d0c:	c9                   	leave
+  800d0d:	c3                   	ret
+
+00800d0e <getuint>:
+ * getuint - get an unsigned int of various possible sizes from a varargs list
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static unsigned long long
+getuint(va_list *ap, int lflag) {
+  800d0e:	55                   	push   %ebp
+  800d0f:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  800d11:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  800d15:	7e 14                	jle    800d2b <getuint+0x1d>
+        return va_arg(*ap, unsigned long long);
+  800d17:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d1a:	8b 00                	mov    (%eax),%eax
+  800d1c:	8d 48 08             	lea    0x8(%eax),%ecx
+  800d1f:	8b 55 08             	mov    0x8(%ebp),%edx
+  800d22:	89 0a                	mov    %ecx,(%edx)
+  800d24:	8b 50 04             	mov    0x4(%eax),%edx
+  800d27:	8b 00                	mov    (%eax),%eax
+  800d29:	eb 30                	jmp    800d5b <getuint+0x4d>
+    }
+    else if (lflag) {
+  800d2b:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  800d2f:	74 16                	je     800d47 <getuint+0x39>
+        return va_arg(*ap, unsigned long);
+  800d31:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d34:	8b 00                	mov    (%eax),%eax
+  800d36:	8d 48 04             	lea    0x4(%eax),%ecx
+  800d39:	8b 55 08             	mov    0x8(%ebp),%edx
+  800d3c:	89 0a                	mov    %ecx,(%edx)
+  800d3e:	8b 00                	mov    (%eax),%eax
+  800d40:	ba 00 00 00 00       	mov    $0x0,%edx
+  800d45:	eb 14                	jmp    800d5b <getuint+0x4d>
+    }
+    else {
+        return va_arg(*ap, unsigned int);
+  800d47:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d4a:	8b 00                	mov    (%eax),%eax
+  800d4c:	8d 48 04             	lea    0x4(%eax),%ecx
+  800d4f:	8b 55 08             	mov    0x8(%ebp),%edx
+  800d52:	89 0a                	mov    %ecx,(%edx)
+  800d54:	8b 00                	mov    (%eax),%eax
+  800d56:	ba 00 00 00 00       	mov    $0x0,%edx
+    }
+}
+  800d5b:	5d                   	pop    %ebp
+  800d5c:	c3                   	ret
+
+00800d5d <getint>:
+ * getint - same as getuint but signed, we can't use getuint because of sign extension
+ * @ap:         a varargs list pointer
+ * @lflag:      determines the size of the vararg that @ap points to
+ * */
+static long long
+getint(va_list *ap, int lflag) {
+  800d5d:	55                   	push   %ebp
+  800d5e:	89 e5                	mov    %esp,%ebp
+    if (lflag >= 2) {
+  800d60:	83 7d 0c 01          	cmpl   $0x1,0xc(%ebp)
+  800d64:	7e 14                	jle    800d7a <getint+0x1d>
+        return va_arg(*ap, long long);
+  800d66:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d69:	8b 00                	mov    (%eax),%eax
+  800d6b:	8d 48 08             	lea    0x8(%eax),%ecx
+  800d6e:	8b 55 08             	mov    0x8(%ebp),%edx
+  800d71:	89 0a                	mov    %ecx,(%edx)
+  800d73:	8b 50 04             	mov    0x4(%eax),%edx
+  800d76:	8b 00                	mov    (%eax),%eax
+  800d78:	eb 28                	jmp    800da2 <getint+0x45>
+    }
+    else if (lflag) {
+  800d7a:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  800d7e:	74 12                	je     800d92 <getint+0x35>
+        return va_arg(*ap, long);
+  800d80:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d83:	8b 00                	mov    (%eax),%eax
+  800d85:	8d 48 04             	lea    0x4(%eax),%ecx
+  800d88:	8b 55 08             	mov    0x8(%ebp),%edx
+  800d8b:	89 0a                	mov    %ecx,(%edx)
+  800d8d:	8b 00                	mov    (%eax),%eax
+  800d8f:	99                   	cltd
+  800d90:	eb 10                	jmp    800da2 <getint+0x45>
+    }
+    else {
+        return va_arg(*ap, int);
+  800d92:	8b 45 08             	mov    0x8(%ebp),%eax
+  800d95:	8b 00                	mov    (%eax),%eax
+  800d97:	8d 48 04             	lea    0x4(%eax),%ecx
+  800d9a:	8b 55 08             	mov    0x8(%ebp),%edx
+  800d9d:	89 0a                	mov    %ecx,(%edx)
+  800d9f:	8b 00                	mov    (%eax),%eax
+  800da1:	99                   	cltd
+    }
+}
+  800da2:	5d                   	pop    %ebp
+  800da3:	c3                   	ret
+
+00800da4 <printfmt>:
+ * @fd:         file descriptor
+ * @putdat:     used by @putch function
+ * @fmt:        the format string to use
+ * */
+void
+printfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, ...) {
+  800da4:	55                   	push   %ebp
+  800da5:	89 e5                	mov    %esp,%ebp
+  800da7:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+
+    va_start(ap, fmt);
+  800daa:	8d 45 18             	lea    0x18(%ebp),%eax
+  800dad:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    vprintfmt(putch, fd, putdat, fmt, ap);
+  800db0:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  800db3:	83 ec 0c             	sub    $0xc,%esp
+  800db6:	50                   	push   %eax
+  800db7:	ff 75 14             	push   0x14(%ebp)
+  800dba:	ff 75 10             	push   0x10(%ebp)
+  800dbd:	ff 75 0c             	push   0xc(%ebp)
+  800dc0:	ff 75 08             	push   0x8(%ebp)
+  800dc3:	e8 06 00 00 00       	call   800dce <vprintfmt>
+  800dc8:	83 c4 20             	add    $0x20,%esp
+    va_end(ap);
+}
+  800dcb:	90                   	nop
+  800dcc:	c9                   	leave
+  800dcd:	c3                   	ret
+
+00800dce <vprintfmt>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want printfmt() instead.
+ * */
+void
+vprintfmt(void (*putch)(int, void*, int), int fd, void *putdat, const char *fmt, va_list ap) {
+  800dce:	55                   	push   %ebp
+  800dcf:	89 e5                	mov    %esp,%ebp
+  800dd1:	56                   	push   %esi
+  800dd2:	53                   	push   %ebx
+  800dd3:	83 ec 20             	sub    $0x20,%esp
+    register int ch, err;
+    unsigned long long num;
+    int base, width, precision, lflag, altflag;
+
+    while (1) {
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  800dd6:	eb 1a                	jmp    800df2 <vprintfmt+0x24>
+            if (ch == '\0') {
+  800dd8:	85 db                	test   %ebx,%ebx
+  800dda:	0f 84 c2 03 00 00    	je     8011a2 <vprintfmt+0x3d4>
+                return;
+            }
+            putch(ch, putdat, fd);
+  800de0:	83 ec 04             	sub    $0x4,%esp
+  800de3:	ff 75 0c             	push   0xc(%ebp)
+  800de6:	ff 75 10             	push   0x10(%ebp)
+  800de9:	53                   	push   %ebx
+  800dea:	8b 45 08             	mov    0x8(%ebp),%eax
+  800ded:	ff d0                	call   *%eax
+  800def:	83 c4 10             	add    $0x10,%esp
+        while ((ch = *(unsigned char *)fmt ++) != '%') {
+  800df2:	8b 45 14             	mov    0x14(%ebp),%eax
+  800df5:	8d 50 01             	lea    0x1(%eax),%edx
+  800df8:	89 55 14             	mov    %edx,0x14(%ebp)
+  800dfb:	0f b6 00             	movzbl (%eax),%eax
+  800dfe:	0f b6 d8             	movzbl %al,%ebx
+  800e01:	83 fb 25             	cmp    $0x25,%ebx
+  800e04:	75 d2                	jne    800dd8 <vprintfmt+0xa>
+        }
+
+        // Process a %-escape sequence
+        char padc = ' ';
+  800e06:	c6 45 db 20          	movb   $0x20,-0x25(%ebp)
+        width = precision = -1;
+  800e0a:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+  800e11:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800e14:	89 45 e8             	mov    %eax,-0x18(%ebp)
+        lflag = altflag = 0;
+  800e17:	c7 45 dc 00 00 00 00 	movl   $0x0,-0x24(%ebp)
+  800e1e:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  800e21:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  800e24:	eb 04                	jmp    800e2a <vprintfmt+0x5c>
+            goto process_precision;
+
+        case '.':
+            if (width < 0)
+                width = 0;
+            goto reswitch;
+  800e26:	90                   	nop
+  800e27:	eb 01                	jmp    800e2a <vprintfmt+0x5c>
+            goto reswitch;
+
+        process_precision:
+            if (width < 0)
+                width = precision, precision = -1;
+            goto reswitch;
+  800e29:	90                   	nop
+        switch (ch = *(unsigned char *)fmt ++) {
+  800e2a:	8b 45 14             	mov    0x14(%ebp),%eax
+  800e2d:	8d 50 01             	lea    0x1(%eax),%edx
+  800e30:	89 55 14             	mov    %edx,0x14(%ebp)
+  800e33:	0f b6 00             	movzbl (%eax),%eax
+  800e36:	0f b6 d8             	movzbl %al,%ebx
+  800e39:	8d 43 dd             	lea    -0x23(%ebx),%eax
+  800e3c:	83 f8 55             	cmp    $0x55,%eax
+  800e3f:	0f 87 2d 03 00 00    	ja     801172 <vprintfmt+0x3a4>
+  800e45:	8b 04 85 ac 1b 80 00 	mov    0x801bac(,%eax,4),%eax
+  800e4c:	ff e0                	jmp    *%eax
+            padc = '-';
+  800e4e:	c6 45 db 2d          	movb   $0x2d,-0x25(%ebp)
+            goto reswitch;
+  800e52:	eb d6                	jmp    800e2a <vprintfmt+0x5c>
+            padc = '0';
+  800e54:	c6 45 db 30          	movb   $0x30,-0x25(%ebp)
+            goto reswitch;
+  800e58:	eb d0                	jmp    800e2a <vprintfmt+0x5c>
+            for (precision = 0; ; ++ fmt) {
+  800e5a:	c7 45 e4 00 00 00 00 	movl   $0x0,-0x1c(%ebp)
+                precision = precision * 10 + ch - '0';
+  800e61:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  800e64:	89 d0                	mov    %edx,%eax
+  800e66:	c1 e0 02             	shl    $0x2,%eax
+  800e69:	01 d0                	add    %edx,%eax
+  800e6b:	01 c0                	add    %eax,%eax
+  800e6d:	01 d8                	add    %ebx,%eax
+  800e6f:	83 e8 30             	sub    $0x30,%eax
+  800e72:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+                ch = *fmt;
+  800e75:	8b 45 14             	mov    0x14(%ebp),%eax
+  800e78:	0f b6 00             	movzbl (%eax),%eax
+  800e7b:	0f be d8             	movsbl %al,%ebx
+                if (ch < '0' || ch > '9') {
+  800e7e:	83 fb 2f             	cmp    $0x2f,%ebx
+  800e81:	7e 39                	jle    800ebc <vprintfmt+0xee>
+  800e83:	83 fb 39             	cmp    $0x39,%ebx
+  800e86:	7f 34                	jg     800ebc <vprintfmt+0xee>
+            for (precision = 0; ; ++ fmt) {
+  800e88:	83 45 14 01          	addl   $0x1,0x14(%ebp)
+                precision = precision * 10 + ch - '0';
+  800e8c:	eb d3                	jmp    800e61 <vprintfmt+0x93>
+            precision = va_arg(ap, int);
+  800e8e:	8b 45 18             	mov    0x18(%ebp),%eax
+  800e91:	8d 50 04             	lea    0x4(%eax),%edx
+  800e94:	89 55 18             	mov    %edx,0x18(%ebp)
+  800e97:	8b 00                	mov    (%eax),%eax
+  800e99:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+            goto process_precision;
+  800e9c:	eb 1f                	jmp    800ebd <vprintfmt+0xef>
+            if (width < 0)
+  800e9e:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  800ea2:	79 82                	jns    800e26 <vprintfmt+0x58>
+                width = 0;
+  800ea4:	c7 45 e8 00 00 00 00 	movl   $0x0,-0x18(%ebp)
+            goto reswitch;
+  800eab:	e9 76 ff ff ff       	jmp    800e26 <vprintfmt+0x58>
+            altflag = 1;
+  800eb0:	c7 45 dc 01 00 00 00 	movl   $0x1,-0x24(%ebp)
+            goto reswitch;
+  800eb7:	e9 6e ff ff ff       	jmp    800e2a <vprintfmt+0x5c>
+            goto process_precision;
+  800ebc:	90                   	nop
+            if (width < 0)
+  800ebd:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  800ec1:	0f 89 62 ff ff ff    	jns    800e29 <vprintfmt+0x5b>
+                width = precision, precision = -1;
+  800ec7:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800eca:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  800ecd:	c7 45 e4 ff ff ff ff 	movl   $0xffffffff,-0x1c(%ebp)
+            goto reswitch;
+  800ed4:	e9 50 ff ff ff       	jmp    800e29 <vprintfmt+0x5b>
+
+        // long flag (doubled for long long)
+        case 'l':
+            lflag ++;
+  800ed9:	83 45 e0 01          	addl   $0x1,-0x20(%ebp)
+            goto reswitch;
+  800edd:	e9 48 ff ff ff       	jmp    800e2a <vprintfmt+0x5c>
+
+        // character
+        case 'c':
+            putch(va_arg(ap, int), putdat, fd);
+  800ee2:	8b 45 18             	mov    0x18(%ebp),%eax
+  800ee5:	8d 50 04             	lea    0x4(%eax),%edx
+  800ee8:	89 55 18             	mov    %edx,0x18(%ebp)
+  800eeb:	8b 00                	mov    (%eax),%eax
+  800eed:	83 ec 04             	sub    $0x4,%esp
+  800ef0:	ff 75 0c             	push   0xc(%ebp)
+  800ef3:	ff 75 10             	push   0x10(%ebp)
+  800ef6:	50                   	push   %eax
+  800ef7:	8b 45 08             	mov    0x8(%ebp),%eax
+  800efa:	ff d0                	call   *%eax
+  800efc:	83 c4 10             	add    $0x10,%esp
+            break;
+  800eff:	e9 99 02 00 00       	jmp    80119d <vprintfmt+0x3cf>
+
+        // error message
+        case 'e':
+            err = va_arg(ap, int);
+  800f04:	8b 45 18             	mov    0x18(%ebp),%eax
+  800f07:	8d 50 04             	lea    0x4(%eax),%edx
+  800f0a:	89 55 18             	mov    %edx,0x18(%ebp)
+  800f0d:	8b 18                	mov    (%eax),%ebx
+            if (err < 0) {
+  800f0f:	85 db                	test   %ebx,%ebx
+  800f11:	79 02                	jns    800f15 <vprintfmt+0x147>
+                err = -err;
+  800f13:	f7 db                	neg    %ebx
+            }
+            if (err > MAXERROR || (p = error_string[err]) == NULL) {
+  800f15:	83 fb 19             	cmp    $0x19,%ebx
+  800f18:	7f 0b                	jg     800f25 <vprintfmt+0x157>
+  800f1a:	8b 34 9d 20 1b 80 00 	mov    0x801b20(,%ebx,4),%esi
+  800f21:	85 f6                	test   %esi,%esi
+  800f23:	75 1f                	jne    800f44 <vprintfmt+0x176>
+                printfmt(putch, fd, putdat, "error %d", err);
+  800f25:	83 ec 0c             	sub    $0xc,%esp
+  800f28:	53                   	push   %ebx
+  800f29:	68 99 1b 80 00       	push   $0x801b99
+  800f2e:	ff 75 10             	push   0x10(%ebp)
+  800f31:	ff 75 0c             	push   0xc(%ebp)
+  800f34:	ff 75 08             	push   0x8(%ebp)
+  800f37:	e8 68 fe ff ff       	call   800da4 <printfmt>
+  800f3c:	83 c4 20             	add    $0x20,%esp
+            }
+            else {
+                printfmt(putch, fd, putdat, "%s", p);
+            }
+            break;
+  800f3f:	e9 59 02 00 00       	jmp    80119d <vprintfmt+0x3cf>
+                printfmt(putch, fd, putdat, "%s", p);
+  800f44:	83 ec 0c             	sub    $0xc,%esp
+  800f47:	56                   	push   %esi
+  800f48:	68 a2 1b 80 00       	push   $0x801ba2
+  800f4d:	ff 75 10             	push   0x10(%ebp)
+  800f50:	ff 75 0c             	push   0xc(%ebp)
+  800f53:	ff 75 08             	push   0x8(%ebp)
+  800f56:	e8 49 fe ff ff       	call   800da4 <printfmt>
+  800f5b:	83 c4 20             	add    $0x20,%esp
+            break;
+  800f5e:	e9 3a 02 00 00       	jmp    80119d <vprintfmt+0x3cf>
+
+        // string
+        case 's':
+            if ((p = va_arg(ap, char *)) == NULL) {
+  800f63:	8b 45 18             	mov    0x18(%ebp),%eax
+  800f66:	8d 50 04             	lea    0x4(%eax),%edx
+  800f69:	89 55 18             	mov    %edx,0x18(%ebp)
+  800f6c:	8b 30                	mov    (%eax),%esi
+  800f6e:	85 f6                	test   %esi,%esi
+  800f70:	75 05                	jne    800f77 <vprintfmt+0x1a9>
+                p = "(null)";
+  800f72:	be a5 1b 80 00       	mov    $0x801ba5,%esi
+            }
+            if (width > 0 && padc != '-') {
+  800f77:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  800f7b:	7e 7d                	jle    800ffa <vprintfmt+0x22c>
+  800f7d:	80 7d db 2d          	cmpb   $0x2d,-0x25(%ebp)
+  800f81:	74 77                	je     800ffa <vprintfmt+0x22c>
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  800f83:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+  800f86:	83 ec 08             	sub    $0x8,%esp
+  800f89:	50                   	push   %eax
+  800f8a:	56                   	push   %esi
+  800f8b:	e8 d6 03 00 00       	call   801366 <strnlen>
+  800f90:	83 c4 10             	add    $0x10,%esp
+  800f93:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  800f96:	29 c2                	sub    %eax,%edx
+  800f98:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  800f9b:	eb 1a                	jmp    800fb7 <vprintfmt+0x1e9>
+                    putch(padc, putdat, fd);
+  800f9d:	0f be 45 db          	movsbl -0x25(%ebp),%eax
+  800fa1:	83 ec 04             	sub    $0x4,%esp
+  800fa4:	ff 75 0c             	push   0xc(%ebp)
+  800fa7:	ff 75 10             	push   0x10(%ebp)
+  800faa:	50                   	push   %eax
+  800fab:	8b 45 08             	mov    0x8(%ebp),%eax
+  800fae:	ff d0                	call   *%eax
+  800fb0:	83 c4 10             	add    $0x10,%esp
+                for (width -= strnlen(p, precision); width > 0; width --) {
+  800fb3:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  800fb7:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  800fbb:	7f e0                	jg     800f9d <vprintfmt+0x1cf>
+                }
+            }
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  800fbd:	eb 3b                	jmp    800ffa <vprintfmt+0x22c>
+                if (altflag && (ch < ' ' || ch > '~')) {
+  800fbf:	83 7d dc 00          	cmpl   $0x0,-0x24(%ebp)
+  800fc3:	74 1f                	je     800fe4 <vprintfmt+0x216>
+  800fc5:	83 fb 1f             	cmp    $0x1f,%ebx
+  800fc8:	7e 05                	jle    800fcf <vprintfmt+0x201>
+  800fca:	83 fb 7e             	cmp    $0x7e,%ebx
+  800fcd:	7e 15                	jle    800fe4 <vprintfmt+0x216>
+                    putch('?', putdat, fd);
+  800fcf:	83 ec 04             	sub    $0x4,%esp
+  800fd2:	ff 75 0c             	push   0xc(%ebp)
+  800fd5:	ff 75 10             	push   0x10(%ebp)
+  800fd8:	6a 3f                	push   $0x3f
+  800fda:	8b 45 08             	mov    0x8(%ebp),%eax
+  800fdd:	ff d0                	call   *%eax
+  800fdf:	83 c4 10             	add    $0x10,%esp
+  800fe2:	eb 12                	jmp    800ff6 <vprintfmt+0x228>
+                }
+                else {
+                    putch(ch, putdat, fd);
+  800fe4:	83 ec 04             	sub    $0x4,%esp
+  800fe7:	ff 75 0c             	push   0xc(%ebp)
+  800fea:	ff 75 10             	push   0x10(%ebp)
+  800fed:	53                   	push   %ebx
+  800fee:	8b 45 08             	mov    0x8(%ebp),%eax
+  800ff1:	ff d0                	call   *%eax
+  800ff3:	83 c4 10             	add    $0x10,%esp
+            for (; (ch = *p ++) != '\0' && (precision < 0 || -- precision >= 0); width --) {
+  800ff6:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  800ffa:	89 f0                	mov    %esi,%eax
+  800ffc:	8d 70 01             	lea    0x1(%eax),%esi
+  800fff:	0f b6 00             	movzbl (%eax),%eax
+  801002:	0f be d8             	movsbl %al,%ebx
+  801005:	85 db                	test   %ebx,%ebx
+  801007:	74 29                	je     801032 <vprintfmt+0x264>
+  801009:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  80100d:	78 b0                	js     800fbf <vprintfmt+0x1f1>
+  80100f:	83 6d e4 01          	subl   $0x1,-0x1c(%ebp)
+  801013:	83 7d e4 00          	cmpl   $0x0,-0x1c(%ebp)
+  801017:	79 a6                	jns    800fbf <vprintfmt+0x1f1>
+                }
+            }
+            for (; width > 0; width --) {
+  801019:	eb 17                	jmp    801032 <vprintfmt+0x264>
+                putch(' ', putdat, fd);
+  80101b:	83 ec 04             	sub    $0x4,%esp
+  80101e:	ff 75 0c             	push   0xc(%ebp)
+  801021:	ff 75 10             	push   0x10(%ebp)
+  801024:	6a 20                	push   $0x20
+  801026:	8b 45 08             	mov    0x8(%ebp),%eax
+  801029:	ff d0                	call   *%eax
+  80102b:	83 c4 10             	add    $0x10,%esp
+            for (; width > 0; width --) {
+  80102e:	83 6d e8 01          	subl   $0x1,-0x18(%ebp)
+  801032:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  801036:	7f e3                	jg     80101b <vprintfmt+0x24d>
+            }
+            break;
+  801038:	e9 60 01 00 00       	jmp    80119d <vprintfmt+0x3cf>
+
+        // (signed) decimal
+        case 'd':
+            num = getint(&ap, lflag);
+  80103d:	83 ec 08             	sub    $0x8,%esp
+  801040:	ff 75 e0             	push   -0x20(%ebp)
+  801043:	8d 45 18             	lea    0x18(%ebp),%eax
+  801046:	50                   	push   %eax
+  801047:	e8 11 fd ff ff       	call   800d5d <getint>
+  80104c:	83 c4 10             	add    $0x10,%esp
+  80104f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801052:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            if ((long long)num < 0) {
+  801055:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801058:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80105b:	85 d2                	test   %edx,%edx
+  80105d:	79 26                	jns    801085 <vprintfmt+0x2b7>
+                putch('-', putdat, fd);
+  80105f:	83 ec 04             	sub    $0x4,%esp
+  801062:	ff 75 0c             	push   0xc(%ebp)
+  801065:	ff 75 10             	push   0x10(%ebp)
+  801068:	6a 2d                	push   $0x2d
+  80106a:	8b 45 08             	mov    0x8(%ebp),%eax
+  80106d:	ff d0                	call   *%eax
+  80106f:	83 c4 10             	add    $0x10,%esp
+                num = -(long long)num;
+  801072:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801075:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  801078:	f7 d8                	neg    %eax
+  80107a:	83 d2 00             	adc    $0x0,%edx
+  80107d:	f7 da                	neg    %edx
+  80107f:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801082:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            }
+            base = 10;
+  801085:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  80108c:	e9 a8 00 00 00       	jmp    801139 <vprintfmt+0x36b>
+
+        // unsigned decimal
+        case 'u':
+            num = getuint(&ap, lflag);
+  801091:	83 ec 08             	sub    $0x8,%esp
+  801094:	ff 75 e0             	push   -0x20(%ebp)
+  801097:	8d 45 18             	lea    0x18(%ebp),%eax
+  80109a:	50                   	push   %eax
+  80109b:	e8 6e fc ff ff       	call   800d0e <getuint>
+  8010a0:	83 c4 10             	add    $0x10,%esp
+  8010a3:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8010a6:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 10;
+  8010a9:	c7 45 ec 0a 00 00 00 	movl   $0xa,-0x14(%ebp)
+            goto number;
+  8010b0:	e9 84 00 00 00       	jmp    801139 <vprintfmt+0x36b>
+
+        // (unsigned) octal
+        case 'o':
+            num = getuint(&ap, lflag);
+  8010b5:	83 ec 08             	sub    $0x8,%esp
+  8010b8:	ff 75 e0             	push   -0x20(%ebp)
+  8010bb:	8d 45 18             	lea    0x18(%ebp),%eax
+  8010be:	50                   	push   %eax
+  8010bf:	e8 4a fc ff ff       	call   800d0e <getuint>
+  8010c4:	83 c4 10             	add    $0x10,%esp
+  8010c7:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8010ca:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 8;
+  8010cd:	c7 45 ec 08 00 00 00 	movl   $0x8,-0x14(%ebp)
+            goto number;
+  8010d4:	eb 63                	jmp    801139 <vprintfmt+0x36b>
+
+        // pointer
+        case 'p':
+            putch('0', putdat, fd);
+  8010d6:	83 ec 04             	sub    $0x4,%esp
+  8010d9:	ff 75 0c             	push   0xc(%ebp)
+  8010dc:	ff 75 10             	push   0x10(%ebp)
+  8010df:	6a 30                	push   $0x30
+  8010e1:	8b 45 08             	mov    0x8(%ebp),%eax
+  8010e4:	ff d0                	call   *%eax
+  8010e6:	83 c4 10             	add    $0x10,%esp
+            putch('x', putdat, fd);
+  8010e9:	83 ec 04             	sub    $0x4,%esp
+  8010ec:	ff 75 0c             	push   0xc(%ebp)
+  8010ef:	ff 75 10             	push   0x10(%ebp)
+  8010f2:	6a 78                	push   $0x78
+  8010f4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8010f7:	ff d0                	call   *%eax
+  8010f9:	83 c4 10             	add    $0x10,%esp
+            num = (unsigned long long)(uintptr_t)va_arg(ap, void *);
+  8010fc:	8b 45 18             	mov    0x18(%ebp),%eax
+  8010ff:	8d 50 04             	lea    0x4(%eax),%edx
+  801102:	89 55 18             	mov    %edx,0x18(%ebp)
+  801105:	8b 00                	mov    (%eax),%eax
+  801107:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80110a:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+            base = 16;
+  801111:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+            goto number;
+  801118:	eb 1f                	jmp    801139 <vprintfmt+0x36b>
+
+        // (unsigned) hexadecimal
+        case 'x':
+            num = getuint(&ap, lflag);
+  80111a:	83 ec 08             	sub    $0x8,%esp
+  80111d:	ff 75 e0             	push   -0x20(%ebp)
+  801120:	8d 45 18             	lea    0x18(%ebp),%eax
+  801123:	50                   	push   %eax
+  801124:	e8 e5 fb ff ff       	call   800d0e <getuint>
+  801129:	83 c4 10             	add    $0x10,%esp
+  80112c:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  80112f:	89 55 f4             	mov    %edx,-0xc(%ebp)
+            base = 16;
+  801132:	c7 45 ec 10 00 00 00 	movl   $0x10,-0x14(%ebp)
+        number:
+            printnum(putch, fd, putdat, num, base, width, padc);
+  801139:	0f be 55 db          	movsbl -0x25(%ebp),%edx
+  80113d:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801140:	52                   	push   %edx
+  801141:	ff 75 e8             	push   -0x18(%ebp)
+  801144:	50                   	push   %eax
+  801145:	ff 75 f4             	push   -0xc(%ebp)
+  801148:	ff 75 f0             	push   -0x10(%ebp)
+  80114b:	ff 75 10             	push   0x10(%ebp)
+  80114e:	ff 75 0c             	push   0xc(%ebp)
+  801151:	ff 75 08             	push   0x8(%ebp)
+  801154:	e8 c3 fa ff ff       	call   800c1c <printnum>
+  801159:	83 c4 20             	add    $0x20,%esp
+            break;
+  80115c:	eb 3f                	jmp    80119d <vprintfmt+0x3cf>
+
+        // escaped '%' character
+        case '%':
+            putch(ch, putdat, fd);
+  80115e:	83 ec 04             	sub    $0x4,%esp
+  801161:	ff 75 0c             	push   0xc(%ebp)
+  801164:	ff 75 10             	push   0x10(%ebp)
+  801167:	53                   	push   %ebx
+  801168:	8b 45 08             	mov    0x8(%ebp),%eax
+  80116b:	ff d0                	call   *%eax
+  80116d:	83 c4 10             	add    $0x10,%esp
+            break;
+  801170:	eb 2b                	jmp    80119d <vprintfmt+0x3cf>
+
+        // unrecognized escape sequence - just print it literally
+        default:
+            putch('%', putdat, fd);
+  801172:	83 ec 04             	sub    $0x4,%esp
+  801175:	ff 75 0c             	push   0xc(%ebp)
+  801178:	ff 75 10             	push   0x10(%ebp)
+  80117b:	6a 25                	push   $0x25
+  80117d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801180:	ff d0                	call   *%eax
+  801182:	83 c4 10             	add    $0x10,%esp
+            for (fmt --; fmt[-1] != '%'; fmt --)
+  801185:	83 6d 14 01          	subl   $0x1,0x14(%ebp)
+  801189:	eb 04                	jmp    80118f <vprintfmt+0x3c1>
+  80118b:	83 6d 14 01          	subl   $0x1,0x14(%ebp)
+  80118f:	8b 45 14             	mov    0x14(%ebp),%eax
+  801192:	83 e8 01             	sub    $0x1,%eax
+  801195:	0f b6 00             	movzbl (%eax),%eax
+  801198:	3c 25                	cmp    $0x25,%al
+  80119a:	75 ef                	jne    80118b <vprintfmt+0x3bd>
+                /* do nothing */;
+            break;
+  80119c:	90                   	nop
+    while (1) {
+  80119d:	e9 34 fc ff ff       	jmp    800dd6 <vprintfmt+0x8>
+                return;
+  8011a2:	90                   	nop
+        }
+    }
+}
+  8011a3:	8d 65 f8             	lea    -0x8(%ebp),%esp
+  8011a6:	5b                   	pop    %ebx
+  8011a7:	5e                   	pop    %esi
+  8011a8:	5d                   	pop    %ebp
+  8011a9:	c3                   	ret
+
+008011aa <sprintputch>:
+ * sprintputch - 'print' a single character in a buffer
+ * @ch:         the character will be printed
+ * @b:          the buffer to place the character @ch
+ * */
+static void
+sprintputch(int ch, struct sprintbuf *b) {
+  8011aa:	55                   	push   %ebp
+  8011ab:	89 e5                	mov    %esp,%ebp
+    b->cnt ++;
+  8011ad:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8011b0:	8b 40 08             	mov    0x8(%eax),%eax
+  8011b3:	8d 50 01             	lea    0x1(%eax),%edx
+  8011b6:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8011b9:	89 50 08             	mov    %edx,0x8(%eax)
+    if (b->buf < b->ebuf) {
+  8011bc:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8011bf:	8b 10                	mov    (%eax),%edx
+  8011c1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8011c4:	8b 40 04             	mov    0x4(%eax),%eax
+  8011c7:	39 c2                	cmp    %eax,%edx
+  8011c9:	73 12                	jae    8011dd <sprintputch+0x33>
+        *b->buf ++ = ch;
+  8011cb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8011ce:	8b 00                	mov    (%eax),%eax
+  8011d0:	8d 48 01             	lea    0x1(%eax),%ecx
+  8011d3:	8b 55 0c             	mov    0xc(%ebp),%edx
+  8011d6:	89 0a                	mov    %ecx,(%edx)
+  8011d8:	8b 55 08             	mov    0x8(%ebp),%edx
+  8011db:	88 10                	mov    %dl,(%eax)
+    }
+}
+  8011dd:	90                   	nop
+  8011de:	5d                   	pop    %ebp
+  8011df:	c3                   	ret
+
+008011e0 <snprintf>:
+ * @str:        the buffer to place the result into
+ * @size:       the size of buffer, including the trailing null space
+ * @fmt:        the format string to use
+ * */
+int
+snprintf(char *str, size_t size, const char *fmt, ...) {
+  8011e0:	55                   	push   %ebp
+  8011e1:	89 e5                	mov    %esp,%ebp
+  8011e3:	83 ec 18             	sub    $0x18,%esp
+    va_list ap;
+    int cnt;
+    va_start(ap, fmt);
+  8011e6:	8d 45 14             	lea    0x14(%ebp),%eax
+  8011e9:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    cnt = vsnprintf(str, size, fmt, ap);
+  8011ec:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8011ef:	50                   	push   %eax
+  8011f0:	ff 75 10             	push   0x10(%ebp)
+  8011f3:	ff 75 0c             	push   0xc(%ebp)
+  8011f6:	ff 75 08             	push   0x8(%ebp)
+  8011f9:	e8 0b 00 00 00       	call   801209 <vsnprintf>
+  8011fe:	83 c4 10             	add    $0x10,%esp
+  801201:	89 45 f4             	mov    %eax,-0xc(%ebp)
+    va_end(ap);
+    return cnt;
+  801204:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801207:	c9                   	leave
+  801208:	c3                   	ret
+
+00801209 <vsnprintf>:
+ *
+ * Call this function if you are already dealing with a va_list.
+ * Or you probably want snprintf() instead.
+ * */
+int
+vsnprintf(char *str, size_t size, const char *fmt, va_list ap) {
+  801209:	55                   	push   %ebp
+  80120a:	89 e5                	mov    %esp,%ebp
+  80120c:	83 ec 18             	sub    $0x18,%esp
+    struct sprintbuf b = {str, str + size - 1, 0};
+  80120f:	8b 45 08             	mov    0x8(%ebp),%eax
+  801212:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  801215:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801218:	8d 50 ff             	lea    -0x1(%eax),%edx
+  80121b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80121e:	01 d0                	add    %edx,%eax
+  801220:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801223:	c7 45 f4 00 00 00 00 	movl   $0x0,-0xc(%ebp)
+    if (str == NULL || b.buf > b.ebuf) {
+  80122a:	83 7d 08 00          	cmpl   $0x0,0x8(%ebp)
+  80122e:	74 0a                	je     80123a <vsnprintf+0x31>
+  801230:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801233:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  801236:	39 c2                	cmp    %eax,%edx
+  801238:	73 07                	jae    801241 <vsnprintf+0x38>
+        return -E_INVAL;
+  80123a:	b8 fd ff ff ff       	mov    $0xfffffffd,%eax
+  80123f:	eb 28                	jmp    801269 <vsnprintf+0x60>
+    }
+    // print the string to the buffer
+    vprintfmt((void*)sprintputch, NO_FD, &b, fmt, ap);
+  801241:	83 ec 0c             	sub    $0xc,%esp
+  801244:	ff 75 14             	push   0x14(%ebp)
+  801247:	ff 75 10             	push   0x10(%ebp)
+  80124a:	8d 45 ec             	lea    -0x14(%ebp),%eax
+  80124d:	50                   	push   %eax
+  80124e:	68 d9 6a ff ff       	push   $0xffff6ad9
+  801253:	68 aa 11 80 00       	push   $0x8011aa
+  801258:	e8 71 fb ff ff       	call   800dce <vprintfmt>
+  80125d:	83 c4 20             	add    $0x20,%esp
+    // null terminate the buffer
+    *b.buf = '\0';
+  801260:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801263:	c6 00 00             	movb   $0x0,(%eax)
+    return b.cnt;
+  801266:	8b 45 f4             	mov    -0xc(%ebp),%eax
+}
+  801269:	c9                   	leave
+  80126a:	c3                   	ret
+
+0080126b <rand>:
+ * rand - returns a pseudo-random integer
+ *
+ * The rand() function return a value in the range [0, RAND_MAX].
+ * */
+int
+rand(void) {
+  80126b:	55                   	push   %ebp
+  80126c:	89 e5                	mov    %esp,%ebp
+  80126e:	57                   	push   %edi
+  80126f:	56                   	push   %esi
+  801270:	53                   	push   %ebx
+  801271:	83 ec 24             	sub    $0x24,%esp
+    next = (next * 0x5DEECE66DLL + 0xBLL) & ((1LL << 48) - 1);
+  801274:	a1 08 20 80 00       	mov    0x802008,%eax
+  801279:	8b 15 0c 20 80 00    	mov    0x80200c,%edx
+  80127f:	69 fa 6d e6 ec de    	imul   $0xdeece66d,%edx,%edi
+  801285:	6b f0 05             	imul   $0x5,%eax,%esi
+  801288:	01 fe                	add    %edi,%esi
+  80128a:	bf 6d e6 ec de       	mov    $0xdeece66d,%edi
+  80128f:	f7 e7                	mul    %edi
+  801291:	01 d6                	add    %edx,%esi
+  801293:	89 f2                	mov    %esi,%edx
+  801295:	83 c0 0b             	add    $0xb,%eax
+  801298:	83 d2 00             	adc    $0x0,%edx
+  80129b:	89 c1                	mov    %eax,%ecx
+  80129d:	0f b7 da             	movzwl %dx,%ebx
+  8012a0:	89 0d 08 20 80 00    	mov    %ecx,0x802008
+  8012a6:	89 1d 0c 20 80 00    	mov    %ebx,0x80200c
+    unsigned long long result = (next >> 12);
+  8012ac:	a1 08 20 80 00       	mov    0x802008,%eax
+  8012b1:	8b 15 0c 20 80 00    	mov    0x80200c,%edx
+  8012b7:	0f ac d0 0c          	shrd   $0xc,%edx,%eax
+  8012bb:	c1 ea 0c             	shr    $0xc,%edx
+  8012be:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  8012c1:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return (int)do_div(result, RAND_MAX + 1);
+  8012c4:	c7 45 dc 00 00 00 80 	movl   $0x80000000,-0x24(%ebp)
+  8012cb:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  8012ce:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  8012d1:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  8012d4:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  8012d7:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8012da:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8012dd:	83 7d e8 00          	cmpl   $0x0,-0x18(%ebp)
+  8012e1:	74 1c                	je     8012ff <rand+0x94>
+  8012e3:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8012e6:	ba 00 00 00 00       	mov    $0x0,%edx
+  8012eb:	f7 75 dc             	divl   -0x24(%ebp)
+  8012ee:	89 55 ec             	mov    %edx,-0x14(%ebp)
+  8012f1:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  8012f4:	ba 00 00 00 00       	mov    $0x0,%edx
+  8012f9:	f7 75 dc             	divl   -0x24(%ebp)
+  8012fc:	89 45 e8             	mov    %eax,-0x18(%ebp)
+  8012ff:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801302:	8b 55 ec             	mov    -0x14(%ebp),%edx
+  801305:	f7 75 dc             	divl   -0x24(%ebp)
+  801308:	89 45 d8             	mov    %eax,-0x28(%ebp)
+  80130b:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  80130e:	8b 45 d8             	mov    -0x28(%ebp),%eax
+  801311:	8b 55 e8             	mov    -0x18(%ebp),%edx
+  801314:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801317:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  80131a:	8b 45 d4             	mov    -0x2c(%ebp),%eax
+}
+  80131d:	83 c4 24             	add    $0x24,%esp
+  801320:	5b                   	pop    %ebx
+  801321:	5e                   	pop    %esi
+  801322:	5f                   	pop    %edi
+  801323:	5d                   	pop    %ebp
+  801324:	c3                   	ret
+
+00801325 <srand>:
+/* *
+ * srand - seed the random number generator with the given number
+ * @seed:   the required seed number
+ * */
+void
+srand(unsigned int seed) {
+  801325:	55                   	push   %ebp
+  801326:	89 e5                	mov    %esp,%ebp
+    next = seed;
+  801328:	8b 45 08             	mov    0x8(%ebp),%eax
+  80132b:	ba 00 00 00 00       	mov    $0x0,%edx
+  801330:	a3 08 20 80 00       	mov    %eax,0x802008
+  801335:	89 15 0c 20 80 00    	mov    %edx,0x80200c
+}
+  80133b:	90                   	nop
+  80133c:	5d                   	pop    %ebp
+  80133d:	c3                   	ret
+
+0080133e <strlen>:
+ * @s:      the input string
+ *
+ * The strlen() function returns the length of string @s.
+ * */
+size_t
+strlen(const char *s) {
+  80133e:	55                   	push   %ebp
+  80133f:	89 e5                	mov    %esp,%ebp
+  801341:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  801344:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  80134b:	eb 04                	jmp    801351 <strlen+0x13>
+        cnt ++;
+  80134d:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (*s ++ != '\0') {
+  801351:	8b 45 08             	mov    0x8(%ebp),%eax
+  801354:	8d 50 01             	lea    0x1(%eax),%edx
+  801357:	89 55 08             	mov    %edx,0x8(%ebp)
+  80135a:	0f b6 00             	movzbl (%eax),%eax
+  80135d:	84 c0                	test   %al,%al
+  80135f:	75 ec                	jne    80134d <strlen+0xf>
+    }
+    return cnt;
+  801361:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  801364:	c9                   	leave
+  801365:	c3                   	ret
+
+00801366 <strnlen>:
+ * The return value is strlen(s), if that is less than @len, or
+ * @len if there is no '\0' character among the first @len characters
+ * pointed by @s.
+ * */
+size_t
+strnlen(const char *s, size_t len) {
+  801366:	55                   	push   %ebp
+  801367:	89 e5                	mov    %esp,%ebp
+  801369:	83 ec 10             	sub    $0x10,%esp
+    size_t cnt = 0;
+  80136c:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  801373:	eb 04                	jmp    801379 <strnlen+0x13>
+        cnt ++;
+  801375:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+    while (cnt < len && *s ++ != '\0') {
+  801379:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  80137c:	3b 45 0c             	cmp    0xc(%ebp),%eax
+  80137f:	73 10                	jae    801391 <strnlen+0x2b>
+  801381:	8b 45 08             	mov    0x8(%ebp),%eax
+  801384:	8d 50 01             	lea    0x1(%eax),%edx
+  801387:	89 55 08             	mov    %edx,0x8(%ebp)
+  80138a:	0f b6 00             	movzbl (%eax),%eax
+  80138d:	84 c0                	test   %al,%al
+  80138f:	75 e4                	jne    801375 <strnlen+0xf>
+    }
+    return cnt;
+  801391:	8b 45 fc             	mov    -0x4(%ebp),%eax
+}
+  801394:	c9                   	leave
+  801395:	c3                   	ret
+
+00801396 <strcat>:
+ * @dst:    pointer to the @dst array, which should be large enough to contain the concatenated
+ *          resulting string.
+ * @src:    string to be appended, this should not overlap @dst
+ * */
+char *
+strcat(char *dst, const char *src) {
+  801396:	55                   	push   %ebp
+  801397:	89 e5                	mov    %esp,%ebp
+  801399:	83 ec 08             	sub    $0x8,%esp
+    return strcpy(dst + strlen(dst), src);
+  80139c:	ff 75 08             	push   0x8(%ebp)
+  80139f:	e8 9a ff ff ff       	call   80133e <strlen>
+  8013a4:	83 c4 04             	add    $0x4,%esp
+  8013a7:	8b 55 08             	mov    0x8(%ebp),%edx
+  8013aa:	01 d0                	add    %edx,%eax
+  8013ac:	83 ec 08             	sub    $0x8,%esp
+  8013af:	ff 75 0c             	push   0xc(%ebp)
+  8013b2:	50                   	push   %eax
+  8013b3:	e8 05 00 00 00       	call   8013bd <strcpy>
+  8013b8:	83 c4 10             	add    $0x10,%esp
+}
+  8013bb:	c9                   	leave
+  8013bc:	c3                   	ret
+
+008013bd <strcpy>:
+ * To avoid overflows, the size of array pointed by @dst should be long enough to
+ * contain the same string as @src (including the terminating null character), and
+ * should not overlap in memory with @src.
+ * */
+char *
+strcpy(char *dst, const char *src) {
+  8013bd:	55                   	push   %ebp
+  8013be:	89 e5                	mov    %esp,%ebp
+  8013c0:	57                   	push   %edi
+  8013c1:	56                   	push   %esi
+  8013c2:	83 ec 20             	sub    $0x20,%esp
+  8013c5:	8b 45 08             	mov    0x8(%ebp),%eax
+  8013c8:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  8013cb:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8013ce:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_STRCPY
+#define __HAVE_ARCH_STRCPY
+static inline char *
+__strcpy(char *dst, const char *src) {
+    int d0, d1, d2;
+    asm volatile (
+  8013d1:	8b 55 f0             	mov    -0x10(%ebp),%edx
+  8013d4:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  8013d7:	89 d1                	mov    %edx,%ecx
+  8013d9:	89 c2                	mov    %eax,%edx
+  8013db:	89 ce                	mov    %ecx,%esi
+  8013dd:	89 d7                	mov    %edx,%edi
+  8013df:	ac                   	lods   %ds:(%esi),%al
+  8013e0:	aa                   	stos   %al,%es:(%edi)
+  8013e1:	84 c0                	test   %al,%al
+  8013e3:	75 fa                	jne    8013df <strcpy+0x22>
+  8013e5:	89 fa                	mov    %edi,%edx
+  8013e7:	89 f1                	mov    %esi,%ecx
+  8013e9:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  8013ec:	89 55 e8             	mov    %edx,-0x18(%ebp)
+  8013ef:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+        "stosb;"
+        "testb %%al, %%al;"
+        "jne 1b;"
+        : "=&S" (d0), "=&D" (d1), "=&a" (d2)
+        : "0" (src), "1" (dst) : "memory");
+    return dst;
+  8013f2:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    char *p = dst;
+    while ((*p ++ = *src ++) != '\0')
+        /* nothing */;
+    return dst;
+#endif /* __HAVE_ARCH_STRCPY */
+}
+  8013f5:	83 c4 20             	add    $0x20,%esp
+  8013f8:	5e                   	pop    %esi
+  8013f9:	5f                   	pop    %edi
+  8013fa:	5d                   	pop    %ebp
+  8013fb:	c3                   	ret
+
+008013fc <strncpy>:
+ * @len:    maximum number of characters to be copied from @src
+ *
+ * The return value is @dst
+ * */
+char *
+strncpy(char *dst, const char *src, size_t len) {
+  8013fc:	55                   	push   %ebp
+  8013fd:	89 e5                	mov    %esp,%ebp
+  8013ff:	83 ec 10             	sub    $0x10,%esp
+    char *p = dst;
+  801402:	8b 45 08             	mov    0x8(%ebp),%eax
+  801405:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    while (len > 0) {
+  801408:	eb 21                	jmp    80142b <strncpy+0x2f>
+        if ((*p = *src) != '\0') {
+  80140a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80140d:	0f b6 10             	movzbl (%eax),%edx
+  801410:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801413:	88 10                	mov    %dl,(%eax)
+  801415:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  801418:	0f b6 00             	movzbl (%eax),%eax
+  80141b:	84 c0                	test   %al,%al
+  80141d:	74 04                	je     801423 <strncpy+0x27>
+            src ++;
+  80141f:	83 45 0c 01          	addl   $0x1,0xc(%ebp)
+        }
+        p ++, len --;
+  801423:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  801427:	83 6d 10 01          	subl   $0x1,0x10(%ebp)
+    while (len > 0) {
+  80142b:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  80142f:	75 d9                	jne    80140a <strncpy+0xe>
+    }
+    return dst;
+  801431:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  801434:	c9                   	leave
+  801435:	c3                   	ret
+
+00801436 <strcmp>:
+ * - A value greater than zero indicates that the first character that does
+ *   not match has a greater value in @s1 than in @s2;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+strcmp(const char *s1, const char *s2) {
+  801436:	55                   	push   %ebp
+  801437:	89 e5                	mov    %esp,%ebp
+  801439:	57                   	push   %edi
+  80143a:	56                   	push   %esi
+  80143b:	83 ec 20             	sub    $0x20,%esp
+  80143e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801441:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801444:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801447:	89 45 f0             	mov    %eax,-0x10(%ebp)
+    asm volatile (
+  80144a:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80144d:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  801450:	89 d1                	mov    %edx,%ecx
+  801452:	89 c2                	mov    %eax,%edx
+  801454:	89 ce                	mov    %ecx,%esi
+  801456:	89 d7                	mov    %edx,%edi
+  801458:	ac                   	lods   %ds:(%esi),%al
+  801459:	ae                   	scas   %es:(%edi),%al
+  80145a:	75 08                	jne    801464 <strcmp+0x2e>
+  80145c:	84 c0                	test   %al,%al
+  80145e:	75 f8                	jne    801458 <strcmp+0x22>
+  801460:	31 c0                	xor    %eax,%eax
+  801462:	eb 04                	jmp    801468 <strcmp+0x32>
+  801464:	19 c0                	sbb    %eax,%eax
+  801466:	0c 01                	or     $0x1,%al
+  801468:	89 fa                	mov    %edi,%edx
+  80146a:	89 f1                	mov    %esi,%ecx
+  80146c:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  80146f:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  801472:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+    return ret;
+  801475:	8b 45 ec             	mov    -0x14(%ebp),%eax
+    while (*s1 != '\0' && *s1 == *s2) {
+        s1 ++, s2 ++;
+    }
+    return (int)((unsigned char)*s1 - (unsigned char)*s2);
+#endif /* __HAVE_ARCH_STRCMP */
+}
+  801478:	83 c4 20             	add    $0x20,%esp
+  80147b:	5e                   	pop    %esi
+  80147c:	5f                   	pop    %edi
+  80147d:	5d                   	pop    %ebp
+  80147e:	c3                   	ret
+
+0080147f <strncmp>:
+ * they are equal to each other, it continues with the following pairs until
+ * the characters differ, until a terminating null-character is reached, or
+ * until @n characters match in both strings, whichever happens first.
+ * */
+int
+strncmp(const char *s1, const char *s2, size_t n) {
+  80147f:	55                   	push   %ebp
+  801480:	89 e5                	mov    %esp,%ebp
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  801482:	eb 0c                	jmp    801490 <strncmp+0x11>
+        n --, s1 ++, s2 ++;
+  801484:	83 6d 10 01          	subl   $0x1,0x10(%ebp)
+  801488:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  80148c:	83 45 0c 01          	addl   $0x1,0xc(%ebp)
+    while (n > 0 && *s1 != '\0' && *s1 == *s2) {
+  801490:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  801494:	74 1a                	je     8014b0 <strncmp+0x31>
+  801496:	8b 45 08             	mov    0x8(%ebp),%eax
+  801499:	0f b6 00             	movzbl (%eax),%eax
+  80149c:	84 c0                	test   %al,%al
+  80149e:	74 10                	je     8014b0 <strncmp+0x31>
+  8014a0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014a3:	0f b6 10             	movzbl (%eax),%edx
+  8014a6:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014a9:	0f b6 00             	movzbl (%eax),%eax
+  8014ac:	38 c2                	cmp    %al,%dl
+  8014ae:	74 d4                	je     801484 <strncmp+0x5>
+    }
+    return (n == 0) ? 0 : (int)((unsigned char)*s1 - (unsigned char)*s2);
+  8014b0:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  8014b4:	74 16                	je     8014cc <strncmp+0x4d>
+  8014b6:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014b9:	0f b6 00             	movzbl (%eax),%eax
+  8014bc:	0f b6 d0             	movzbl %al,%edx
+  8014bf:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014c2:	0f b6 00             	movzbl (%eax),%eax
+  8014c5:	0f b6 c0             	movzbl %al,%eax
+  8014c8:	29 c2                	sub    %eax,%edx
+  8014ca:	eb 05                	jmp    8014d1 <strncmp+0x52>
+  8014cc:	ba 00 00 00 00       	mov    $0x0,%edx
+  8014d1:	89 d0                	mov    %edx,%eax
+}
+  8014d3:	5d                   	pop    %ebp
+  8014d4:	c3                   	ret
+
+008014d5 <strchr>:
+ *
+ * The strchr() function returns a pointer to the first occurrence of
+ * character in @s. If the value is not found, the function returns 'NULL'.
+ * */
+char *
+strchr(const char *s, char c) {
+  8014d5:	55                   	push   %ebp
+  8014d6:	89 e5                	mov    %esp,%ebp
+  8014d8:	83 ec 04             	sub    $0x4,%esp
+  8014db:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8014de:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  8014e1:	eb 14                	jmp    8014f7 <strchr+0x22>
+        if (*s == c) {
+  8014e3:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014e6:	0f b6 00             	movzbl (%eax),%eax
+  8014e9:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  8014ec:	75 05                	jne    8014f3 <strchr+0x1e>
+            return (char *)s;
+  8014ee:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014f1:	eb 13                	jmp    801506 <strchr+0x31>
+        }
+        s ++;
+  8014f3:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s != '\0') {
+  8014f7:	8b 45 08             	mov    0x8(%ebp),%eax
+  8014fa:	0f b6 00             	movzbl (%eax),%eax
+  8014fd:	84 c0                	test   %al,%al
+  8014ff:	75 e2                	jne    8014e3 <strchr+0xe>
+    }
+    return NULL;
+  801501:	b8 00 00 00 00       	mov    $0x0,%eax
+}
+  801506:	c9                   	leave
+  801507:	c3                   	ret
+
+00801508 <strfind>:
+ * The strfind() function is like strchr() except that if @c is
+ * not found in @s, then it returns a pointer to the null byte at the
+ * end of @s, rather than 'NULL'.
+ * */
+char *
+strfind(const char *s, char c) {
+  801508:	55                   	push   %ebp
+  801509:	89 e5                	mov    %esp,%ebp
+  80150b:	83 ec 04             	sub    $0x4,%esp
+  80150e:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801511:	88 45 fc             	mov    %al,-0x4(%ebp)
+    while (*s != '\0') {
+  801514:	eb 0f                	jmp    801525 <strfind+0x1d>
+        if (*s == c) {
+  801516:	8b 45 08             	mov    0x8(%ebp),%eax
+  801519:	0f b6 00             	movzbl (%eax),%eax
+  80151c:	38 45 fc             	cmp    %al,-0x4(%ebp)
+  80151f:	74 10                	je     801531 <strfind+0x29>
+            break;
+        }
+        s ++;
+  801521:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s != '\0') {
+  801525:	8b 45 08             	mov    0x8(%ebp),%eax
+  801528:	0f b6 00             	movzbl (%eax),%eax
+  80152b:	84 c0                	test   %al,%al
+  80152d:	75 e7                	jne    801516 <strfind+0xe>
+  80152f:	eb 01                	jmp    801532 <strfind+0x2a>
+            break;
+  801531:	90                   	nop
+    }
+    return (char *)s;
+  801532:	8b 45 08             	mov    0x8(%ebp),%eax
+}
+  801535:	c9                   	leave
+  801536:	c3                   	ret
+
+00801537 <strtol>:
+ * an optional "0x" or "0X" prefix.
+ *
+ * The strtol() function returns the converted integral number as a long int value.
+ * */
+long
+strtol(const char *s, char **endptr, int base) {
+  801537:	55                   	push   %ebp
+  801538:	89 e5                	mov    %esp,%ebp
+  80153a:	83 ec 10             	sub    $0x10,%esp
+    int neg = 0;
+  80153d:	c7 45 fc 00 00 00 00 	movl   $0x0,-0x4(%ebp)
+    long val = 0;
+  801544:	c7 45 f8 00 00 00 00 	movl   $0x0,-0x8(%ebp)
+
+    // gobble initial whitespace
+    while (*s == ' ' || *s == '\t') {
+  80154b:	eb 04                	jmp    801551 <strtol+0x1a>
+        s ++;
+  80154d:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+    while (*s == ' ' || *s == '\t') {
+  801551:	8b 45 08             	mov    0x8(%ebp),%eax
+  801554:	0f b6 00             	movzbl (%eax),%eax
+  801557:	3c 20                	cmp    $0x20,%al
+  801559:	74 f2                	je     80154d <strtol+0x16>
+  80155b:	8b 45 08             	mov    0x8(%ebp),%eax
+  80155e:	0f b6 00             	movzbl (%eax),%eax
+  801561:	3c 09                	cmp    $0x9,%al
+  801563:	74 e8                	je     80154d <strtol+0x16>
+    }
+
+    // plus/minus sign
+    if (*s == '+') {
+  801565:	8b 45 08             	mov    0x8(%ebp),%eax
+  801568:	0f b6 00             	movzbl (%eax),%eax
+  80156b:	3c 2b                	cmp    $0x2b,%al
+  80156d:	75 06                	jne    801575 <strtol+0x3e>
+        s ++;
+  80156f:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801573:	eb 15                	jmp    80158a <strtol+0x53>
+    }
+    else if (*s == '-') {
+  801575:	8b 45 08             	mov    0x8(%ebp),%eax
+  801578:	0f b6 00             	movzbl (%eax),%eax
+  80157b:	3c 2d                	cmp    $0x2d,%al
+  80157d:	75 0b                	jne    80158a <strtol+0x53>
+        s ++, neg = 1;
+  80157f:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  801583:	c7 45 fc 01 00 00 00 	movl   $0x1,-0x4(%ebp)
+    }
+
+    // hex or octal base prefix
+    if ((base == 0 || base == 16) && (s[0] == '0' && s[1] == 'x')) {
+  80158a:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  80158e:	74 06                	je     801596 <strtol+0x5f>
+  801590:	83 7d 10 10          	cmpl   $0x10,0x10(%ebp)
+  801594:	75 24                	jne    8015ba <strtol+0x83>
+  801596:	8b 45 08             	mov    0x8(%ebp),%eax
+  801599:	0f b6 00             	movzbl (%eax),%eax
+  80159c:	3c 30                	cmp    $0x30,%al
+  80159e:	75 1a                	jne    8015ba <strtol+0x83>
+  8015a0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015a3:	83 c0 01             	add    $0x1,%eax
+  8015a6:	0f b6 00             	movzbl (%eax),%eax
+  8015a9:	3c 78                	cmp    $0x78,%al
+  8015ab:	75 0d                	jne    8015ba <strtol+0x83>
+        s += 2, base = 16;
+  8015ad:	83 45 08 02          	addl   $0x2,0x8(%ebp)
+  8015b1:	c7 45 10 10 00 00 00 	movl   $0x10,0x10(%ebp)
+  8015b8:	eb 2a                	jmp    8015e4 <strtol+0xad>
+    }
+    else if (base == 0 && s[0] == '0') {
+  8015ba:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  8015be:	75 17                	jne    8015d7 <strtol+0xa0>
+  8015c0:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015c3:	0f b6 00             	movzbl (%eax),%eax
+  8015c6:	3c 30                	cmp    $0x30,%al
+  8015c8:	75 0d                	jne    8015d7 <strtol+0xa0>
+        s ++, base = 8;
+  8015ca:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  8015ce:	c7 45 10 08 00 00 00 	movl   $0x8,0x10(%ebp)
+  8015d5:	eb 0d                	jmp    8015e4 <strtol+0xad>
+    }
+    else if (base == 0) {
+  8015d7:	83 7d 10 00          	cmpl   $0x0,0x10(%ebp)
+  8015db:	75 07                	jne    8015e4 <strtol+0xad>
+        base = 10;
+  8015dd:	c7 45 10 0a 00 00 00 	movl   $0xa,0x10(%ebp)
+
+    // digits
+    while (1) {
+        int dig;
+
+        if (*s >= '0' && *s <= '9') {
+  8015e4:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015e7:	0f b6 00             	movzbl (%eax),%eax
+  8015ea:	3c 2f                	cmp    $0x2f,%al
+  8015ec:	7e 1b                	jle    801609 <strtol+0xd2>
+  8015ee:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015f1:	0f b6 00             	movzbl (%eax),%eax
+  8015f4:	3c 39                	cmp    $0x39,%al
+  8015f6:	7f 11                	jg     801609 <strtol+0xd2>
+            dig = *s - '0';
+  8015f8:	8b 45 08             	mov    0x8(%ebp),%eax
+  8015fb:	0f b6 00             	movzbl (%eax),%eax
+  8015fe:	0f be c0             	movsbl %al,%eax
+  801601:	83 e8 30             	sub    $0x30,%eax
+  801604:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801607:	eb 48                	jmp    801651 <strtol+0x11a>
+        }
+        else if (*s >= 'a' && *s <= 'z') {
+  801609:	8b 45 08             	mov    0x8(%ebp),%eax
+  80160c:	0f b6 00             	movzbl (%eax),%eax
+  80160f:	3c 60                	cmp    $0x60,%al
+  801611:	7e 1b                	jle    80162e <strtol+0xf7>
+  801613:	8b 45 08             	mov    0x8(%ebp),%eax
+  801616:	0f b6 00             	movzbl (%eax),%eax
+  801619:	3c 7a                	cmp    $0x7a,%al
+  80161b:	7f 11                	jg     80162e <strtol+0xf7>
+            dig = *s - 'a' + 10;
+  80161d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801620:	0f b6 00             	movzbl (%eax),%eax
+  801623:	0f be c0             	movsbl %al,%eax
+  801626:	83 e8 57             	sub    $0x57,%eax
+  801629:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  80162c:	eb 23                	jmp    801651 <strtol+0x11a>
+        }
+        else if (*s >= 'A' && *s <= 'Z') {
+  80162e:	8b 45 08             	mov    0x8(%ebp),%eax
+  801631:	0f b6 00             	movzbl (%eax),%eax
+  801634:	3c 40                	cmp    $0x40,%al
+  801636:	7e 3c                	jle    801674 <strtol+0x13d>
+  801638:	8b 45 08             	mov    0x8(%ebp),%eax
+  80163b:	0f b6 00             	movzbl (%eax),%eax
+  80163e:	3c 5a                	cmp    $0x5a,%al
+  801640:	7f 32                	jg     801674 <strtol+0x13d>
+            dig = *s - 'A' + 10;
+  801642:	8b 45 08             	mov    0x8(%ebp),%eax
+  801645:	0f b6 00             	movzbl (%eax),%eax
+  801648:	0f be c0             	movsbl %al,%eax
+  80164b:	83 e8 37             	sub    $0x37,%eax
+  80164e:	89 45 f4             	mov    %eax,-0xc(%ebp)
+        }
+        else {
+            break;
+        }
+        if (dig >= base) {
+  801651:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801654:	3b 45 10             	cmp    0x10(%ebp),%eax
+  801657:	7d 1a                	jge    801673 <strtol+0x13c>
+            break;
+        }
+        s ++, val = (val * base) + dig;
+  801659:	83 45 08 01          	addl   $0x1,0x8(%ebp)
+  80165d:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  801660:	0f af 45 10          	imul   0x10(%ebp),%eax
+  801664:	89 c2                	mov    %eax,%edx
+  801666:	8b 45 f4             	mov    -0xc(%ebp),%eax
+  801669:	01 d0                	add    %edx,%eax
+  80166b:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (1) {
+  80166e:	e9 71 ff ff ff       	jmp    8015e4 <strtol+0xad>
+            break;
+  801673:	90                   	nop
+        // we don't properly detect overflow!
+    }
+
+    if (endptr) {
+  801674:	83 7d 0c 00          	cmpl   $0x0,0xc(%ebp)
+  801678:	74 08                	je     801682 <strtol+0x14b>
+        *endptr = (char *) s;
+  80167a:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80167d:	8b 55 08             	mov    0x8(%ebp),%edx
+  801680:	89 10                	mov    %edx,(%eax)
+    }
+    return (neg ? -val : val);
+  801682:	83 7d fc 00          	cmpl   $0x0,-0x4(%ebp)
+  801686:	74 07                	je     80168f <strtol+0x158>
+  801688:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  80168b:	f7 d8                	neg    %eax
+  80168d:	eb 03                	jmp    801692 <strtol+0x15b>
+  80168f:	8b 45 f8             	mov    -0x8(%ebp),%eax
+}
+  801692:	c9                   	leave
+  801693:	c3                   	ret
+
+00801694 <memset>:
+ * @n:      number of bytes to be set to the value
+ *
+ * The memset() function returns @s.
+ * */
+void *
+memset(void *s, char c, size_t n) {
+  801694:	55                   	push   %ebp
+  801695:	89 e5                	mov    %esp,%ebp
+  801697:	57                   	push   %edi
+  801698:	83 ec 24             	sub    $0x24,%esp
+  80169b:	8b 45 0c             	mov    0xc(%ebp),%eax
+  80169e:	88 45 d8             	mov    %al,-0x28(%ebp)
+#ifdef __HAVE_ARCH_MEMSET
+    return __memset(s, c, n);
+  8016a1:	0f be 45 d8          	movsbl -0x28(%ebp),%eax
+  8016a5:	8b 55 08             	mov    0x8(%ebp),%edx
+  8016a8:	89 55 f8             	mov    %edx,-0x8(%ebp)
+  8016ab:	88 45 f7             	mov    %al,-0x9(%ebp)
+  8016ae:	8b 45 10             	mov    0x10(%ebp),%eax
+  8016b1:	89 45 f0             	mov    %eax,-0x10(%ebp)
+#ifndef __HAVE_ARCH_MEMSET
+#define __HAVE_ARCH_MEMSET
+static inline void *
+__memset(void *s, char c, size_t n) {
+    int d0, d1;
+    asm volatile (
+  8016b4:	8b 4d f0             	mov    -0x10(%ebp),%ecx
+  8016b7:	0f b6 45 f7          	movzbl -0x9(%ebp),%eax
+  8016bb:	8b 55 f8             	mov    -0x8(%ebp),%edx
+  8016be:	89 d7                	mov    %edx,%edi
+  8016c0:	f3 aa                	rep stos %al,%es:(%edi)
+  8016c2:	89 fa                	mov    %edi,%edx
+  8016c4:	89 4d ec             	mov    %ecx,-0x14(%ebp)
+  8016c7:	89 55 e8             	mov    %edx,-0x18(%ebp)
+        "rep; stosb;"
+        : "=&c" (d0), "=&D" (d1)
+        : "0" (n), "a" (c), "1" (s)
+        : "memory");
+    return s;
+  8016ca:	8b 45 f8             	mov    -0x8(%ebp),%eax
+    while (n -- > 0) {
+        *p ++ = c;
+    }
+    return s;
+#endif /* __HAVE_ARCH_MEMSET */
+}
+  8016cd:	8b 7d fc             	mov    -0x4(%ebp),%edi
+  8016d0:	c9                   	leave
+  8016d1:	c3                   	ret
+
+008016d2 <memmove>:
+ * @n:      number of bytes to copy
+ *
+ * The memmove() function returns @dst.
+ * */
+void *
+memmove(void *dst, const void *src, size_t n) {
+  8016d2:	55                   	push   %ebp
+  8016d3:	89 e5                	mov    %esp,%ebp
+  8016d5:	57                   	push   %edi
+  8016d6:	56                   	push   %esi
+  8016d7:	53                   	push   %ebx
+  8016d8:	83 ec 30             	sub    $0x30,%esp
+  8016db:	8b 45 08             	mov    0x8(%ebp),%eax
+  8016de:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  8016e1:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8016e4:	89 45 ec             	mov    %eax,-0x14(%ebp)
+  8016e7:	8b 45 10             	mov    0x10(%ebp),%eax
+  8016ea:	89 45 e8             	mov    %eax,-0x18(%ebp)
+
+#ifndef __HAVE_ARCH_MEMMOVE
+#define __HAVE_ARCH_MEMMOVE
+static inline void *
+__memmove(void *dst, const void *src, size_t n) {
+    if (dst < src) {
+  8016ed:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8016f0:	3b 45 ec             	cmp    -0x14(%ebp),%eax
+  8016f3:	73 42                	jae    801737 <memmove+0x65>
+  8016f5:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  8016f8:	89 45 e4             	mov    %eax,-0x1c(%ebp)
+  8016fb:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  8016fe:	89 45 e0             	mov    %eax,-0x20(%ebp)
+  801701:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801704:	89 45 dc             	mov    %eax,-0x24(%ebp)
+        "andl $3, %%ecx;"
+        "jz 1f;"
+        "rep; movsb;"
+        "1:"
+        : "=&c" (d0), "=&D" (d1), "=&S" (d2)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  801707:	8b 45 dc             	mov    -0x24(%ebp),%eax
+  80170a:	c1 e8 02             	shr    $0x2,%eax
+  80170d:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  80170f:	8b 55 e4             	mov    -0x1c(%ebp),%edx
+  801712:	8b 45 e0             	mov    -0x20(%ebp),%eax
+  801715:	89 d7                	mov    %edx,%edi
+  801717:	89 c6                	mov    %eax,%esi
+  801719:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  80171b:	8b 4d dc             	mov    -0x24(%ebp),%ecx
+  80171e:	83 e1 03             	and    $0x3,%ecx
+  801721:	74 02                	je     801725 <memmove+0x53>
+  801723:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  801725:	89 f0                	mov    %esi,%eax
+  801727:	89 fa                	mov    %edi,%edx
+  801729:	89 4d d8             	mov    %ecx,-0x28(%ebp)
+  80172c:	89 55 d4             	mov    %edx,-0x2c(%ebp)
+  80172f:	89 45 d0             	mov    %eax,-0x30(%ebp)
+        : "memory");
+    return dst;
+  801732:	8b 45 e4             	mov    -0x1c(%ebp),%eax
+        return __memcpy(dst, src, n);
+  801735:	eb 36                	jmp    80176d <memmove+0x9b>
+        : "0" (n), "1" (n - 1 + src), "2" (n - 1 + dst)
+  801737:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  80173a:	8d 50 ff             	lea    -0x1(%eax),%edx
+  80173d:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801740:	01 c2                	add    %eax,%edx
+  801742:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801745:	8d 48 ff             	lea    -0x1(%eax),%ecx
+  801748:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80174b:	8d 1c 01             	lea    (%ecx,%eax,1),%ebx
+    asm volatile (
+  80174e:	8b 45 e8             	mov    -0x18(%ebp),%eax
+  801751:	89 c1                	mov    %eax,%ecx
+  801753:	89 d8                	mov    %ebx,%eax
+  801755:	89 d6                	mov    %edx,%esi
+  801757:	89 c7                	mov    %eax,%edi
+  801759:	fd                   	std
+  80175a:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  80175c:	fc                   	cld
+  80175d:	89 f8                	mov    %edi,%eax
+  80175f:	89 f2                	mov    %esi,%edx
+  801761:	89 4d cc             	mov    %ecx,-0x34(%ebp)
+  801764:	89 55 c8             	mov    %edx,-0x38(%ebp)
+  801767:	89 45 c4             	mov    %eax,-0x3c(%ebp)
+    return dst;
+  80176a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+            *d ++ = *s ++;
+        }
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMMOVE */
+}
+  80176d:	83 c4 30             	add    $0x30,%esp
+  801770:	5b                   	pop    %ebx
+  801771:	5e                   	pop    %esi
+  801772:	5f                   	pop    %edi
+  801773:	5d                   	pop    %ebp
+  801774:	c3                   	ret
+
+00801775 <memcpy>:
+ * it always copies exactly @n bytes. To avoid overflows, the size of arrays pointed
+ * by both @src and @dst, should be at least @n bytes, and should not overlap
+ * (for overlapping memory area, memmove is a safer approach).
+ * */
+void *
+memcpy(void *dst, const void *src, size_t n) {
+  801775:	55                   	push   %ebp
+  801776:	89 e5                	mov    %esp,%ebp
+  801778:	57                   	push   %edi
+  801779:	56                   	push   %esi
+  80177a:	83 ec 20             	sub    $0x20,%esp
+  80177d:	8b 45 08             	mov    0x8(%ebp),%eax
+  801780:	89 45 f4             	mov    %eax,-0xc(%ebp)
+  801783:	8b 45 0c             	mov    0xc(%ebp),%eax
+  801786:	89 45 f0             	mov    %eax,-0x10(%ebp)
+  801789:	8b 45 10             	mov    0x10(%ebp),%eax
+  80178c:	89 45 ec             	mov    %eax,-0x14(%ebp)
+        : "0" (n / 4), "g" (n), "1" (dst), "2" (src)
+  80178f:	8b 45 ec             	mov    -0x14(%ebp),%eax
+  801792:	c1 e8 02             	shr    $0x2,%eax
+  801795:	89 c1                	mov    %eax,%ecx
+    asm volatile (
+  801797:	8b 55 f4             	mov    -0xc(%ebp),%edx
+  80179a:	8b 45 f0             	mov    -0x10(%ebp),%eax
+  80179d:	89 d7                	mov    %edx,%edi
+  80179f:	89 c6                	mov    %eax,%esi
+  8017a1:	f3 a5                	rep movsl %ds:(%esi),%es:(%edi)
+  8017a3:	8b 4d ec             	mov    -0x14(%ebp),%ecx
+  8017a6:	83 e1 03             	and    $0x3,%ecx
+  8017a9:	74 02                	je     8017ad <memcpy+0x38>
+  8017ab:	f3 a4                	rep movsb %ds:(%esi),%es:(%edi)
+  8017ad:	89 f0                	mov    %esi,%eax
+  8017af:	89 fa                	mov    %edi,%edx
+  8017b1:	89 4d e8             	mov    %ecx,-0x18(%ebp)
+  8017b4:	89 55 e4             	mov    %edx,-0x1c(%ebp)
+  8017b7:	89 45 e0             	mov    %eax,-0x20(%ebp)
+    return dst;
+  8017ba:	8b 45 f4             	mov    -0xc(%ebp),%eax
+    while (n -- > 0) {
+        *d ++ = *s ++;
+    }
+    return dst;
+#endif /* __HAVE_ARCH_MEMCPY */
+}
+  8017bd:	83 c4 20             	add    $0x20,%esp
+  8017c0:	5e                   	pop    %esi
+  8017c1:	5f                   	pop    %edi
+  8017c2:	5d                   	pop    %ebp
+  8017c3:	c3                   	ret
+
+008017c4 <memcmp>:
+ *   match in both memory blocks has a greater value in @v1 than in @v2
+ *   as if evaluated as unsigned char values;
+ * - And a value less than zero indicates the opposite.
+ * */
+int
+memcmp(const void *v1, const void *v2, size_t n) {
+  8017c4:	55                   	push   %ebp
+  8017c5:	89 e5                	mov    %esp,%ebp
+  8017c7:	83 ec 10             	sub    $0x10,%esp
+    const char *s1 = (const char *)v1;
+  8017ca:	8b 45 08             	mov    0x8(%ebp),%eax
+  8017cd:	89 45 fc             	mov    %eax,-0x4(%ebp)
+    const char *s2 = (const char *)v2;
+  8017d0:	8b 45 0c             	mov    0xc(%ebp),%eax
+  8017d3:	89 45 f8             	mov    %eax,-0x8(%ebp)
+    while (n -- > 0) {
+  8017d6:	eb 2e                	jmp    801806 <memcmp+0x42>
+        if (*s1 != *s2) {
+  8017d8:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8017db:	0f b6 10             	movzbl (%eax),%edx
+  8017de:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8017e1:	0f b6 00             	movzbl (%eax),%eax
+  8017e4:	38 c2                	cmp    %al,%dl
+  8017e6:	74 16                	je     8017fe <memcmp+0x3a>
+            return (int)((unsigned char)*s1 - (unsigned char)*s2);
+  8017e8:	8b 45 fc             	mov    -0x4(%ebp),%eax
+  8017eb:	0f b6 00             	movzbl (%eax),%eax
+  8017ee:	0f b6 d0             	movzbl %al,%edx
+  8017f1:	8b 45 f8             	mov    -0x8(%ebp),%eax
+  8017f4:	0f b6 00             	movzbl (%eax),%eax
+  8017f7:	0f b6 c0             	movzbl %al,%eax
+  8017fa:	29 c2                	sub    %eax,%edx
+  8017fc:	eb 1a                	jmp    801818 <memcmp+0x54>
+        }
+        s1 ++, s2 ++;
+  8017fe:	83 45 fc 01          	addl   $0x1,-0x4(%ebp)
+  801802:	83 45 f8 01          	addl   $0x1,-0x8(%ebp)
+    while (n -- > 0) {
+  801806:	8b 45 10             	mov    0x10(%ebp),%eax
+  801809:	8d 50 ff             	lea    -0x1(%eax),%edx
+  80180c:	89 55 10             	mov    %edx,0x10(%ebp)
+  80180f:	85 c0                	test   %eax,%eax
+  801811:	75 c5                	jne    8017d8 <memcmp+0x14>
+    }
+    return 0;
+  801813:	ba 00 00 00 00       	mov    $0x0,%edx
+}
+  801818:	89 d0                	mov    %edx,%eax
+  80181a:	c9                   	leave
+  80181b:	c3                   	ret
+
+0080181c <main>:
+#include <ulib.h>
+
+int zero;
+
+int
+main(void) {
+  80181c:	8d 4c 24 04          	lea    0x4(%esp),%ecx
+  801820:	83 e4 f0             	and    $0xfffffff0,%esp
+  801823:	ff 71 fc             	push   -0x4(%ecx)
+  801826:	55                   	push   %ebp
+  801827:	89 e5                	mov    %esp,%ebp
+  801829:	51                   	push   %ecx
+  80182a:	83 ec 04             	sub    $0x4,%esp
+    cprintf("value is %d.\n", 1 / zero);
+  80182d:	a1 2c 21 80 00       	mov    0x80212c,%eax
+  801832:	89 c2                	mov    %eax,%edx
+  801834:	83 c2 01             	add    $0x1,%edx
+  801837:	83 fa 02             	cmp    $0x2,%edx
+  80183a:	0f 96 c2             	setbe  %dl
+  80183d:	b9 00 00 00 00       	mov    $0x0,%ecx
+  801842:	84 d2                	test   %dl,%dl
+  801844:	0f 44 c1             	cmove  %ecx,%eax
+  801847:	83 ec 08             	sub    $0x8,%esp
+  80184a:	50                   	push   %eax
+  80184b:	68 04 1d 80 00       	push   $0x801d04
+  801850:	e8 47 ec ff ff       	call   80049c <cprintf>
+  801855:	83 c4 10             	add    $0x10,%esp
+    panic("FAIL: T.T\n");
+  801858:	83 ec 04             	sub    $0x4,%esp
+  80185b:	68 12 1d 80 00       	push   $0x801d12
+  801860:	6a 09                	push   $0x9
+  801862:	68 1d 1d 80 00       	push   $0x801d1d
+  801867:	e8 46 eb ff ff       	call   8003b2 <__panic>
@@ -0,0 +1,47 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <file.h>
+#include <dir.h>
+#include <uio.h>
+#include <unistd.h>
+
+const char *name = "iovtest.tmp";
+const char *text = "hello, vectored world";
+
+int
+main(void) {
+    int fd, len = strlen(text);
+    char buf[32], c;
+    assert((fd = open(name, O_RDWR | O_CREAT | O_TRUNC)) >= 0);
+
+    // writev gathers the buffers in order, readv scatters them back
+    struct iovec iov[3] = {
+        {(void *)text, 7}, {(void *)text + 7, 9}, {(void *)text + 16, len - 16},
+    };
+    assert(writev(fd, iov, 3) == len);
+    memset(buf, 0, sizeof(buf));
+    iov[0].iov_base = buf, iov[0].iov_len = 5;
+    iov[1].iov_base = buf + 5, iov[1].iov_len = sizeof(buf) - 5;
+    assert(seek(fd, 0, LSEEK_SET) == 0 && readv(fd, iov, 2) == len);
+    assert(strcmp(buf, text) == 0);
+    cprintf("readv/writev ok.\n");
+
+    // pread and pwrite leave the file position alone
+    assert(seek(fd, 3, LSEEK_SET) == 0);
+    memset(buf, 0, sizeof(buf));
+    assert(pread(fd, buf, 8, 7) == 8 && strcmp(buf, "vectored") == 0);
+    assert(read(fd, &c, 1) == 1 && c == text[3]);
+    assert(pwrite(fd, "H", 1, 0) == 1);
+    assert(read(fd, &c, 1) == 1 && c == text[4]);
+    assert(pread(fd, &c, 1, 0) == 1 && c == 'H');
+    cprintf("pread/pwrite ok.\n");
+
+    // stdin and stdout cannot seek, so they have no offset to read or write at
+    assert(pread(0, &c, 1, 0) < 0 && pwrite(1, &c, 1, 0) < 0);
+
+    close(fd);
+    assert(unlink(name) == 0);
+    cprintf("iovtest pass.\n");
+    return 0;
+}
@@ -26,6 +26,26 @@ write(int fd, void *base, size_t len) {
     return sys_write(fd, base, len);
 }
 
+int
+readv(int fd, const struct iovec *iov, int iovcnt) {
+    return sys_readv(fd, iov, iovcnt);
+}
+
+int
+writev(int fd, const struct iovec *iov, int iovcnt) {
+    return sys_writev(fd, iov, iovcnt);
+}
+
+int
+pread(int fd, void *base, size_t len, off_t offset) {
+    return sys_pread(fd, base, len, offset);
+}
+
+int
+pwrite(int fd, void *base, size_t len, off_t offset) {
+    return sys_pwrite(fd, base, len, offset);
+}
+
 int
 seek(int fd, off_t pos, int whence) {
     return sys_seek(fd, pos, whence);
@@ -46,6 +66,11 @@ dup2(int fd1, int fd2) {
     return sys_dup(fd1, fd2);
 }
 
+int
+pipe(int *fd_store) {
+    return sys_pipe(fd_store);
+}
+
 static char
 transmode(struct stat *stat) {
     uint32_t mode = stat->st_mode;
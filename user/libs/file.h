@@ -4,11 +4,16 @@
 #include <defs.h>
 
 struct stat;
+struct iovec;
 
 int open(const char *path, uint32_t open_flags);
 int close(int fd);
 int read(int fd, void *base, size_t len);
 int write(int fd, void *base, size_t len);
+int readv(int fd, const struct iovec *iov, int iovcnt);
+int writev(int fd, const struct iovec *iov, int iovcnt);
+int pread(int fd, void *base, size_t len, off_t offset);
+int pwrite(int fd, void *base, size_t len, off_t offset);
 int seek(int fd, off_t pos, int whence);
 int fstat(int fd, struct stat *stat);
 int fsync(int fd);
@@ -4,6 +4,7 @@
 #include <syscall.h>
 #include <stat.h>
 #include <dirent.h>
+#include <uio.h>
 
 
 #define MAX_ARGS            5
@@ -63,6 +64,21 @@ sys_getpid(void) {
     return syscall(SYS_getpid);
 }
 
+int
+sys_mmap(uintptr_t *addr_store, size_t len, uint32_t mmap_flags, int fd, off_t offset) {
+    return syscall(SYS_mmap, addr_store, len, mmap_flags, fd, offset);
+}
+
+int
+sys_munmap(uintptr_t addr, size_t len) {
+    return syscall(SYS_munmap, addr, len);
+}
+
+int
+sys_msync(uintptr_t addr, size_t len) {
+    return syscall(SYS_msync, addr, len);
+}
+
 int
 sys_putc(int c) {
     return syscall(SYS_putc, c);
@@ -114,6 +130,26 @@ sys_write(int fd, void *base, size_t len) {
     return syscall(SYS_write, fd, base, len);
 }
 
+int
+sys_readv(int fd, const struct iovec *iov, int iovcnt) {
+    return syscall(SYS_readv, fd, iov, iovcnt);
+}
+
+int
+sys_writev(int fd, const struct iovec *iov, int iovcnt) {
+    return syscall(SYS_writev, fd, iov, iovcnt);
+}
+
+int
+sys_pread(int fd, void *base, size_t len, off_t offset) {
+    return syscall(SYS_pread, fd, base, len, offset);
+}
+
+int
+sys_pwrite(int fd, void *base, size_t len, off_t offset) {
+    return syscall(SYS_pwrite, fd, base, len, offset);
+}
+
 int
 sys_seek(int fd, off_t pos, int whence) {
     return syscall(SYS_seek, fd, pos, whence);
@@ -163,3 +199,8 @@ int
 sys_dup(int fd1, int fd2) {
     return syscall(SYS_dup, fd1, fd2);
 }
+
+int
+sys_pipe(int *fd_store) {
+    return syscall(SYS_pipe, fd_store);
+}
@@ -55,6 +55,26 @@ getpid(void) {
     return sys_getpid();
 }
 
+// mmap - map len bytes of the file fd from offset on (fd is NO_FD for zeros), return NULL if it fails
+void *
+mmap(void *addr, size_t len, uint32_t mmap_flags, int fd, off_t offset) {
+    uintptr_t addr_store = (uintptr_t)addr;
+    if (sys_mmap(&addr_store, len, mmap_flags, fd, offset) != 0) {
+        return NULL;
+    }
+    return (void *)addr_store;
+}
+
+int
+munmap(void *addr, size_t len) {
+    return sys_munmap((uintptr_t)addr, len);
+}
+
+int
+msync(void *addr, size_t len) {
+    return sys_msync((uintptr_t)addr, len);
+}
+
 //print_pgdir - print the PDT&PT
 void
 print_pgdir(void) {
@@ -32,6 +32,9 @@ int waitpid(int pid, int *store);
 void yield(void);
 int kill(int pid);
 int getpid(void);
+void *mmap(void *addr, size_t len, uint32_t mmap_flags, int fd, off_t offset);
+int munmap(void *addr, size_t len);
+int msync(void *addr, size_t len);
 void print_pgdir(void);
 int sleep(unsigned int time);
 unsigned int gettime_msec(void);
@@ -0,0 +1,85 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <file.h>
+#include <dir.h>
+#include <unistd.h>
+
+#define PAGE                    4096
+
+const char *name = "mmaptest.tmp";
+char buf[2 * PAGE];
+
+void
+test_file(void) {
+    int fd;
+    char c;
+    assert((fd = open(name, O_RDWR | O_CREAT | O_TRUNC)) >= 0);
+    memset(buf, 'a', sizeof(buf));
+    assert(write(fd, buf, sizeof(buf)) == sizeof(buf));
+
+    // a private mapping sees the file, but its writes stay in memory
+    char *p = mmap(NULL, 2 * PAGE, MMAP_WRITE, fd, 0);
+    assert(p != NULL && p[0] == 'a' && p[PAGE] == 'a');
+    p[0] = 'b';
+    assert(munmap(p, 2 * PAGE) == 0);
+    assert(seek(fd, 0, LSEEK_SET) == 0 && read(fd, &c, 1) == 1 && c == 'a');
+
+    // a shared mapping writes back to the file on msync
+    assert((p = mmap(NULL, 2 * PAGE, MMAP_WRITE | MMAP_SHARED, fd, 0)) != NULL);
+    p[PAGE] = 'c';
+    assert(msync(p, 2 * PAGE) == 0);
+    assert(seek(fd, PAGE, LSEEK_SET) == 0 && read(fd, &c, 1) == 1 && c == 'c');
+    assert(munmap(p, 2 * PAGE) == 0);
+
+    close(fd);
+    assert(unlink(name) == 0);
+    cprintf("file mapping ok.\n");
+}
+
+void
+test_fork(void) {
+    int pid, exit_code;
+    char *shared = mmap(NULL, PAGE, MMAP_WRITE | MMAP_SHARED, NO_FD, 0);
+    char *private = mmap(NULL, PAGE, MMAP_WRITE, NO_FD, 0);
+    assert(shared != NULL && private != NULL && shared[0] == 0 && private[0] == 0);
+    if ((pid = fork()) == 0) {
+        shared[0] = 1, private[0] = 1;
+        exit(0);
+    }
+    assert(pid > 0 && waitpid(pid, &exit_code) == 0 && exit_code == 0);
+    // the child's write shows through the shared zeros only
+    assert(shared[0] == 1 && private[0] == 0);
+    assert(munmap(shared, PAGE) == 0 && munmap(private, PAGE) == 0);
+    cprintf("shared anonymous mapping ok.\n");
+}
+
+void
+test_split(void) {
+    int pid, exit_code;
+    char *p = mmap(NULL, 3 * PAGE, MMAP_WRITE, NO_FD, 0);
+    assert(p != NULL);
+    p[0] = 1, p[PAGE] = 2, p[2 * PAGE] = 3;
+
+    // unmapping the middle page leaves two mappings around the hole
+    assert(munmap(p + PAGE, PAGE) == 0);
+    assert(p[0] == 1 && p[2 * PAGE] == 3);
+    if ((pid = fork()) == 0) {
+        cprintf("touch the hole, should be killed.\n");
+        p[PAGE] = 4;
+        exit(0);
+    }
+    assert(pid > 0 && waitpid(pid, &exit_code) == 0 && exit_code != 0);
+
+    assert(munmap(p, PAGE) == 0 && munmap(p + 2 * PAGE, PAGE) == 0);
+    cprintf("munmap split ok.\n");
+}
+
+int
+main(void) {
+    test_file();
+    test_fork();
+    test_split();
+    cprintf("mmaptest pass.\n");
+    return 0;
+}
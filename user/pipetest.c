@@ -0,0 +1,88 @@
+#include <ulib.h>
+#include <stdio.h>
+#include <string.h>
+#include <file.h>
+#include <error.h>
+#include <unistd.h>
+
+const int nr_write = 8;
+char buf[PIPE_BUF];
+
+// writer - write nr_write blocks of PIPE_BUF bytes of c, more than the pipe holds in all
+void
+writer(int fd, char c) {
+    int i;
+    memset(buf, c, sizeof(buf));
+    for (i = 0; i < nr_write; i ++) {
+        assert(write(fd, buf, sizeof(buf)) == sizeof(buf));
+    }
+    exit(0);
+}
+
+void
+test_atomic(void) {
+    int fd[2], pid1, pid2, ret, i, n = 0, na = 0, nb = 0;
+    assert(pipe(fd) == 0);
+    if ((pid1 = fork()) == 0) {
+        close(fd[0]);
+        writer(fd[1], 'a');
+    }
+    if ((pid2 = fork()) == 0) {
+        close(fd[0]);
+        writer(fd[1], 'b');
+    }
+    assert(pid1 > 0 && pid2 > 0);
+    close(fd[1]);
+
+    // each write of PIPE_BUF bytes comes out whole, never mixed with the other writer's
+    while ((ret = read(fd[0], buf + n, sizeof(buf) - n)) > 0) {
+        if ((n += ret) == sizeof(buf)) {
+            for (i = 1; i < n; i ++) {
+                assert(buf[i] == buf[0]);
+            }
+            if (buf[0] == 'a') {
+                na ++;
+            }
+            else {
+                nb ++;
+            }
+            n = 0;
+        }
+    }
+    // both writers are gone, so the pipe is at its end
+    assert(ret == 0 && n == 0 && na == nr_write && nb == nr_write);
+    assert(waitpid(pid1, NULL) == 0 && waitpid(pid2, NULL) == 0);
+    close(fd[0]);
+    cprintf("atomic write ok.\n");
+}
+
+void
+test_close(void) {
+    int fd[2];
+    char c;
+    assert(pipe(fd) == 0);
+    // a pipe cannot seek, so it has no offset to read at
+    assert(pread(fd[0], &c, 1, 0) == -E_SEEK);
+
+    // the reader gets what is left, then the end of file
+    assert(write(fd[1], "x", 1) == 1);
+    close(fd[1]);
+    assert(read(fd[0], &c, 1) == 1 && c == 'x');
+    assert(read(fd[0], &c, 1) == 0);
+    close(fd[0]);
+
+    // nobody can read what is written any more
+    assert(pipe(fd) == 0);
+    close(fd[0]);
+    assert(write(fd[1], "x", 1) == -E_PIPE);
+    close(fd[1]);
+    cprintf("close ok.\n");
+}
+
+int
+main(void) {
+    test_atomic();
+    test_close();
+    cprintf("pipetest pass.\n");
+    return 0;
+}